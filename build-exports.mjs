@@ -19,6 +19,7 @@ const cppToTsTypeMap = {
   'float': 'number',
   'double': 'number',
   'Real': 'number',
+  'TensorHandle': 'number',
   'bool': 'boolean',
   'char': 'string',
   'std::string': 'string',
@@ -99,6 +99,56 @@ export default [
       })
     ],
   },
+  // Worker entries for WorkerPool, loaded next to the main bundles
+  {
+    input: 'src/ts/worker.ts',
+    output: {
+      file: 'dist/worker.esm.js',
+      format: 'esm',
+      inlineDynamicImports: true,
+      sourcemap: false,
+    },
+    plugins: [
+      resolve({
+        browser: true,
+      }),
+      typescript({
+        paths: {
+          "@loader": ["src/ts/loaders/browser.ts"]
+        }
+      }),
+      terser({
+        keep_classnames: true,
+        format: {
+          preamble: PREAMBLE,
+        }
+      })
+    ],
+  },
+  {
+    input: 'src/ts/worker.ts',
+    output: {
+      file: 'dist/worker.node.esm.js',
+      format: 'esm',
+      inlineDynamicImports: true,
+      sourcemap: false,
+    },
+    plugins: [
+      resolve(),
+      typescript({
+        paths: {
+          "@loader": ["src/ts/loaders/node.ts"]
+        }
+      }),
+      terser({
+        keep_classnames: true,
+        keep_fnames: true,
+        format: {
+          preamble: PREAMBLE,
+        }
+      })
+    ],
+  },
   // Configuration for bundling .d.ts files
   {
     input: 'dist/index.d.ts',
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include "./Tensor.h"
+
+// Distributions of creation::random, matches RANDOM_DIST in src/ts/Tensor.ts
+enum RANDOM_DIST {
+  RANDOM_UNIFORM,           // [a, b)
+  RANDOM_NORMAL,            // mean a, stddev b
+  RANDOM_TRUNCATED_NORMAL   // mean a, stddev b, redrawn beyond 2 stddev
+};
+
+// Philox4x32-10 counter based generator (Salmon et al., "Parallel random
+// numbers: as easy as 1, 2, 3"). A block of 4 words is a pure function of
+// the key and its counter, so every element can be generated on its own:
+// results don't depend on how the work is split, and jumping ahead is
+// moving `counter`.
+struct Philox {
+  uint32_t key[2];
+  uint64_t counter;  // next unused block
+
+  // Words of block `index`, `word` selects an independent substream
+  void block(uint64_t index, uint32_t word, uint32_t out[4]) const {
+    uint32_t c0 = static_cast<uint32_t>(index);
+    uint32_t c1 = static_cast<uint32_t>(index >> 32);
+    uint32_t c2 = word;
+    uint32_t c3 = 0;
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+    for (int round = 0; round < 10; ++round) {
+      uint64_t p0 = uint64_t(0xD2511F53) * c0;
+      uint64_t p1 = uint64_t(0xCD9E8D57) * c2;
+      uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+      uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+      c1 = static_cast<uint32_t>(p1);
+      c3 = static_cast<uint32_t>(p0);
+      c0 = n0;
+      c2 = n2;
+      k0 += 0x9E3779B9;
+      k1 += 0xBB67AE85;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+  }
+};
+
+namespace creation {
+  Tensor full(size_t rows, size_t cols, bool is1d, Real value);
+  // 1d values from `start` by `step` up to, not including, `stop`
+  Tensor arange(double start, double stop, double step);
+  // 1d `num` evenly spaced values from `start` to `stop` inclusive
+  Tensor linspace(Real start, Real stop, size_t num);
+  // Samples of `dist` drawn from `stream`, which moves past the blocks used
+  Tensor random(size_t rows, size_t cols, bool is1d, RANDOM_DIST dist, Real a, Real b, Philox& stream);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <complex>
+#include <memory>
+#include "./Tensor.h"
+
+namespace fft {
+  using Complex = std::complex<Real>;
+
+  // Radices above this use Bluestein's algorithm, the generic butterfly
+  // costs O(radix) per point
+  constexpr size_t GENERIC_RADIX_MAX = 32;
+  // Plans kept by the cache before it starts over, plans still in use
+  // stay alive through their shared_ptr
+  constexpr size_t PLAN_CACHE_MAX = 64;
+
+  // Plain product, operator* checks for NaN/inf operands which is far slower
+  inline Complex multiply(const Complex& a, const Complex& b) {
+    return Complex(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+  }
+
+  size_t next_pow2(size_t n);
+
+  // Precomputed twiddles and factorization for one transform size, built
+  // once and reused through plan(). Sizes factor into radix 4, 2 and small
+  // odd radices, sizes with a large prime factor go through Bluestein.
+  class Plan {
+    public:
+      explicit Plan(size_t n);
+      ~Plan();
+
+      size_t size() const { return n; }
+      // Complex transform of size() points, `in` and `out` may alias,
+      // the inverse is scaled by 1/n
+      void transform(const Complex* in, Complex* out, bool inverse) const;
+      // size() real samples to the size() / 2 + 1 non-negative frequency bins
+      void forward_real(const Real* in, Complex* out) const;
+      // size() / 2 + 1 bins back to size() real samples, scaled by 1/n
+      void inverse_real(const Complex* in, Real* out) const;
+
+    private:
+      Complex twiddle(size_t index, bool inverse) const;
+      void work(Complex* out, const Complex* in, size_t stride, const size_t* radices, bool inverse) const;
+      void butterfly(Complex* out, size_t stride, size_t m, size_t radix, bool inverse) const;
+      void bluestein(const Complex* in, Complex* out, bool inverse) const;
+      size_t state_bytes() const;
+
+      size_t n;
+      std::vector<size_t> radices;           // (radix, remaining length) pairs
+      std::vector<Complex> table;            // exp(-2 pi i k / n), k < n
+      std::shared_ptr<const Plan> half;      // size n / 2, real transforms of even sizes
+      std::shared_ptr<const Plan> padded;    // power of two Bluestein convolution size
+      std::vector<Complex> chirp;            // exp(-pi i k^2 / n)
+      std::vector<Complex> chirp_spectrum;   // transform of the conjugate chirp
+  };
+
+  // Cached plan for `n` points
+  std::shared_ptr<const Plan> plan(size_t n);
+  void clear_plans();
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "./Tensor.h"
+
+// Polynomial approximations used by MATH_FAST. They are inline and branch
+// free (selects only) so elementwise loops inline and vectorize, unlike libm
+// calls. Worst errors, measured against double precision libm over float inputs:
+//   exp, log                  1 ulp
+//   tanh                      1.5 ulp
+//   sigmoid                   2.5 ulp
+//   atan                      3 ulp
+//   atan2                     3.5 ulp
+//   sin, cos                  8e-8 absolute for |x| <= 8192, grows beyond
+// 64 bit builds (USE_DOUBLE) keep libm for both modes.
+namespace fastmath {
+  // Resolve a per call mode, -1 uses the global mode
+  MATH_MODE resolve(int mode);
+  MATH_MODE get_mode();
+  void set_mode(MATH_MODE mode);
+
+#ifndef USE_DOUBLE
+  inline int32_t bits(float x) {
+    int32_t i;
+    std::memcpy(&i, &x, sizeof(i));
+    return i;
+  }
+
+  inline float from_bits(int32_t i) {
+    float x;
+    std::memcpy(&x, &i, sizeof(x));
+    return x;
+  }
+
+  inline float exp(float x) {/*{{{*/
+    // e^x = 2^n e^r, |r| <= ln2 / 2
+    // 88.7228317 is the largest float whose e^x is finite, below -87.3365402
+    // results are subnormal and flush to 0
+    float clamped = std::min(std::max(x, -87.3365402f), 88.7228317f);
+    float n = std::nearbyint(clamped * 1.44269504088896341f);
+    float r = clamped - n * 0.693359375f + n * 2.12194440e-4f;
+    float p = 1.9875691500e-4f;
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    float y = p * r * r + r + 1.0f;
+    // n reaches 128 near the top of the range, 2^128 isn't a float, so
+    // scale in two halves
+    int32_t low = static_cast<int32_t>(n) >> 1;
+    y *= from_bits((low + 127) << 23);
+    y *= from_bits((static_cast<int32_t>(n) - low + 127) << 23);
+    y = x > 88.7228317f ? std::numeric_limits<float>::infinity() : y;
+    y = x < -87.3365402f ? 0.0f : y;
+    return x != x ? x : y;
+  }/*}}}*/
+
+  inline float log(float x) {/*{{{*/
+    // x = m 2^e with m in [sqrt(1/2), sqrt(2)), log(x) = log(m) + e ln2
+    // subnormals are scaled into the normal range first
+    bool subnormal = x < std::numeric_limits<float>::min();
+    int32_t i = bits(x * (subnormal ? 8388608.0f : 1.0f));
+    int32_t exponent = ((i >> 23) & 0xff) - (subnormal ? 150 : 127);
+    float m = from_bits((i & 0x7fffff) | 0x3f800000);
+    bool high = m > 1.41421356f;
+    float e = static_cast<float>(exponent + high);
+    float f = m * (high ? 0.5f : 1.0f) - 1.0f;
+    float z = f * f;
+    float p = 7.0376836292e-2f;
+    p = p * f - 1.1514610310e-1f;
+    p = p * f + 1.1676998740e-1f;
+    p = p * f - 1.2420140846e-1f;
+    p = p * f + 1.4249322787e-1f;
+    p = p * f - 1.6668057665e-1f;
+    p = p * f + 2.0000714765e-1f;
+    p = p * f - 2.4999993993e-1f;
+    p = p * f + 3.3333331174e-1f;
+    float y = f * z * p - 2.12194440e-4f * e - 0.5f * z;
+    y = f + y + 0.693359375f * e;
+    y = x == std::numeric_limits<float>::infinity() ? x : y;
+    y = x == 0.0f ? -std::numeric_limits<float>::infinity() : y;
+    return (x < 0.0f) | (x != x) ? std::numeric_limits<float>::quiet_NaN() : y;
+  }/*}}}*/
+
+  // sin of `x` shifted by `quadrant` quarter turns, cos is quadrant 1
+  inline float sin_quadrant(float x, int32_t quadrant) {/*{{{*/
+    float j = std::nearbyint(x * 0.636619772367581343f);
+    // pi / 2 in three parts, so r stays exact for moderate j
+    float r = x - j * 1.5703125f - j * 4.837512969970703125e-4f - j * 7.54978995489188216e-8f;
+    int32_t q = static_cast<int32_t>(j) + quadrant;
+    float z = r * r;
+    float s = -1.9515295891e-4f;
+    s = s * z + 8.3321608736e-3f;
+    s = s * z - 1.6666654611e-1f;
+    s = s * z * r + r;
+    float c = 2.443315711809948e-5f;
+    c = c * z - 1.388731625493765e-3f;
+    c = c * z + 4.166664568298827e-2f;
+    c = c * z * z - 0.5f * z + 1.0f;
+    float y = q & 1 ? c : s;
+    return q & 2 ? -y : y;
+  }/*}}}*/
+
+  inline float sin(float x) {
+    return sin_quadrant(x, 0);
+  }
+
+  inline float cos(float x) {
+    return sin_quadrant(x, 1);
+  }
+
+  // atan on [0, 1]
+  inline float atan_unit(float x) {/*{{{*/
+    bool reduce = x > 0.414213562373095f;
+    float t = reduce ? (x - 1.0f) / (x + 1.0f) : x;
+    float z = t * t;
+    float p = 8.05374449538e-2f;
+    p = p * z - 1.38776856032e-1f;
+    p = p * z + 1.99777106478e-1f;
+    p = p * z - 3.33329491539e-1f;
+    float y = p * z * t + t;
+    return reduce ? y + 0.785398163397448310f : y;
+  }/*}}}*/
+
+  inline float atan(float x) {
+    float a = std::abs(x);
+    bool invert = a > 1.0f;
+    float y = atan_unit(invert ? 1.0f / a : a);
+    y = invert ? 1.57079632679489662f - y : y;
+    return std::copysign(y, x);
+  }
+
+  inline float atan2(float y, float x) {/*{{{*/
+    float ax = std::abs(x);
+    float ay = std::abs(y);
+    float large = std::max(ax, ay);
+    float t = large == 0.0f ? 0.0f : std::min(ax, ay) / large;
+    float a = atan_unit(t);
+    a = ay > ax ? 1.57079632679489662f - a : a;
+    a = std::signbit(x) ? 3.14159265358979324f - a : a;
+    a = std::copysign(a, y);
+    return (x != x) | (y != y) ? x + y : a;
+  }/*}}}*/
+
+  inline float tanh(float x) {
+    float a = std::abs(x);
+    float z = x * x;
+    // small |x| polynomial avoids the cancellation in 1 - 2 / (e^2x + 1)
+    float p = -5.70498872745e-3f;
+    p = p * z + 2.06390887954e-2f;
+    p = p * z - 5.37397155531e-2f;
+    p = p * z + 1.33314422036e-1f;
+    p = p * z - 3.33332819422e-1f;
+    float small = p * z * x + x;
+    float large = std::copysign(1.0f - 2.0f / (exp(2.0f * a) + 1.0f), x);
+    return a < 0.625f ? small : large;
+  }
+
+  inline float sigmoid(float x) {
+    return 1.0f / (1.0f + exp(-x));
+  }
+#else
+  inline double exp(double x) { return std::exp(x); }
+  inline double log(double x) { return std::log(x); }
+  inline double sin(double x) { return std::sin(x); }
+  inline double cos(double x) { return std::cos(x); }
+  inline double atan(double x) { return std::atan(x); }
+  inline double atan2(double y, double x) { return std::atan2(y, x); }
+  inline double tanh(double x) { return std::tanh(x); }
+  inline double sigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+#endif
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "./FFT.h"
+#include "./Tensor.h"
+
+namespace filter {
+  // Kernels at least this long switch from the direct loop to FFT overlap-add
+  constexpr size_t FFT_KERNEL_MIN = 64;
+
+  // Transform of a kernel zero padded to its overlap-add FFT size, empty for
+  // kernels short enough for the direct loop. Built once per kernel and
+  // handed to correlate() for every lane and frame.
+  std::vector<fft::Complex> kernel_spectrum(const Real* kernel, size_t size);
+
+  // out[i] = sum_j kernel[j] * signal[i + j] for the `length - size + 1`
+  // positions where the kernel fits inside the signal, `spectrum` is
+  // kernel_spectrum(kernel, size)
+  void correlate(const Real* signal, size_t length, const Real* kernel, size_t size,
+      const std::vector<fft::Complex>& spectrum, Real* out);
+
+  Tensor moving_average_kernel(size_t window);
+  // Least squares polynomial fit over `window` (odd) samples, ready to convolve
+  Tensor savgol_kernel(size_t window, size_t order, size_t deriv);
+}
+
+// Causal FIR filter over a stream of frames, each frame holds `samples` rows of
+// `channels` values. The last kernel-1 samples of every channel are kept, so
+// consecutive frames filter as if they were one signal.
+class FIRFilter {
+  public:
+    FIRFilter(const Real* kernel, size_t size, size_t channels);
+    ~FIRFilter();
+
+    void reset();
+    // Filter `samples` x `channels` values in place
+    void process(Real* frame, size_t samples);
+
+  private:
+    size_t state_bytes() const;
+
+    size_t channels;
+    std::vector<Real> reversed;  // kernel, reversed for correlate()
+    std::vector<fft::Complex> spectrum;  // of `reversed`, long kernels only
+    std::vector<Real> history;   // channels x (size - 1), oldest first
+    std::vector<Real> scratch;
+    std::vector<Real> filtered;
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "./Tensor.h"
+
+// Stack allocated, compile-time sized vectors and row-major matrices for
+// 2D/3D transforms. Every loop has a constant trip count, so the compiler
+// unrolls them fully and keeps the values in registers.
+namespace fixed {
+  // 4-wide types are aligned to a full SIMD register
+  template <size_t N>
+  constexpr size_t alignment() {
+    return N % 4 == 0 ? 4 * sizeof(Real) : alignof(Real);
+  }
+
+  template <size_t N>
+  struct alignas(alignment<N>()) Vec {/*{{{*/
+    Real v[N];
+
+    static Vec load(const Real* src) {
+      Vec result;
+      for (size_t i = 0; i < N; ++i) {
+        result.v[i] = src[i];
+      }
+      return result;
+    }
+
+    static constexpr Vec zero() {
+      Vec result = {};
+      return result;
+    }
+
+    void store(Real* dst) const {
+      for (size_t i = 0; i < N; ++i) {
+        dst[i] = v[i];
+      }
+    }
+
+    constexpr Real& operator[](size_t i) { return v[i]; }
+    constexpr const Real& operator[](size_t i) const { return v[i]; }
+
+    Vec operator+(const Vec& other) const {
+      Vec result;
+      for (size_t i = 0; i < N; ++i) {
+        result.v[i] = v[i] + other.v[i];
+      }
+      return result;
+    }
+
+    Vec operator-(const Vec& other) const {
+      Vec result;
+      for (size_t i = 0; i < N; ++i) {
+        result.v[i] = v[i] - other.v[i];
+      }
+      return result;
+    }
+
+    Vec operator*(Real scalar) const {
+      Vec result;
+      for (size_t i = 0; i < N; ++i) {
+        result.v[i] = v[i] * scalar;
+      }
+      return result;
+    }
+
+    Real dot(const Vec& other) const {
+      Real sum = 0;
+      for (size_t i = 0; i < N; ++i) {
+        sum += v[i] * other.v[i];
+      }
+      return sum;
+    }
+
+    Real length() const {
+      return std::sqrt(dot(*this));
+    }
+
+    // Unit vector, the zero vector is returned unchanged
+    Vec normalized() const {
+      Real len = length();
+      return len > 0 ? *this * (Real(1) / len) : *this;
+    }
+  };/*}}}*/
+
+  template <size_t R, size_t C>
+  struct alignas(alignment<R * C>()) Mat {/*{{{*/
+    Real m[R * C];
+
+    static Mat load(const Real* src) {
+      Mat result;
+      for (size_t i = 0; i < R * C; ++i) {
+        result.m[i] = src[i];
+      }
+      return result;
+    }
+
+    static constexpr Mat identity() {
+      Mat result = {};
+      for (size_t i = 0; i < (R < C ? R : C); ++i) {
+        result.m[i * C + i] = 1;
+      }
+      return result;
+    }
+
+    void store(Real* dst) const {
+      for (size_t i = 0; i < R * C; ++i) {
+        dst[i] = m[i];
+      }
+    }
+
+    constexpr Real& operator()(size_t row, size_t col) { return m[row * C + col]; }
+    constexpr const Real& operator()(size_t row, size_t col) const { return m[row * C + col]; }
+
+    Mat<C, R> transpose() const {
+      Mat<C, R> result;
+      for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < C; ++j) {
+          result.m[j * R + i] = m[i * C + j];
+        }
+      }
+      return result;
+    }
+
+    template <size_t K>
+    Mat<R, K> operator*(const Mat<C, K>& other) const {
+      Mat<R, K> result = {};
+      for (size_t i = 0; i < R; ++i) {
+        for (size_t k = 0; k < C; ++k) {
+          Real a = m[i * C + k];
+          for (size_t j = 0; j < K; ++j) {
+            result.m[i * K + j] += a * other.m[k * K + j];
+          }
+        }
+      }
+      return result;
+    }
+
+    // Matrix times column vector
+    Vec<R> operator*(const Vec<C>& vec) const {
+      Vec<R> result;
+      for (size_t i = 0; i < R; ++i) {
+        Real sum = 0;
+        for (size_t j = 0; j < C; ++j) {
+          sum += m[i * C + j] * vec.v[j];
+        }
+        result.v[i] = sum;
+      }
+      return result;
+    }
+  };/*}}}*/
+
+  // Row vector times matrix, a row of an (n x R) tensor against an (R x C) one
+  template <size_t R, size_t C>
+  Vec<C> operator*(const Vec<R>& vec, const Mat<R, C>& mat) {
+    Vec<C> result = Vec<C>::zero();
+    for (size_t k = 0; k < R; ++k) {
+      for (size_t j = 0; j < C; ++j) {
+        result.v[j] += vec.v[k] * mat.m[k * C + j];
+      }
+    }
+    return result;
+  }
+
+  inline Vec<3> cross(const Vec<3>& a, const Vec<3>& b) {
+    return {{ a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] }};
+  }
+
+  inline Real determinant(const Mat<2, 2>& a) {
+    return a.m[0] * a.m[3] - a.m[1] * a.m[2];
+  }
+
+  inline Real determinant(const Mat<3, 3>& a) {
+    return a.m[0] * (a.m[4] * a.m[8] - a.m[5] * a.m[7]) \
+      - a.m[1] * (a.m[3] * a.m[8] - a.m[5] * a.m[6]) \
+      + a.m[2] * (a.m[3] * a.m[7] - a.m[4] * a.m[6]);
+  }
+
+  using Vec2 = Vec<2>;
+  using Vec3 = Vec<3>;
+  using Vec4 = Vec<4>;
+  using Mat2 = Mat<2, 2>;
+  using Mat3 = Mat<3, 3>;
+  using Mat4 = Mat<4, 4>;
+}
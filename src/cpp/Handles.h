@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "./Tensor.h"
+
+// Tensors handed to JS live in a slot table and cross the boundary as 32-bit
+// handles, the low bits index the slot and the high bits carry its
+// generation. Freeing a slot bumps the generation, so a stale handle fails to
+// resolve instead of reading a freed (or reused) tensor. Slots are recycled
+// through a FIFO free list, so a generation only wraps around after its slot
+// was reused MAX_GENERATION times behind every other free slot. Slots never
+// move, a resolved Tensor* stays valid until its handle is released.
+namespace handles {
+  constexpr uint32_t INDEX_BITS = 20;
+  constexpr uint32_t INDEX_MASK = (uint32_t(1) << INDEX_BITS) - 1;
+  constexpr uint32_t MAX_GENERATION = (uint32_t(1) << (32 - INDEX_BITS)) - 1;
+
+  // Tensor of a handle, nullptr for the null handle 0, reports stale handles
+  Tensor* resolve(uint32_t handle);
+  // Storage for a new tensor in a free slot, `handle` receives its handle.
+  // The slot is only taken by commit(), once the tensor is constructed.
+  void* reserve(uint32_t& handle);
+  void commit(uint32_t handle);
+  // Destroy the tensor and free its slot, false for a stale handle
+  bool release(uint32_t handle);
+
+  // While a scope is open every new handle is recorded, end_scope() releases
+  // the ones of the innermost scope still live except `keep` and returns how
+  // many it freed. Scopes nest, `keep` moves to the enclosing scope.
+  void begin_scope();
+  size_t end_scope(uint32_t keep);
+}
+
+// Passed and returned by the bindings in place of Tensor*, a single uint32
+// on the wasm side. Dereferencing resolves (and checks) the handle.
+struct TensorHandle {
+  uint32_t id;
+
+  Tensor* get() const { return handles::resolve(id); }
+  Tensor* operator->() const { return get(); }
+  Tensor& operator*() const { return *get(); }
+  operator Tensor*() const { return get(); }
+
+  // Construct a tensor straight into a table slot
+  template <typename... Args>
+  static TensorHandle emplace(Args&&... args) {
+    uint32_t handle;
+    void* storage = handles::reserve(handle);
+    new (storage) Tensor(std::forward<Args>(args)...);
+    handles::commit(handle);
+    return { handle };
+  }
+};
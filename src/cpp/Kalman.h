@@ -2,7 +2,11 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <cmath>
+#include "./Profiler.h"
+#include "./Memory.h"
+#include "./ErrorHelper.h"
 
 #ifdef USE_DOUBLE
 using Real = double;
@@ -22,7 +26,60 @@ class KalmanFilter {
     void update(Real* observation, size_t size, Real q_temp, Real r_temp);
 
   private:
+    size_t state_bytes() const;
+
     bool initialized = false;
     std::vector<Real> state;       // State for each coordinate
     std::vector<Real> covariance; // Covariance for each coordinate
 };
+
+// Banks of independent smoothers over a frame of `size` values, e.g. every
+// keypoint coordinate of every tracked person. State is kept as one array
+// per quantity so each update is a straight loop over the frame, and the
+// observation is overwritten with the smoothed values. Streams start from
+// their first observation, reset() restarts a range of them.
+
+// One Euro filter (Casiez et al., CHI 2012), a low pass whose cutoff rises
+// with the speed of the signal: smooth when still, little lag when moving
+class OneEuroFilter {
+  public:
+    Real min_cutoff;  // Hz, lower is smoother at rest
+    Real beta;        // cutoff gained per unit of speed, higher lags less
+    Real d_cutoff;    // Hz, for the speed estimate
+
+    OneEuroFilter(Real min_cutoff, Real beta, Real d_cutoff);
+    ~OneEuroFilter();
+
+    void reset(size_t start, size_t count);
+    // `dt` is the time since the previous frame in seconds
+    void update(Real* observation, size_t size, Real dt);
+
+  private:
+    size_t state_bytes() const;
+    void resize(size_t size);
+
+    std::vector<Real> value;       // last smoothed value
+    std::vector<Real> derivative;  // last smoothed speed
+    std::vector<Real> primed;      // 1 once a stream has a value, 0 after reset
+};
+
+// Single (beta < 0) or double, Holt's linear trend, exponential smoothing
+class ExponentialSmoothing {
+  public:
+    Real alpha;  // weight of the observation
+    Real beta;   // weight of the trend change, double smoothing only
+
+    ExponentialSmoothing(Real alpha, Real beta);
+    ~ExponentialSmoothing();
+
+    void reset(size_t start, size_t count);
+    void update(Real* observation, size_t size);
+
+  private:
+    size_t state_bytes() const;
+    void resize(size_t size);
+
+    std::vector<Real> level;
+    std::vector<Real> trend;
+    std::vector<Real> primed;
+};
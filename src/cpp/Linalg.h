@@ -0,0 +1,50 @@
+#pragma once
+
+#include "./Tensor.h"
+
+// Rank-1 modifications of triangular factors. `R` is n x n upper triangular,
+// row major, with RᵀR = AᵀA for the rows of A seen so far (the R of a QR, or
+// the transposed Cholesky factor of AᵀA). Adding or removing a row of A
+// costs O(n²) instead of refactoring. Rows of R are `cols` >= n wide, the
+// columns past n are right-hand sides rotated along (e.g. Qᵀy).
+namespace linalg {
+  // Rotation with c * a + s * b = r and -s * a + c * b = 0
+  void givens(Real a, Real b, Real& c, Real& s, Real& r);
+  // RᵀR + x xᵀ by Givens rotations, `x` (cols values) is overwritten
+  void add_row(Real* R, size_t n, size_t cols, Real* x);
+  // RᵀR - x xᵀ by hyperbolic rotations, `x` is overwritten. Returns false
+  // when the result would not be positive definite, R is then unusable.
+  bool remove_row(Real* R, size_t n, size_t cols, Real* x);
+  // Solve R x = b, zero pivots give 0
+  void back_substitute(const Real* R, size_t n, size_t stride, const Real* b, Real* x);
+}
+
+// Least squares weights of a stream of (x, y) observations, updated in
+// O(n²) per row. The factor [R z] of [X y] (z = Qᵀy) is kept instead of the
+// inverse covariance of classic RLS, which stays accurate in float and lets
+// rows be removed again (downdate) for sliding windows. Older rows are
+// weighted down by `forgetting` each update, 1 keeps them all.
+class RecursiveLeastSquares {
+  public:
+    RecursiveLeastSquares(size_t features, Real forgetting, Real regularization);
+    ~RecursiveLeastSquares();
+
+    void reset();
+    // Fold in `rows` observations, `x` is rows x features
+    void update(const Real* x, const Real* y, size_t rows);
+    // Remove observations at their original weight, e.g. the oldest of a
+    // window. Returns false, leaving the state as it was, when they were
+    // never added. Reports an error unless forgetting is 1.
+    bool downdate(const Real* x, const Real* y, size_t rows);
+    void weights(Real* out) const;
+    Real predict(const Real* x) const;
+
+  private:
+    size_t state_bytes() const;
+
+    size_t n;
+    Real forgetting;
+    Real regularization;
+    std::vector<Real> factor;  // n x (n + 1), [R z]
+    std::vector<Real> scratch;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Native memory accounting. The counters are always on (a few adds per
+// allocation), the per-buffer registry behind the leak report is only
+// kept in TENSOR_DEBUG builds.
+namespace memory {
+  struct Stats {
+    size_t tensors;       // live Tensor headers
+    size_t buffers;       // live (unique) data buffers
+    size_t buffer_bytes;  // bytes held by those buffers
+    size_t peak_bytes;    // high-water mark of buffer_bytes
+    size_t objects;       // other native objects (filters, ...)
+    size_t object_bytes;  // bytes held by those objects
+    size_t pool_bytes;    // freed blocks cached by the pool
+    size_t pool_hits;     // allocations served from the pool
+    size_t pool_misses;   // allocations that went to the system allocator
+  };
+
+  const Stats& stats();
+  void reset_peak();
+
+  void tensor_created();
+  void tensor_destroyed();
+
+  void buffer_allocated(const void* block, size_t bytes, size_t rows, size_t cols);
+  void buffer_released(const void* block, size_t bytes);
+
+  // Tensor storage is aligned to and padded out to a multiple of this, so the
+  // padding past the last element may be written (not read) by SIMD kernels
+  constexpr size_t BUFFER_ALIGNMENT = 64;
+  // Freed blocks up to this size are kept per size class for reuse, while the
+  // pool holds less than POOL_MAX_BYTES, larger blocks go straight back
+  constexpr size_t POOL_MAX_BLOCK = size_t(16) << 20;
+  constexpr size_t POOL_MAX_BYTES = size_t(64) << 20;
+
+  // Number of `T` that fit in the padded block holding `count` of them
+  template <typename T>
+  constexpr size_t padded_count(size_t count) {
+    return (count * sizeof(T) + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT / sizeof(T);
+  }
+
+  void* pool_allocate(size_t bytes);
+  void pool_release(void* block, size_t bytes);
+  // Return every cached block to the system allocator
+  void pool_trim();
+
+  // Aligned, pooled storage for tensor data, a steady frame loop allocating
+  // the same shapes every tick keeps reusing the same blocks
+  template <typename T>
+  struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+      return static_cast<T*>(pool_allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* block, size_t n) {
+      pool_release(block, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const { return false; }
+  };
+
+  void object_created(size_t bytes);
+  void object_resized(size_t old_bytes, size_t new_bytes);
+  void object_destroyed(size_t bytes);
+
+  // Handed to std::allocate_shared, serves the control block and vector
+  // header from the pooled size classes and records the buffer's bytes when
+  // it is allocated and released
+  template <typename T>
+  struct BufferAllocator {
+    using value_type = T;
+    size_t bytes;
+    size_t rows;
+    size_t cols;
+
+    BufferAllocator(size_t bytes, size_t rows, size_t cols)
+      : bytes(bytes), rows(rows), cols(cols) {}
+    template <typename U>
+    BufferAllocator(const BufferAllocator<U>& other)
+      : bytes(other.bytes), rows(other.rows), cols(other.cols) {}
+
+    // the vector header and control block come from the pool as well
+    T* allocate(size_t n) {
+      T* block = static_cast<T*>(pool_allocate(n * sizeof(T)));
+      buffer_allocated(block, bytes, rows, cols);
+      return block;
+    }
+
+    void deallocate(T* block, size_t n) {
+      buffer_released(block, bytes);
+      pool_release(block, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const BufferAllocator<U>& other) const { return bytes == other.bytes; }
+    template <typename U>
+    bool operator!=(const BufferAllocator<U>& other) const { return bytes != other.bytes; }
+  };
+
+  // Move a data vector into a tracked, shareable buffer
+  template <typename V>
+  std::shared_ptr<V> make_buffer(V&& vec, size_t rows, size_t cols) {
+    size_t bytes = vec.capacity() * sizeof(typename V::value_type);
+    return std::allocate_shared<V>(BufferAllocator<V>(bytes, rows, cols), std::move(vec));
+  }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "./Tensor.h"
+
+// Step kinds, matches PIPELINE_OP in src/ts/Pipeline.ts
+enum PIPELINE_OP {
+  // elementwise against a constant scalar, row or same-shape operand
+  PIPE_ADD,
+  PIPE_SUB,
+  PIPE_MUL,
+  PIPE_DIV,         // param0 no_nan
+  PIPE_MAXIMUM,
+  PIPE_MINIMUM,
+  // unary, param0 is the math mode where it applies
+  PIPE_ABS,
+  PIPE_SQUARE,
+  PIPE_CLIP,        // param0 lower, param1 upper
+  PIPE_EXP,
+  PIPE_LOG,
+  PIPE_SIGMOID,
+  PIPE_TANH,
+  // against a constant matrix
+  PIPE_MATMUL,
+  PIPE_TRANSFORM_POINTS,  // param0 divide
+  PIPE_TRANSPOSE,
+  // param0 axis, param1 keepdims
+  PIPE_SUM,
+  PIPE_MEAN,
+  PIPE_MIN,
+  PIPE_MAX
+};
+
+struct PipelineStep {
+  PIPELINE_OP op;
+  // constant right hand side, shares the data of the caller's tensor
+  std::shared_ptr<Tensor> operand;
+  Real param0;
+  Real param1;
+  // intermediate result, the last step writes to the output slot instead
+  std::shared_ptr<Tensor> out;
+};
+
+// A fixed chain of ops over frames of one shape. Every intermediate is
+// allocated while the chain is built, so running a frame allocates nothing.
+// Inputs and outputs are double-buffered: frame N reads input slot N % 2 and
+// writes output slot N % 2, the previous frame's slots stay untouched while
+// the next one is filled and computed.
+class Pipeline {
+  public:
+    Pipeline(size_t rows, size_t cols, bool is1d);
+    ~Pipeline();
+
+    // Append a step, validates it against the current output shape
+    void add_step(PIPELINE_OP op, const Tensor* operand, Real param0, Real param1);
+    // Run the frame in the next input slot, returns the slot it used
+    size_t run();
+
+    size_t size() const { return steps.size(); }
+    Tensor& input(size_t index) { return *inputs[index & 1]; }
+    Tensor& output(size_t index) { return *outputs[index & 1]; }
+
+  private:
+    size_t state_bytes() const;
+
+    std::vector<PipelineStep> steps;
+    std::shared_ptr<Tensor> inputs[2];
+    std::shared_ptr<Tensor> outputs[2];
+    size_t slot = 0;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Per-op instrumentation, enabled with -DTENSOR_PROFILE (make PROFILE=1).
+// Without the flag the hooks below expand to nothing so production builds
+// carry zero overhead.
+#ifdef TENSOR_PROFILE
+#include <chrono>
+
+struct OpStats {
+  const char* name;
+  uint64_t calls;
+  uint64_t total_ns;
+  uint64_t max_ns;
+  uint64_t elements;
+  uint64_t bytes;
+};
+
+namespace profiler {
+  // Ops register themselves once, on first call, and keep their id
+  size_t register_op(const char* name);
+  // Attribute an allocation to the op currently running (if any)
+  void record_alloc(size_t bytes);
+  // Name of the op currently running, used to tag allocations
+  const char* current_op();
+
+  // Times the enclosing block and attributes it to `op`
+  class Scope {
+    public:
+      Scope(size_t op, size_t elements);
+      ~Scope();
+
+    private:
+      size_t op;
+      size_t parent;
+      std::chrono::steady_clock::time_point start;
+  };
+}
+
+#define TENSOR_PROFILE_OP(name, elements) \
+  static const size_t profile_op_id = profiler::register_op(name); \
+  profiler::Scope profile_scope(profile_op_id, elements)
+#define TENSOR_PROFILE_ALLOC(bytes) profiler::record_alloc(bytes)
+
+#else
+
+#define TENSOR_PROFILE_OP(name, elements)
+#define TENSOR_PROFILE_ALLOC(bytes)
+
+#endif
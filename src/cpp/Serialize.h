@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include "./Tensor.h"
+
+// Native builds can open serialized files as read-only memory mapped views
+#if !defined(__EMSCRIPTEN__) && defined(__has_include)
+#  if __has_include(<sys/mman.h>)
+#    define TENSOR_MMAP
+#  endif
+#endif
+
+/*
+ * Binary tensor format, all fields little-endian:
+ *
+ *   TensorHeader (32 bytes), padding up to `data_offset`, raw row-major data
+ *
+ * A bundle stores several tensors:
+ *
+ *   BundleHeader (16 bytes), uint64 offset per tensor, padding, tensors
+ *
+ * Every tensor in a bundle starts on an ALIGNMENT boundary, so payloads stay
+ * aligned when a file is memory mapped.
+ */
+namespace serialize {
+  constexpr size_t ALIGNMENT = 64;
+  constexpr uint16_t VERSION = 1;
+
+  enum DTYPE : uint8_t {
+    FLOAT32,
+    FLOAT64
+  };
+
+  struct TensorHeader {
+    char magic[4];          // "FTNS"
+    uint16_t version;
+    uint8_t dtype;
+    uint8_t flags;          // bit 0: is1d
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t alignment;
+    uint32_t data_offset;   // from the start of the header
+    uint64_t data_bytes;
+  };
+
+  struct BundleHeader {
+    char magic[4];          // "FTNB"
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t count;
+    uint32_t table_offset;  // offset of the uint64 offset table
+  };
+
+  static_assert(sizeof(TensorHeader) == 32, "TensorHeader must be packed to 32 bytes");
+  static_assert(sizeof(BundleHeader) == 16, "BundleHeader must be packed to 16 bytes");
+
+  constexpr size_t align(size_t offset) {
+    return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  }
+
+  size_t tensor_size(const Tensor& tensor);
+  size_t write_tensor(const Tensor& tensor, uint8_t* out);
+  // Copy out and validate a header, reporting an error if it is invalid
+  bool read_header(const uint8_t* buffer, size_t size, TensorHeader& header);
+  Tensor read_tensor(const uint8_t* buffer, size_t size);
+
+  size_t bundle_size(const Tensor* const* tensors, size_t count);
+  size_t write_bundle(const Tensor* const* tensors, size_t count, uint8_t* out);
+  size_t bundle_count(const uint8_t* buffer, size_t size);
+  // Bytes of the bundle header and offset table, which is all the bundle
+  // functions below read
+  size_t bundle_table_size(const uint8_t* buffer, size_t size);
+  // Offset and size of a tensor inside a bundle
+  bool bundle_range(const uint8_t* buffer, size_t size, size_t index, size_t* start, size_t* entry_size);
+  // Locate a tensor inside a bundle, `entry_size` receives the bytes available to it
+  const uint8_t* bundle_entry(const uint8_t* buffer, size_t size, size_t index, size_t* entry_size);
+}
+
+#ifdef TENSOR_MMAP
+// Zero-copy read-only view over a tensor stored in a mapped file
+struct TensorView {
+  size_t rows;
+  size_t cols;
+  bool is1d;
+  const Real* data;
+};
+
+// Memory maps a serialized tensor or bundle, views point straight into the mapping
+class MappedTensorFile {
+  public:
+    explicit MappedTensorFile(const char* path);
+    MappedTensorFile(const MappedTensorFile&) = delete;
+    MappedTensorFile& operator=(const MappedTensorFile&) = delete;
+    ~MappedTensorFile();
+
+    bool is_open() const;
+    size_t count() const;
+    // Only available when the stored dtype matches Real
+    TensorView view(size_t index = 0) const;
+    // Copy (converting the dtype if needed) into a regular tensor
+    Tensor load(size_t index = 0) const;
+
+  private:
+    const uint8_t* entry(size_t index, size_t* entry_size) const;
+
+    const uint8_t* mapping = nullptr;
+    size_t size = 0;
+    bool is_bundle = false;
+};
+#endif
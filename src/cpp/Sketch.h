@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include "./Tensor.h"
+
+// KLL quantile sketch (Karnin, Lang, Liberty, "Optimal quantile
+// approximation in streams"). Values are kept in levels of compactors, an
+// item at level h stands for 2^h values. Once all levels reach their
+// capacity the lowest full one is sorted and every other item (from a
+// random offset) is promoted, so memory stays around 3 * k items however
+// many values are pushed. Sketches of the same k merge level by level,
+// e.g. one per worker or per frame window.
+class QuantileSketch {
+  public:
+    // Smallest capacity of a level, keeps compactions of the low levels rare
+    static constexpr size_t MIN_CAPACITY = 8;
+
+    // Rank error is about 1.7 / k, k = 200 gives ~1%
+    explicit QuantileSketch(size_t k = 200);
+    ~QuantileSketch();
+
+    void reset();
+    // NaN values are skipped
+    void push(const Real* values, size_t size);
+    void merge(const QuantileSketch& other);
+
+    double count() const;
+    size_t retained() const;
+    Real min() const;
+    Real max() const;
+    // Approximate quantiles, q = 0 and q = 1 are the exact min and max
+    void quantiles(const Real* qs, size_t q_count, Real* out) const;
+    // Approximate fraction of the values <= `value`
+    Real rank(Real value) const;
+
+  private:
+    size_t capacity(size_t level) const;
+    void compact(size_t level);
+    void compress();
+    size_t state_bytes() const;
+
+    size_t k;
+    double n = 0;
+    Real lo;
+    Real hi;
+    uint32_t coin;
+    std::vector<std::vector<Real>> levels;
+    size_t stored = 0;  // items in all levels
+    size_t limit = 0;   // sum of the level capacities
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include "./Tensor.h"
+
+// Compressed sparse row matrix, only the nonzeros are stored so memory and
+// products scale with nnz() rather than rows x cols. Within a row the column
+// indices are sorted and unique.
+class SparseTensor {
+  public:
+    SparseTensor(size_t rows, size_t cols);
+    // Entries of `dense` with an absolute value above `tolerance`
+    SparseTensor(const Tensor& dense, Real tolerance = 0.0f);
+    // Coordinate (COO) triplets in any order, duplicates are summed
+    SparseTensor(size_t rows, size_t cols, const Tensor& row_indices, const Tensor& col_indices, const Tensor& values);
+    // Reports an error and returns false for triplets the COO constructor
+    // can't take, bindings check before allocating
+    static bool check_coo(size_t rows, size_t cols, const Tensor& row_indices, const Tensor& col_indices, const Tensor& values);
+    SparseTensor(const SparseTensor& other);
+    ~SparseTensor();
+
+    size_t rows() const { return nrows; }
+    size_t cols() const { return ncols; }
+    size_t nnz() const { return values.size(); }
+
+    Tensor to_dense() const;
+    // Sparse matrix times a vector of cols() values, a 1d tensor or a column
+    Tensor spmv(const Tensor& vec) const;
+    // Sparse matrix times a dense (cols() x k) tensor
+    Tensor spmm(const Tensor& dense) const;
+    SparseTensor transpose() const;
+    SparseTensor scale(Real factor) const;
+    // Multiply every row (or column) by the matching value of `factors`
+    SparseTensor scale_rows(const Tensor& factors) const;
+    SparseTensor scale_cols(const Tensor& factors) const;
+    // Reports an error and returns false when `factors` doesn't hold one
+    // value per row (or column)
+    bool check_row_factors(const Tensor& factors) const;
+    bool check_col_factors(const Tensor& factors) const;
+
+  private:
+    size_t state_bytes() const;
+
+    size_t nrows;
+    size_t ncols;
+    std::vector<uint32_t> indptr;   // rows + 1 offsets into indices / values
+    std::vector<uint32_t> indices;  // column of each nonzero
+    std::vector<Real> values;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include "./Tensor.h"
+
+// KD-tree over the rows of an Nx2 or Nx3 point tensor. Every node keeps the
+// bounding box of its points, queries prune on those boxes, so moving the
+// points only needs the boxes refit rather than a full rebuild.
+class KDTree {
+  public:
+    static constexpr size_t DEFAULT_LEAF_SIZE = 16;
+    // rebuild once the refit leaves cover this much more space than when built
+    static constexpr Real REBUILD_RATIO = 2.0f;
+
+    KDTree(const Tensor& points, size_t leaf_size = DEFAULT_LEAF_SIZE);
+    ~KDTree();
+
+    void build(const Tensor& points);
+    // Update positions of the same points, returns true if it had to rebuild
+    bool refit(const Tensor& points);
+
+    size_t size() const;
+    size_t dims() const;
+    // Indices of the `k` nearest points per query row, nearest first and padded
+    // with -1, `distances` (queries x k) receives the matching distances
+    Tensor knn(const Tensor& queries, size_t k, Tensor* distances) const;
+    // Indices of points within `radius` per query row, nearest first, at most
+    // `max_results` each, padded with -1
+    Tensor radius(const Tensor& queries, Real radius, size_t max_results, Tensor* distances) const;
+
+  private:
+    struct Node {
+      Real lo[3];
+      Real hi[3];
+      uint32_t begin;
+      uint32_t end;
+      // child indices, 0 for leaves (the root is never a child)
+      uint32_t left;
+      uint32_t right;
+    };
+    // (squared distance, point index) candidates
+    using Candidate = std::pair<Real, uint32_t>;
+
+    uint32_t build_node(uint32_t begin, uint32_t end, const Real* lo, const Real* hi);
+    void fit_node(uint32_t node);
+    Real box_extent(const Node& node) const;
+    Real leaf_extent() const;
+    Real box_distance(const Node& node, const Real* point) const;
+    void search_knn(uint32_t node, const Real* point, size_t k, std::vector<Candidate>& heap) const;
+    void search_radius(uint32_t node, const Real* point, Real radius_sq, std::vector<Candidate>& found) const;
+    bool check_points(const Tensor& points, bool same_size) const;
+    size_t state_bytes() const;
+
+    size_t count = 0;
+    size_t ndims = 0;
+    size_t leaf_size;
+    Real built_extent = 0.0f;
+    std::vector<Real> points;       // row-major copy, count x ndims
+    std::vector<uint32_t> order;    // point indices, each leaf owns a contiguous range
+    std::vector<Node> nodes;
+};
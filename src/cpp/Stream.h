@@ -0,0 +1,52 @@
+#pragma once
+
+#include "./Tensor.h"
+
+enum STREAM_REDUCE {
+  STREAM_SUM,
+  STREAM_MEAN,
+  STREAM_MIN,
+  STREAM_MAX,
+  STREAM_NORM
+};
+
+// Accumulates reductions over a logical tensor that is fed in row-chunks,
+// so only the per-column accumulators live in memory. With a resident
+// matrix every chunk is multiplied through it tile by tile first, and the
+// reductions apply to the projected rows.
+class TensorStream {
+  public:
+    // Rows processed per matmul tile, keeps the scratch tile small
+    static constexpr size_t TILE_ROWS = 64;
+
+    TensorStream(size_t cols, const Tensor* resident = nullptr);
+    ~TensorStream();
+
+    void reset();
+    // Push `rows` rows of `cols` values, when projecting, `out` (if given)
+    // receives the rows x resident.cols result of the chunk
+    void push(const Real* chunk, size_t rows, Real* out = nullptr);
+#ifndef __EMSCRIPTEN__
+    // Stream a serialized tensor from disk, `chunk_rows` at a time
+    void push_file(const char* path, size_t chunk_rows);
+#endif
+
+    size_t rows_seen() const;
+    size_t output_cols() const;
+    Tensor reduce(STREAM_REDUCE op, NORM_ORD ord, int axis, bool keepdims) const;
+
+  private:
+    void accumulate(const Real* rows_data, size_t rows);
+    size_t state_bytes() const;
+
+    size_t cols;
+    size_t count = 0;
+    std::shared_ptr<Tensor> resident;
+    std::vector<Real> tile;
+    // accumulated in double, these streams can be billions of values long
+    std::vector<double> sums;
+    std::vector<double> abs_sums;
+    std::vector<double> sq_sums;
+    std::vector<Real> mins;
+    std::vector<Real> maxs;
+};
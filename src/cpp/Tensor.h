@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <cmath>
 #include "./ErrorHelper.h"
+#include "./Profiler.h"
+#include "./Memory.h"
 
 #ifdef USE_DOUBLE
 using Real = double;
@@ -13,6 +15,9 @@ using Real = double;
 using Real = float;
 #endif
 
+// Tensor storage, 64 byte aligned and recycled through the size-class pool
+using Buffer = std::vector<Real, memory::PoolAllocator<Real>>;
+
 
 // Don't allow std::cout in production builds
 #ifdef TENSOR_DEBUG
@@ -26,6 +31,50 @@ enum NORM_ORD {
   MAX
 };
 
+enum DIST_METRIC {
+  EUCLIDEAN,
+  SQEUCLIDEAN,
+  CITYBLOCK,
+  COSINE
+};
+
+enum CONV_MODE {
+  CONV_FULL,
+  CONV_SAME,
+  CONV_VALID
+};
+
+// Layout of spectra, complex values are (re, im) pairs along the axis
+enum FFT_FORMAT {
+  FFT_COMPLEX,
+  FFT_POLAR,      // (magnitude, phase) pairs
+  FFT_MAGNITUDE
+};
+
+// Elementwise transcendentals through libm or the approximations in FastMath.h
+enum MATH_MODE {
+  MATH_PRECISE,
+  MATH_FAST
+};
+
+// Elementwise comparisons, the result is a mask of 1 (true) and 0 (false)
+enum COMPARE_OP {
+  CMP_EQUAL,
+  CMP_NOT_EQUAL,
+  CMP_GREATER,
+  CMP_GREATER_EQUAL,
+  CMP_LESS,
+  CMP_LESS_EQUAL
+};
+
+// Running reductions of Tensor::scan
+enum SCAN_OP {
+  SCAN_SUM,
+  SCAN_PROD,
+  SCAN_MAX,
+  SCAN_MIN
+};
+
 struct Bounds {
   Real xmin;
   Real ymin;
@@ -45,22 +94,25 @@ class Tensor {
     size_t cols;
     bool is1d;
 
-    std::shared_ptr<std::vector<Real>> data;
+    std::shared_ptr<Buffer> data;
 
     Tensor(size_t rows, size_t cols, bool is1d);
-    Tensor(size_t rows, size_t cols, bool is1d, std::shared_ptr<std::vector<Real>> shared_data_ptr);
+    Tensor(size_t rows, size_t cols, bool is1d, std::shared_ptr<Buffer> shared_data_ptr);
     //Tensor(size_t rows, size_t cols, bool is1d, std::shared_ptr<std::vector<Real>>& data_copy);
-    Tensor(size_t rows, size_t cols, bool is1d, std::vector<Real> data_copy);
+    Tensor(size_t rows, size_t cols, bool is1d, Buffer data_copy);
     //Tensor(size_t rows, size_t cols, bool is1d, const std::vector<Real>& data_copy);
     Tensor(const Tensor& other);
+    // Takes over the data of a temporary instead of deep copying it
+    Tensor(Tensor&& other);
     ~Tensor();
 
     // TODO tf.Variable - mutable objects
 
     Tensor deepcopy() const;
-    const std::vector<Real>& data_ref() const;
-    std::vector<Real>& data_ref();
-    //void ensure_unique();
+    const Buffer& data_ref() const;
+    Buffer& data_ref();
+    // Copy the data into a buffer of its own if other tensors share it
+    void ensure_unique();
     //Real get(size_t row, size_t col) const;
     //void set(size_t row, size_t col, Real value);
 
@@ -70,10 +122,15 @@ class Tensor {
     // Helpers
     template <typename Func>
     Tensor apply_math_op(Func func) const;
-    // implemented in core.cpp
-    Tensor math_op(Real (*op)(Real)) const;
     template <typename Func>
     Tensor broadcast_op(const Real* input, size_t input_size, Func func) const;
+    template <typename Func>
+    void apply_math_op_into(Tensor& dst, Func func) const;
+    template <typename Func>
+    void broadcast_op_into(Tensor& dst, const Real* input, size_t input_size, Func func) const;
+    // Shape of reducing along `axis`, and a zeroed tensor of that shape
+    Shape reduction_shape(int axis, bool keepdims) const;
+    Tensor reduction_result(int axis, bool keepdims) const;
 
 
     Tensor eye() const;
@@ -83,7 +140,6 @@ class Tensor {
     Tensor flatten() const;
     Tensor reshape(const int new_rows, const int new_cols) const;
     Tensor reverse(const int axis) const;
-    Tensor stack(const Real* instances, size_t input_size) const;
 
 
     // arithmetic
@@ -103,23 +159,50 @@ class Tensor {
     Tensor acosh() const;
     Tensor asin() const;
     Tensor asinh() const;
-    Tensor atan() const;
-    Tensor atan2(const Real* input, size_t input_size) const;
+    Tensor atan(MATH_MODE mode = MATH_PRECISE) const;
+    Tensor atan2(const Real* input, size_t input_size, MATH_MODE mode = MATH_PRECISE) const;
     Tensor atanh() const;
     Tensor ceil() const;
     Tensor clip(const Real lower, const Real upper) const;
-    Tensor cos() const;
+    Tensor cos(MATH_MODE mode = MATH_PRECISE) const;
     Tensor cosh() const;
+    Tensor exp(MATH_MODE mode = MATH_PRECISE) const;
     Tensor floor() const;
+    Tensor log(MATH_MODE mode = MATH_PRECISE) const;
+    Tensor sigmoid(MATH_MODE mode = MATH_PRECISE) const;
+    Tensor sin(MATH_MODE mode = MATH_PRECISE) const;
     Tensor square() const;
+    Tensor tanh(MATH_MODE mode = MATH_PRECISE) const;
+
+    // filter
+    Tensor conv1d(const Real* kernel, size_t kernel_size, int axis, CONV_MODE mode) const;
+
+    // fft
+    Tensor rfft(int axis, FFT_FORMAT format = FFT_COMPLEX) const;
+    Tensor irfft(size_t n, int axis) const;
+    Tensor fft(int axis, bool inverse = false, FFT_FORMAT format = FFT_COMPLEX) const;
 
     // linalg
     Tensor qr(Tensor* Q) const;
+    // R of A + u vᵀ from this R and `Q` of A, Q is updated in place
+    Tensor qr_update(Tensor* Q, const Real* u, size_t u_size, const Real* v, size_t v_size) const;
+    // Lower triangular L with L Lᵀ = this (symmetric positive definite)
+    Tensor cholesky() const;
+    // L of L Lᵀ + x xᵀ, or L Lᵀ - x xᵀ when `downdate`, from this L
+    Tensor cholesky_update(const Real* x, size_t size, bool downdate) const;
+
+    // logical, masks are nonzero for true
+    Tensor compare(COMPARE_OP op, const Real* input, size_t input_size) const;
+    Tensor where(const Real* a, size_t a_size, const Real* b, size_t b_size) const;
+    Tensor masked_fill(const Real* mask, size_t mask_size, Real value) const;
+    Tensor boolean_mask(const Real* mask, size_t mask_size, int axis) const;
 
     // matrices
     Tensor norm(NORM_ORD ord, int axis, bool keepdims = false) const;
     Tensor matmul(const Tensor& other) const;
     Tensor dot(const Tensor& other) const;
+    Tensor cdist(const Tensor& other, DIST_METRIC metric) const;
+    Tensor transform_points(const Tensor& matrix, bool divide = true, Real* bounds = nullptr) const;
 
     // reduction
     Tensor all(int axis, bool keepdims = false) const;
@@ -131,6 +214,74 @@ class Tensor {
     Tensor min(int axis, bool keepdims = false) const;
     Tensor prod(int axis, bool keepdims = false) const;
     Tensor sum(int axis, bool keepdims = false) const;
+    // Same shape, every value is the reduction of the ones before it along
+    // `axis` (-1 for all values in order), including itself unless `exclusive`
+    Tensor scan(SCAN_OP op, int axis, bool exclusive = false) const;
+
+    // statistics
+    // Counts of `bins` equal bins over [low, high] along `axis`, the reduced
+    // axis becomes the bins. Without a range (low and high NaN) the min and
+    // max of the finite values are used.
+    Tensor histogram(size_t bins, Real low, Real high, int axis) const;
+    // Occurrences (or summed `weights`) of each non-negative integer value
+    Tensor bincount(size_t min_length, const Real* weights, size_t weights_size) const;
+    // Quantiles with linear interpolation along `axis`, NaN values are skipped.
+    // A single quantile is shaped like a reduction, several replace the axis.
+    Tensor quantile(const Real* qs, size_t q_count, int axis, bool keepdims = false) const;
+
+    // sorting
+    Tensor sort(int axis, bool descending = false) const;
+    Tensor argsort(int axis, bool descending = false) const;
+    Tensor topk(size_t k, int axis, bool largest, Tensor* indices) const;
+
+    // Destination forms, the result is written into `dst`, which already has
+    // the result shape. Nothing is allocated, the ops above wrap these.
+    // Elementwise ops may write in place, the others need a separate `dst`.
+    void add_into(Tensor& dst, const Real* input, size_t input_size) const;
+    void sub_into(Tensor& dst, const Real* input, size_t input_size) const;
+    void mul_into(Tensor& dst, const Real* input, size_t input_size) const;
+    void div_into(Tensor& dst, bool no_nan, const Real* input, size_t input_size) const;
+    void maximum_into(Tensor& dst, const Real* input, size_t input_size) const;
+    void minimum_into(Tensor& dst, const Real* input, size_t input_size) const;
+    void mod_into(Tensor& dst, const Real* input, size_t input_size) const;
+    void pow_into(Tensor& dst, const Real* input, size_t input_size) const;
+    void squared_diff_into(Tensor& dst, const Real* input, size_t input_size) const;
+    void abs_into(Tensor& dst) const;
+    void acos_into(Tensor& dst) const;
+    void acosh_into(Tensor& dst) const;
+    void asin_into(Tensor& dst) const;
+    void asinh_into(Tensor& dst) const;
+    void atan_into(Tensor& dst, MATH_MODE mode = MATH_PRECISE) const;
+    void atan2_into(Tensor& dst, const Real* input, size_t input_size, MATH_MODE mode = MATH_PRECISE) const;
+    void atanh_into(Tensor& dst) const;
+    void ceil_into(Tensor& dst) const;
+    void clip_into(Tensor& dst, const Real lower, const Real upper) const;
+    void cos_into(Tensor& dst, MATH_MODE mode = MATH_PRECISE) const;
+    void cosh_into(Tensor& dst) const;
+    void exp_into(Tensor& dst, MATH_MODE mode = MATH_PRECISE) const;
+    void floor_into(Tensor& dst) const;
+    void log_into(Tensor& dst, MATH_MODE mode = MATH_PRECISE) const;
+    void sigmoid_into(Tensor& dst, MATH_MODE mode = MATH_PRECISE) const;
+    void sin_into(Tensor& dst, MATH_MODE mode = MATH_PRECISE) const;
+    void square_into(Tensor& dst) const;
+    void tanh_into(Tensor& dst, MATH_MODE mode = MATH_PRECISE) const;
+    void compare_into(Tensor& dst, COMPARE_OP op, const Real* input, size_t input_size) const;
+    void where_into(Tensor& dst, const Real* a, size_t a_size, const Real* b, size_t b_size) const;
+    void masked_fill_into(Tensor& dst, const Real* mask, size_t mask_size, Real value) const;
+    void pad_into(Tensor& dst, Real constant, size_t rpad_before, size_t cpad_before) const;
+    void transpose_into(Tensor& dst) const;
+    void matmul_into(Tensor& dst, const Tensor& other) const;
+    void transform_points_into(Tensor& dst, const Tensor& matrix, bool divide = true, Real* bounds = nullptr) const;
+    void all_into(Tensor& dst, int axis) const;
+    void any_into(Tensor& dst, int axis) const;
+    void arg_max_into(Tensor& dst, int axis) const;
+    void arg_min_into(Tensor& dst, int axis) const;
+    void max_into(Tensor& dst, int axis) const;
+    void mean_into(Tensor& dst, int axis) const;
+    void min_into(Tensor& dst, int axis) const;
+    void prod_into(Tensor& dst, int axis) const;
+    void sum_into(Tensor& dst, int axis) const;
+    void scan_into(Tensor& dst, SCAN_OP op, int axis, bool exclusive = false) const;
 
 
   private:
@@ -141,4 +292,14 @@ class Tensor {
 // the additional interop to sync it
 void update_shape_wire(Tensor* tensor, int* shape_wire);
 
+// Checks a caller-provided `out` tensor of the `*_into` bindings has the
+// result shape and gives it a buffer of its own, so tensors sharing its data
+// are left untouched. `inputs` are read while `out` is written and can't be
+// the same tensor. Returns false after reporting an error.
+bool prepare_out(Tensor* out, size_t rows, size_t cols, const Tensor* const* inputs, size_t count);
+inline bool prepare_out(Tensor* out, size_t rows, size_t cols, std::initializer_list<const Tensor*> inputs = {}) {
+  return prepare_out(out, rows, cols, inputs.begin(), inputs.size());
+}
+
 #include "./Tensor.tpp"
+#include "./Handles.h"
@@ -1,39 +1,56 @@
 #pragma once
 
-// Generic math operation
+// Generic math operation, `func` is a functor (or lambda) so it inlines
+// into the loop and the loop can vectorize
 template <typename Func>
 Tensor Tensor::apply_math_op(Func func) const {
-  Tensor result = deepcopy();
-  auto& vec = (*result.data);
-  for (auto& elem : vec) {
-    elem = func(elem);
-  }
+  Tensor result(rows, cols, is1d);
+  apply_math_op_into(result, func);
   return result;
 }
 
+// Same, written into `dst` of the same size, which may be this tensor
+template <typename Func>
+void Tensor::apply_math_op_into(Tensor& dst, Func func) const {
+  const Real* src = data_ref().data();
+  Real* out = dst.data->data();
+  // the padding past rows * cols is never initialized, so it isn't read
+  size_t size = rows * cols;
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = func(src[i]);
+  }
+}
+
 // Generic broadcastable operation
 template <typename Func>
 Tensor Tensor::broadcast_op(const Real* input, size_t input_size, Func func) const {
-  Tensor result = deepcopy();
-  auto& vec = (*result.data);
+  Tensor result(rows, cols, is1d);
+  broadcast_op_into(result, input, input_size, func);
+  return result;
+}
+
+template <typename Func>
+void Tensor::broadcast_op_into(Tensor& dst, const Real* input, size_t input_size, Func func) const {
+  const Real* src = data_ref().data();
+  Real* out = dst.data->data();
 
   if (input_size == 1) {
     Real scalar = input[0];
-    for (auto& elem : vec) {
-      elem = func(elem, scalar);
+    for (size_t i = 0; i < rows * cols; ++i) {
+      out[i] = func(src[i], scalar);
     }
   } else if (input_size == cols) {
     for (size_t i = 0; i < rows; ++i) {
       for (size_t j = 0; j < cols; ++j) {
         size_t index = i * cols + j;
-        vec[index] = func(vec[index], input[j]);
+        out[index] = func(src[index], input[j]);
       }
     }
   } else if (input_size == cols * rows) {
     for (size_t i = 0; i < rows; ++i) {
       for (size_t j = 0; j < cols; ++j) {
         size_t index = i * cols + j;
-        vec[index] = func(vec[index], input[index]);
+        out[index] = func(src[index], input[index]);
       }
     }
   } else {
@@ -41,6 +58,4 @@ Tensor Tensor::broadcast_op(const Real* input, size_t input_size, Func func) con
         + std::to_string(rows) + "," + std::to_string(cols) + "]";
     report_error(message.c_str());
   }
-  return result;
 }
-
@@ -2,104 +2,239 @@
 
 // Add by a scalar, column-wise array, or tensor
 Tensor Tensor::add(const Real* input, size_t input_size) const {/*{{{*/
-  return Tensor::broadcast_op(input, input_size,
-      [](Real a, Real b) { return a + b; });
+  Tensor result(rows, cols, is1d);
+  add_into(result, input, input_size);
+  return result;
 }/*}}}*/
 
+void Tensor::add_into(Tensor& dst, const Real* input, size_t input_size) const {
+  broadcast_op_into(dst, input, input_size,
+      [](Real a, Real b) { return a + b; });
+}
+
 // Subtract by a scalar, column-wise array, or tensor
 Tensor Tensor::sub(const Real* input, size_t input_size) const {/*{{{*/
-  return Tensor::broadcast_op(input, input_size,
-      [](Real a, Real b) { return a - b; });
+  Tensor result(rows, cols, is1d);
+  sub_into(result, input, input_size);
+  return result;
 }/*}}}*/
 
+void Tensor::sub_into(Tensor& dst, const Real* input, size_t input_size) const {
+  broadcast_op_into(dst, input, input_size,
+      [](Real a, Real b) { return a - b; });
+}
+
 // Multiply by a scalar, column-wise array, or tensor
 Tensor Tensor::mul(const Real* input, size_t input_size) const {/*{{{*/
-  return Tensor::broadcast_op(input, input_size,
-      [](Real a, Real b) { return a * b; });
+  Tensor result(rows, cols, is1d);
+  mul_into(result, input, input_size);
+  return result;
 }/*}}}*/
 
+void Tensor::mul_into(Tensor& dst, const Real* input, size_t input_size) const {
+  broadcast_op_into(dst, input, input_size,
+      [](Real a, Real b) { return a * b; });
+}
+
 // Divide by a scalar, column-wise array, or tensor
 Tensor Tensor::div(bool no_nan, const Real* input, size_t input_size) const {/*{{{*/
-  Tensor result = Tensor::broadcast_op(input, input_size,
+  Tensor result(rows, cols, is1d);
+  div_into(result, no_nan, input, input_size);
+  return result;
+}/*}}}*/
+
+void Tensor::div_into(Tensor& dst, bool no_nan, const Real* input, size_t input_size) const {/*{{{*/
+  broadcast_op_into(dst, input, input_size,
       [](Real a, Real b) { return a / b; });
   if (no_nan) {
-    auto& vec = (*result.data);
-    for (auto& elem : vec) {
-      if (elem == Tensor::INF || std::isnan(elem)) {
-        elem = 0;
+    Real* out = dst.data->data();
+    for (size_t i = 0; i < rows * cols; ++i) {
+      if (out[i] == Tensor::INF || std::isnan(out[i])) {
+        out[i] = 0;
       }
     }
   }
-  return result;
 }/*}}}*/
 
 // Return the maximum of current data
 Tensor Tensor::maximum(const Real* input, size_t input_size) const {/*{{{*/
-  return Tensor::broadcast_op(input, input_size,
-      [](Real a, Real b) { return std::max(a,b); });
+  Tensor result(rows, cols, is1d);
+  maximum_into(result, input, input_size);
+  return result;
 }/*}}}*/
 
+void Tensor::maximum_into(Tensor& dst, const Real* input, size_t input_size) const {
+  broadcast_op_into(dst, input, input_size,
+      [](Real a, Real b) { return std::max(a,b); });
+}
+
 // Return the minimum of current data
 Tensor Tensor::minimum(const Real* input, size_t input_size) const {/*{{{*/
-  return Tensor::broadcast_op(input, input_size,
-      [](Real a, Real b) { return std::min(a,b); });
+  Tensor result(rows, cols, is1d);
+  minimum_into(result, input, input_size);
+  return result;
 }/*}}}*/
 
+void Tensor::minimum_into(Tensor& dst, const Real* input, size_t input_size) const {
+  broadcast_op_into(dst, input, input_size,
+      [](Real a, Real b) { return std::min(a,b); });
+}
+
 // Return the mod of current data
 Tensor Tensor::mod(const Real* input, size_t input_size) const {/*{{{*/
-  return Tensor::broadcast_op(input, input_size,
-      [](Real a, Real b) { return std::fmod(a,b); });
+  Tensor result(rows, cols, is1d);
+  mod_into(result, input, input_size);
+  return result;
 }/*}}}*/
 
+void Tensor::mod_into(Tensor& dst, const Real* input, size_t input_size) const {
+  broadcast_op_into(dst, input, input_size,
+      [](Real a, Real b) { return std::fmod(a,b); });
+}
+
 // Return the pow of current data
 Tensor Tensor::pow(const Real* input, size_t input_size) const {/*{{{*/
-  return Tensor::broadcast_op(input, input_size,
-      [](Real a, Real b) { return std::pow(a,b); });
+  Tensor result(rows, cols, is1d);
+  pow_into(result, input, input_size);
+  return result;
 }/*}}}*/
 
+void Tensor::pow_into(Tensor& dst, const Real* input, size_t input_size) const {
+  broadcast_op_into(dst, input, input_size,
+      [](Real a, Real b) { return std::pow(a,b); });
+}
+
 // Return the squared_diff of current data
 Tensor Tensor::squared_diff(const Real* input, size_t input_size) const {/*{{{*/
-  return Tensor::broadcast_op(input, input_size,
+  Tensor result(rows, cols, is1d);
+  squared_diff_into(result, input, input_size);
+  return result;
+}/*}}}*/
+
+void Tensor::squared_diff_into(Tensor& dst, const Real* input, size_t input_size) const {
+  broadcast_op_into(dst, input, input_size,
       [](Real a, Real b) {
       Real diff = a - b;
       return diff * diff;
       });
-}/*}}}*/
+}
 
 extern "C" {
-  Tensor* tensor_add(Tensor* tensor, const Real* input, size_t size) {
-    return new Tensor(tensor->add(input, size));
+  TensorHandle tensor_add(TensorHandle tensor, const Real* input, size_t size) {
+    TENSOR_PROFILE_OP("add", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->add(input, size));
+  }
+
+  TensorHandle tensor_sub(TensorHandle tensor, const Real* input, size_t size) {
+    TENSOR_PROFILE_OP("sub", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->sub(input, size));
   }
 
-  Tensor* tensor_sub(Tensor* tensor, const Real* input, size_t size) {
-    return new Tensor(tensor->sub(input, size));
+  TensorHandle tensor_mul(TensorHandle tensor, const Real* input, size_t size) {
+    TENSOR_PROFILE_OP("mul", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->mul(input, size));
   }
 
-  Tensor* tensor_mul(Tensor* tensor, const Real* input, size_t size) {
-    return new Tensor(tensor->mul(input, size));
+  TensorHandle tensor_div(TensorHandle tensor, bool no_nan, const Real* input, size_t size) {
+    TENSOR_PROFILE_OP("div", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->div(no_nan, input, size));
   }
 
-  Tensor* tensor_div(Tensor* tensor, bool no_nan, const Real* input, size_t size) {
-    return new Tensor(tensor->div(no_nan, input, size));
+  TensorHandle tensor_maximum(TensorHandle tensor, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("maximum", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->maximum(input, input_size));
   }
 
-  Tensor* tensor_maximum(Tensor* tensor, const Real* input, size_t input_size) {
-    return new Tensor(tensor->maximum(input, input_size));
+  TensorHandle tensor_minimum(TensorHandle tensor, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("minimum", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->minimum(input, input_size));
   }
 
-  Tensor* tensor_minimum(Tensor* tensor, const Real* input, size_t input_size) {
-    return new Tensor(tensor->minimum(input, input_size));
+  TensorHandle tensor_mod(TensorHandle tensor, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("mod", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->mod(input, input_size));
   }
 
-  Tensor* tensor_mod(Tensor* tensor, const Real* input, size_t input_size) {
-    return new Tensor(tensor->mod(input, input_size));
+  TensorHandle tensor_pow(TensorHandle tensor, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("pow", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->pow(input, input_size));
   }
 
-  Tensor* tensor_pow(Tensor* tensor, const Real* input, size_t input_size) {
-    return new Tensor(tensor->pow(input, input_size));
+  TensorHandle tensor_squared_diff(TensorHandle tensor, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("squared_diff", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->squared_diff(input, input_size));
   }
 
-  Tensor* tensor_squared_diff(Tensor* tensor, const Real* input, size_t input_size) {
-    return new Tensor(tensor->squared_diff(input, input_size));
+  // `*_into` write into `out` (same shape as `tensor`) and return its data
+  Real* tensor_add_into(TensorHandle out, TensorHandle tensor, const Real* input, size_t size) {
+    TENSOR_PROFILE_OP("add", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->add_into(*out, input, size);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_sub_into(TensorHandle out, TensorHandle tensor, const Real* input, size_t size) {
+    TENSOR_PROFILE_OP("sub", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->sub_into(*out, input, size);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_mul_into(TensorHandle out, TensorHandle tensor, const Real* input, size_t size) {
+    TENSOR_PROFILE_OP("mul", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->mul_into(*out, input, size);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_div_into(TensorHandle out, TensorHandle tensor, bool no_nan, const Real* input, size_t size) {
+    TENSOR_PROFILE_OP("div", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->div_into(*out, no_nan, input, size);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_maximum_into(TensorHandle out, TensorHandle tensor, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("maximum", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->maximum_into(*out, input, input_size);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_minimum_into(TensorHandle out, TensorHandle tensor, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("minimum", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->minimum_into(*out, input, input_size);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_mod_into(TensorHandle out, TensorHandle tensor, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("mod", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->mod_into(*out, input, input_size);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_pow_into(TensorHandle out, TensorHandle tensor, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("pow", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->pow_into(*out, input, input_size);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_squared_diff_into(TensorHandle out, TensorHandle tensor, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("squared_diff", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->squared_diff_into(*out, input, input_size);
+    }
+    return out->data->data();
   }
 }
@@ -1,62 +1,373 @@
-#include "../Tensor.h"
-
-Tensor Tensor::abs() const { return math_op(std::abs); }
-Tensor Tensor::acos() const { return math_op(std::acos); }
-Tensor Tensor::acosh() const { return math_op(std::acosh); }
-Tensor Tensor::asin() const { return math_op(std::asin); }
-Tensor Tensor::asinh() const { return math_op(std::asinh); }
-Tensor Tensor::atan() const { return math_op(std::atan); }
-Tensor Tensor::atan2(const Real* input, size_t input_size) const {
-  return Tensor::broadcast_op(input, input_size,
+#include "../FastMath.h"
+
+namespace fastmath {
+  static MATH_MODE global_mode = MATH_PRECISE;
+
+  MATH_MODE resolve(int mode) {
+    return mode < 0 ? global_mode : static_cast<MATH_MODE>(mode);
+  }
+
+  MATH_MODE get_mode() {
+    return global_mode;
+  }
+
+  void set_mode(MATH_MODE mode) {
+    global_mode = mode;
+  }
+}
+
+Tensor Tensor::abs() const { return apply_math_op([](Real x) { return std::abs(x); }); }
+void Tensor::abs_into(Tensor& dst) const { apply_math_op_into(dst, [](Real x) { return std::abs(x); }); }
+Tensor Tensor::acos() const { return apply_math_op([](Real x) { return std::acos(x); }); }
+void Tensor::acos_into(Tensor& dst) const { apply_math_op_into(dst, [](Real x) { return std::acos(x); }); }
+Tensor Tensor::acosh() const { return apply_math_op([](Real x) { return std::acosh(x); }); }
+void Tensor::acosh_into(Tensor& dst) const { apply_math_op_into(dst, [](Real x) { return std::acosh(x); }); }
+Tensor Tensor::asin() const { return apply_math_op([](Real x) { return std::asin(x); }); }
+void Tensor::asin_into(Tensor& dst) const { apply_math_op_into(dst, [](Real x) { return std::asin(x); }); }
+Tensor Tensor::asinh() const { return apply_math_op([](Real x) { return std::asinh(x); }); }
+void Tensor::asinh_into(Tensor& dst) const { apply_math_op_into(dst, [](Real x) { return std::asinh(x); }); }
+Tensor Tensor::atan(MATH_MODE mode) const {
+  Tensor result(rows, cols, is1d);
+  atan_into(result, mode);
+  return result;
+}
+void Tensor::atan_into(Tensor& dst, MATH_MODE mode) const {
+  if (mode == MATH_FAST) {
+    apply_math_op_into(dst, [](Real x) { return fastmath::atan(x); });
+    return;
+  }
+  apply_math_op_into(dst, [](Real x) { return std::atan(x); });
+}
+Tensor Tensor::atan2(const Real* input, size_t input_size, MATH_MODE mode) const {
+  Tensor result(rows, cols, is1d);
+  atan2_into(result, input, input_size, mode);
+  return result;
+}
+void Tensor::atan2_into(Tensor& dst, const Real* input, size_t input_size, MATH_MODE mode) const {
+  if (mode == MATH_FAST) {
+    broadcast_op_into(dst, input, input_size,
+        [](Real a, Real b) { return fastmath::atan2(a, b); });
+    return;
+  }
+  broadcast_op_into(dst, input, input_size,
       [](Real a, Real b) { return std::atan2(a,b); });
 }
-Tensor Tensor::atanh() const { return math_op(std::atanh); }
-Tensor Tensor::ceil() const { return math_op(std::ceil); }
+Tensor Tensor::atanh() const { return apply_math_op([](Real x) { return std::atanh(x); }); }
+void Tensor::atanh_into(Tensor& dst) const { apply_math_op_into(dst, [](Real x) { return std::atanh(x); }); }
+Tensor Tensor::ceil() const { return apply_math_op([](Real x) { return std::ceil(x); }); }
+void Tensor::ceil_into(Tensor& dst) const { apply_math_op_into(dst, [](Real x) { return std::ceil(x); }); }
 Tensor Tensor::clip(const Real lower, const Real upper) const {
-  Tensor result = deepcopy();
-  auto& vec = (*result.data);
-  for (auto& elem : vec) {
-    if (elem > upper) {
-      elem = upper;
-    } else if (elem < lower) {
-      elem = lower;
-    }
+  Tensor result(rows, cols, is1d);
+  clip_into(result, lower, upper);
+  return result;
+}
+void Tensor::clip_into(Tensor& dst, const Real lower, const Real upper) const {
+  apply_math_op_into(dst, [lower, upper](Real x) { return x > upper ? upper : (x < lower ? lower : x); });
+}
+Tensor Tensor::cos(MATH_MODE mode) const {
+  Tensor result(rows, cols, is1d);
+  cos_into(result, mode);
+  return result;
+}
+void Tensor::cos_into(Tensor& dst, MATH_MODE mode) const {
+  if (mode == MATH_FAST) {
+    apply_math_op_into(dst, [](Real x) { return fastmath::cos(x); });
+    return;
   }
+  apply_math_op_into(dst, [](Real x) { return std::cos(x); });
+}
+Tensor Tensor::cosh() const { return apply_math_op([](Real x) { return std::cosh(x); }); }
+void Tensor::cosh_into(Tensor& dst) const { apply_math_op_into(dst, [](Real x) { return std::cosh(x); }); }
+Tensor Tensor::exp(MATH_MODE mode) const {
+  Tensor result(rows, cols, is1d);
+  exp_into(result, mode);
   return result;
 }
-Tensor Tensor::cos() const { return math_op(std::cos); }
-Tensor Tensor::cosh() const { return math_op(std::cosh); }
-Tensor Tensor::floor() const { return math_op(std::floor); }
-
-// Square
-Tensor Tensor::square() const {/*{{{*/
-  Tensor result = deepcopy();
-  auto& vec = (*result.data);
-  for (auto& elem : vec) {
-    elem *= elem;
+void Tensor::exp_into(Tensor& dst, MATH_MODE mode) const {
+  if (mode == MATH_FAST) {
+    apply_math_op_into(dst, [](Real x) { return fastmath::exp(x); });
+    return;
   }
+  apply_math_op_into(dst, [](Real x) { return std::exp(x); });
+}
+Tensor Tensor::floor() const { return apply_math_op([](Real x) { return std::floor(x); }); }
+void Tensor::floor_into(Tensor& dst) const { apply_math_op_into(dst, [](Real x) { return std::floor(x); }); }
+Tensor Tensor::log(MATH_MODE mode) const {
+  Tensor result(rows, cols, is1d);
+  log_into(result, mode);
   return result;
-}/*}}}*/
+}
+void Tensor::log_into(Tensor& dst, MATH_MODE mode) const {
+  if (mode == MATH_FAST) {
+    apply_math_op_into(dst, [](Real x) { return fastmath::log(x); });
+    return;
+  }
+  apply_math_op_into(dst, [](Real x) { return std::log(x); });
+}
+Tensor Tensor::sigmoid(MATH_MODE mode) const {
+  Tensor result(rows, cols, is1d);
+  sigmoid_into(result, mode);
+  return result;
+}
+void Tensor::sigmoid_into(Tensor& dst, MATH_MODE mode) const {
+  if (mode == MATH_FAST) {
+    apply_math_op_into(dst, [](Real x) { return fastmath::sigmoid(x); });
+    return;
+  }
+  apply_math_op_into(dst, [](Real x) { return Real(1) / (Real(1) + std::exp(-x)); });
+}
+Tensor Tensor::sin(MATH_MODE mode) const {
+  Tensor result(rows, cols, is1d);
+  sin_into(result, mode);
+  return result;
+}
+void Tensor::sin_into(Tensor& dst, MATH_MODE mode) const {
+  if (mode == MATH_FAST) {
+    apply_math_op_into(dst, [](Real x) { return fastmath::sin(x); });
+    return;
+  }
+  apply_math_op_into(dst, [](Real x) { return std::sin(x); });
+}
+Tensor Tensor::tanh(MATH_MODE mode) const {
+  Tensor result(rows, cols, is1d);
+  tanh_into(result, mode);
+  return result;
+}
+void Tensor::tanh_into(Tensor& dst, MATH_MODE mode) const {
+  if (mode == MATH_FAST) {
+    apply_math_op_into(dst, [](Real x) { return fastmath::tanh(x); });
+    return;
+  }
+  apply_math_op_into(dst, [](Real x) { return std::tanh(x); });
+}
+
+// Square
+Tensor Tensor::square() const {
+  return apply_math_op([](Real x) { return x * x; });
+}
+void Tensor::square_into(Tensor& dst) const { apply_math_op_into(dst, [](Real x) { return x * x; }); }
 
 extern "C" {
 
-  Tensor* tensor_abs(Tensor* tensor) { return new Tensor(tensor->abs()); }
-  Tensor* tensor_acos(Tensor* tensor) { return new Tensor(tensor->acos()); }
-  Tensor* tensor_acosh(Tensor* tensor) { return new Tensor(tensor->acosh()); }
-  Tensor* tensor_asin(Tensor* tensor) { return new Tensor(tensor->asin()); }
-  Tensor* tensor_asinh(Tensor* tensor) { return new Tensor(tensor->asinh()); }
-  Tensor* tensor_atan(Tensor* tensor) { return new Tensor(tensor->atan()); }
-  Tensor* tensor_atan2(Tensor* tensor, const Real* input, size_t input_size) {
-    return new Tensor(tensor->atan2(input, input_size));
-  }
-  Tensor* tensor_atanh(Tensor* tensor) { return new Tensor(tensor->atanh()); }
-  Tensor* tensor_ceil(Tensor* tensor) { return new Tensor(tensor->ceil()); }
-  Tensor* tensor_clip(Tensor* tensor, const Real lower, const Real upper) {
-    return new Tensor(tensor->clip(lower, upper));
-  }
-  Tensor* tensor_cos(Tensor* tensor) { return new Tensor(tensor->cos()); }
-  Tensor* tensor_cosh(Tensor* tensor) { return new Tensor(tensor->cosh()); }
-  Tensor* tensor_floor(Tensor* tensor) { return new Tensor(tensor->floor()); }
-
-  Tensor* tensor_square(Tensor* tensor) { return new Tensor(tensor->square()); }
+  TensorHandle tensor_abs(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("abs", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->abs());
+  }
+  TensorHandle tensor_acos(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("acos", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->acos());
+  }
+  TensorHandle tensor_acosh(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("acosh", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->acosh());
+  }
+  TensorHandle tensor_asin(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("asin", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->asin());
+  }
+  TensorHandle tensor_asinh(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("asinh", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->asinh());
+  }
+  // `mode`: 0 precise, 1 fast, -1 the global mode
+  TensorHandle tensor_atan(TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("atan", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->atan(fastmath::resolve(mode)));
+  }
+  TensorHandle tensor_atan2(TensorHandle tensor, const Real* input, size_t input_size, int mode) {
+    TENSOR_PROFILE_OP("atan2", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->atan2(input, input_size, fastmath::resolve(mode)));
+  }
+  TensorHandle tensor_atanh(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("atanh", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->atanh());
+  }
+  TensorHandle tensor_ceil(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("ceil", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->ceil());
+  }
+  TensorHandle tensor_clip(TensorHandle tensor, const Real lower, const Real upper) {
+    TENSOR_PROFILE_OP("clip", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->clip(lower, upper));
+  }
+  TensorHandle tensor_cos(TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("cos", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->cos(fastmath::resolve(mode)));
+  }
+  TensorHandle tensor_cosh(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("cosh", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->cosh());
+  }
+  TensorHandle tensor_exp(TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("exp", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->exp(fastmath::resolve(mode)));
+  }
+  TensorHandle tensor_floor(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("floor", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->floor());
+  }
+  TensorHandle tensor_log(TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("log", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->log(fastmath::resolve(mode)));
+  }
+  TensorHandle tensor_sigmoid(TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("sigmoid", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->sigmoid(fastmath::resolve(mode)));
+  }
+  TensorHandle tensor_sin(TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("sin", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->sin(fastmath::resolve(mode)));
+  }
+
+  TensorHandle tensor_square(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("square", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->square());
+  }
+  TensorHandle tensor_tanh(TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("tanh", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->tanh(fastmath::resolve(mode)));
+  }
+
+  // `*_into` write into `out` (same shape as `tensor`) and return its data
+  Real* tensor_abs_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("abs", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->abs_into(*out);
+    }
+    return out->data->data();
+  }
+  Real* tensor_acos_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("acos", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->acos_into(*out);
+    }
+    return out->data->data();
+  }
+  Real* tensor_acosh_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("acosh", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->acosh_into(*out);
+    }
+    return out->data->data();
+  }
+  Real* tensor_asin_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("asin", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->asin_into(*out);
+    }
+    return out->data->data();
+  }
+  Real* tensor_asinh_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("asinh", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->asinh_into(*out);
+    }
+    return out->data->data();
+  }
+  Real* tensor_atan_into(TensorHandle out, TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("atan", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->atan_into(*out, fastmath::resolve(mode));
+    }
+    return out->data->data();
+  }
+  Real* tensor_atan2_into(TensorHandle out, TensorHandle tensor, const Real* input, size_t input_size, int mode) {
+    TENSOR_PROFILE_OP("atan2", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->atan2_into(*out, input, input_size, fastmath::resolve(mode));
+    }
+    return out->data->data();
+  }
+  Real* tensor_atanh_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("atanh", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->atanh_into(*out);
+    }
+    return out->data->data();
+  }
+  Real* tensor_ceil_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("ceil", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->ceil_into(*out);
+    }
+    return out->data->data();
+  }
+  Real* tensor_clip_into(TensorHandle out, TensorHandle tensor, const Real lower, const Real upper) {
+    TENSOR_PROFILE_OP("clip", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->clip_into(*out, lower, upper);
+    }
+    return out->data->data();
+  }
+  Real* tensor_cos_into(TensorHandle out, TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("cos", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->cos_into(*out, fastmath::resolve(mode));
+    }
+    return out->data->data();
+  }
+  Real* tensor_cosh_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("cosh", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->cosh_into(*out);
+    }
+    return out->data->data();
+  }
+  Real* tensor_exp_into(TensorHandle out, TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("exp", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->exp_into(*out, fastmath::resolve(mode));
+    }
+    return out->data->data();
+  }
+  Real* tensor_floor_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("floor", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->floor_into(*out);
+    }
+    return out->data->data();
+  }
+  Real* tensor_log_into(TensorHandle out, TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("log", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->log_into(*out, fastmath::resolve(mode));
+    }
+    return out->data->data();
+  }
+  Real* tensor_sigmoid_into(TensorHandle out, TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("sigmoid", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->sigmoid_into(*out, fastmath::resolve(mode));
+    }
+    return out->data->data();
+  }
+  Real* tensor_sin_into(TensorHandle out, TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("sin", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->sin_into(*out, fastmath::resolve(mode));
+    }
+    return out->data->data();
+  }
+  Real* tensor_square_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("square", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->square_into(*out);
+    }
+    return out->data->data();
+  }
+  Real* tensor_tanh_into(TensorHandle out, TensorHandle tensor, int mode) {
+    TENSOR_PROFILE_OP("tanh", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->tanh_into(*out, fastmath::resolve(mode));
+    }
+    return out->data->data();
+  }
+
+  // 0 precise, 1 fast, used by ops called with mode -1
+  void tensor_set_math_mode(int mode) {
+    fastmath::set_mode(mode == MATH_FAST ? MATH_FAST : MATH_PRECISE);
+  }
+  int tensor_get_math_mode() {
+    return fastmath::get_mode();
+  }
 }
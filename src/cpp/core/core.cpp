@@ -17,24 +17,43 @@ void update_shape_wire(Tensor* tensor, int* shape_wire) {/*{{{*/
 
 Tensor::Tensor(size_t rows, size_t cols, bool is1d) 
   : rows(rows), cols(cols), is1d(is1d),
-  data(std::make_shared<std::vector<float>>(rows * cols, 0.0f)) { }
+  data(memory::make_buffer(Buffer(rows * cols, 0.0f), rows, cols)) {
+  memory::tensor_created();
+  TENSOR_PROFILE_ALLOC(rows * cols * sizeof(Real));
+}
 
 // Allow data pointer to be shared without copying
 // this is benneficial for when we just need a reference and know
 // that operations will be changing the underlying data structure
-Tensor::Tensor(size_t rows, size_t cols, bool is1d, std::shared_ptr<std::vector<Real>> shared_data_ptr)
+Tensor::Tensor(size_t rows, size_t cols, bool is1d, std::shared_ptr<Buffer> shared_data_ptr)
   : rows(rows), cols(cols), is1d(is1d),
-  data(std::move(shared_data_ptr)) {}
+  data(std::move(shared_data_ptr)) {
+  memory::tensor_created();
+}
 
 // Transfer a temporary data vec to the new tensor class, avoiding a copy
-Tensor::Tensor(size_t rows, size_t cols, bool is1d, std::vector<Real> tmp_data)
+Tensor::Tensor(size_t rows, size_t cols, bool is1d, Buffer tmp_data)
   : rows(rows), cols(cols), is1d(is1d),
-  data(std::make_shared<std::vector<Real>>(std::move(tmp_data))) {}
+  data(memory::make_buffer(std::move(tmp_data), rows, cols)) {
+  memory::tensor_created();
+  TENSOR_PROFILE_ALLOC(data->size() * sizeof(Real));
+}
 
 // create a deep copy of the tensor, dereferncing the shared data pointer
 Tensor::Tensor(const Tensor& other)
   : rows(other.rows), cols(other.cols), is1d(other.is1d),
-  data(std::make_shared<std::vector<float>>(*other.data)) {}
+  data(memory::make_buffer(Buffer(*other.data), rows, cols)) {
+  memory::tensor_created();
+  TENSOR_PROFILE_ALLOC(data->size() * sizeof(Real));
+}
+
+// takes over the buffer, the moved-from tensor keeps its shape but no data
+// and is only fit to be destroyed
+Tensor::Tensor(Tensor&& other)
+  : rows(other.rows), cols(other.cols), is1d(other.is1d),
+  data(std::move(other.data)) {
+  memory::tensor_created();
+}
 
   /*
 // Allow data to be copied directly on initialization, useful
@@ -46,7 +65,9 @@ Tensor::Tensor(size_t rows, size_t cols, bool is1d, std::shared_ptr<std::vector<
 
   */
 
-Tensor::~Tensor() {}
+Tensor::~Tensor() {
+  memory::tensor_destroyed();
+}
 
 // helper function to create a copy
 Tensor Tensor::deepcopy() const {
@@ -54,19 +75,42 @@ Tensor Tensor::deepcopy() const {
 }
 
 // Provide read-only access
-const std::vector<Real>& Tensor::data_ref() const {
+const Buffer& Tensor::data_ref() const {
   return *data;
 }
 
 // Provide read-write access
-std::vector<Real>& Tensor::data_ref() {
+Buffer& Tensor::data_ref() {
   return *data;
 }
 
-Tensor Tensor::math_op(float (*math_func)(float)) const {
-  return apply_math_op(math_func);
+void Tensor::ensure_unique() {
+  if (data.use_count() > 1) {
+    data = memory::make_buffer(Buffer(*data), rows, cols);
+    TENSOR_PROFILE_ALLOC(data->size() * sizeof(Real));
+  }
 }
 
+bool prepare_out(Tensor* out, size_t rows, size_t cols, const Tensor* const* inputs, size_t count) {/*{{{*/
+  if (out->rows != rows || out->cols != cols) {
+    std::string message = "Tensor out: expected shape [" + std::to_string(rows) + "," \
+        + std::to_string(cols) + "], found [" + std::to_string(out->rows) + "," \
+        + std::to_string(out->cols) + "]";
+    report_error(message.c_str());
+    return false;
+  }
+  // checked before copying, a rejected call leaves `out` as it was. Once
+  // `out` has a buffer of its own only the same tensor can alias it.
+  for (size_t i = 0; i < count; ++i) {
+    if (inputs[i] == out) {
+      report_error("Tensor out: this op can't write into its own input");
+      return false;
+    }
+  }
+  out->ensure_unique();
+  return true;
+}/*}}}*/
+
 
 /*
 // Get the value at (row, col)
@@ -106,26 +150,23 @@ Shape Tensor::get_shape() const {/*{{{*/
 
 extern "C" {
   // Create a new Tensor instance
-  Tensor* tensor_create(size_t rows, size_t cols, bool is1d) {
-    return new Tensor(rows, cols, is1d);
+  TensorHandle tensor_create(size_t rows, size_t cols, bool is1d) {
+    return TensorHandle::emplace(rows, cols, is1d);
   }
 
-  // Delete a Tensor instance
-  void tensor_delete(Tensor* tensor) {
-    delete tensor;
-  }
-
-  // Delete a Tensor instance
-  void tensor_batch_delete(const uint32_t* instances, size_t size) {
-    for (size_t i = 0; i < size; ++i) {
-      Tensor* tensor = reinterpret_cast<Tensor*>(instances[i]);
-      if (tensor) {
-        delete tensor;
-      }
+  // Delete a Tensor instance, deleting it twice is reported in debug builds
+  void tensor_delete(TensorHandle tensor) {
+    bool released = handles::release(tensor.id);
+#ifdef TENSOR_DEBUG
+    if (!released && tensor.id) {
+      report_error("Tensor.delete(): stale handle, the tensor was already deleted");
     }
+#else
+    (void)released;
+#endif
   }
 
-  void tensor_get_shape(Tensor* tensor, int* shape) {
+  void tensor_get_shape(TensorHandle tensor, int* shape) {
     Shape s = tensor->get_shape();
     shape[0] = s.rows;
     shape[1] = s.cols;
@@ -133,22 +174,22 @@ extern "C" {
   }
 
   // Get the location of the data
-  const Real* tensor_get_data_ptr(const Tensor* tensor) {
+  const Real* tensor_get_data_ptr(TensorHandle tensor) {
     return tensor->data->data();
   }
 
   // Get the number of rows in the tensor (for convenience)
-  size_t tensor_get_rows(Tensor* tensor) {
+  size_t tensor_get_rows(TensorHandle tensor) {
     return tensor->rows;
   }
 
   // Get the number of columns in the tensor (for convenience)
-  size_t tensor_get_cols(Tensor* tensor) {
+  size_t tensor_get_cols(TensorHandle tensor) {
     return tensor->cols;
   }
 
   // Add bounds computation function
-  void tensor_get_bounds(const Tensor* tensor, Real* bounds) {
+  void tensor_get_bounds(TensorHandle tensor, Real* bounds) {
     Bounds b = tensor->get_bounds();
     bounds[0] = b.xmin;
     bounds[1] = b.ymin;
@@ -1,9 +1,10 @@
-#include "../Tensor.h"
+#include "../Creation.h"
+#include "../FastMath.h"
 
 
 // create identity matrix
 Tensor Tensor::eye() const {/*{{{*/
-  std::vector<Real> eye(rows * cols, 0.0f);
+  Buffer eye(rows * cols, 0.0f);
   for (size_t j = 0; j < cols; ++j) {
     eye[j * cols + j] = 1.0f;
   }
@@ -14,7 +15,7 @@ Tensor Tensor::eye() const {/*{{{*/
 Tensor Tensor::diag() const {/*{{{*/
   const auto& vec = data_ref();
   size_t nrows = vec.size();
-  std::vector<Real> diag(cols * nrows, 0.0f);
+  Buffer diag(cols * nrows, 0.0f);
 
   for (size_t i = 0; i < nrows; ++i) {
     diag[i * cols + i] = vec[i];
@@ -22,18 +23,185 @@ Tensor Tensor::diag() const {/*{{{*/
   return Tensor(nrows, cols, false, std::move(diag));
 }/*}}}*/
 
+namespace creation {
+  // 24 random bits as a float in [0, 1), or (0, 1] for logarithms
+  inline Real unit(uint32_t word) {
+    return static_cast<Real>(word >> 8) * Real(1.0 / 16777216.0);
+  }
+
+  inline Real unit_open(uint32_t word) {
+    return static_cast<Real>((word >> 8) + 1) * Real(1.0 / 16777216.0);
+  }
+
+  constexpr Real TWO_PI = Real(6.283185307179586);
+
+  // Box-Muller, the 4 words of a block give 4 standard normals
+  inline void normals(const uint32_t w[4], Real z[4]) {
+    Real r0 = std::sqrt(-2 * fastmath::log(unit_open(w[0])));
+    Real r1 = std::sqrt(-2 * fastmath::log(unit_open(w[2])));
+    Real t0 = TWO_PI * unit(w[1]);
+    Real t1 = TWO_PI * unit(w[3]);
+    z[0] = r0 * fastmath::cos(t0);
+    z[1] = r0 * fastmath::sin(t0);
+    z[2] = r1 * fastmath::cos(t1);
+    z[3] = r1 * fastmath::sin(t1);
+  }
+
+  Tensor full(size_t rows, size_t cols, bool is1d, Real value) {
+    Tensor result(rows, cols, is1d);
+    std::fill(result.data->begin(), result.data->end(), value);
+    return result;
+  }
+
+  // Bounds stay double so the count matches the JS numbers, e.g.
+  // arange(0, 0.3, 0.1) is 3 values where float bounds give 4
+  Tensor arange(double start, double stop, double step) {/*{{{*/
+    double span = (stop - start) / step;
+    if (step == 0 || !(span > 0)) {
+      report_error("Tensor.arange(): the range is empty, check the sign of step");
+      return Tensor(1, 1, true);
+    }
+    size_t count = static_cast<size_t>(std::ceil(span));
+    // stop is excluded, also once the values are rounded to Real
+    Real limit = static_cast<Real>(stop);
+    while (count > 0) {
+      Real last = static_cast<Real>(start + step * (count - 1));
+      if (step > 0 ? last < limit : last > limit) {
+        break;
+      }
+      count--;
+    }
+    if (count == 0) {
+      report_error("Tensor.arange(): the range is empty, check the sign of step");
+      return Tensor(1, 1, true);
+    }
+    Tensor result(1, count, true);
+    Real* out = result.data->data();
+    // from the start each time rather than accumulating step
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = static_cast<Real>(start + step * i);
+    }
+    return result;
+  }/*}}}*/
+
+  Tensor linspace(Real start, Real stop, size_t num) {/*{{{*/
+    if (num == 0) {
+      report_error("Tensor.linspace(): expects at least one value");
+      return Tensor(1, 1, true);
+    }
+    Tensor result(1, num, true);
+    Real* out = result.data->data();
+    double delta = num > 1 ? (static_cast<double>(stop) - start) / (num - 1) : 0;
+    for (size_t i = 0; i < num; ++i) {
+      out[i] = static_cast<Real>(start + delta * i);
+    }
+    out[num - 1] = num > 1 ? stop : start;
+    return result;
+  }/*}}}*/
+
+  Tensor random(size_t rows, size_t cols, bool is1d, RANDOM_DIST dist, Real a, Real b, Philox& stream) {/*{{{*/
+    Tensor result(rows, cols, is1d);
+    Real* out = result.data->data();
+    size_t size = rows * cols;
+    size_t blocks = (size + 3) / 4;
+    uint64_t base = stream.counter;
+    stream.counter += blocks;
+    // element i always comes from lane i % 4 of block base + i / 4
+    for (size_t i = 0; i < blocks; ++i) {
+      uint32_t w[4];
+      Real z[4];
+      stream.block(base + i, 0, w);
+      if (dist == RANDOM_UNIFORM) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+          z[lane] = a + (b - a) * unit(w[lane]);
+        }
+      } else {
+        normals(w, z);
+      }
+      size_t count = std::min<size_t>(4, size - i * 4);
+      std::copy(z, z + count, out + i * 4);
+    }
+    if (dist == RANDOM_UNIFORM) {
+      return result;
+    }
+    if (dist == RANDOM_TRUNCATED_NORMAL) {
+      // redraws come from further substreams of the same block, so they
+      // stay a function of the element index too
+      for (size_t i = 0; i < size; ++i) {
+        for (uint32_t word = 1; std::abs(out[i]) > 2; ++word) {
+          uint32_t w[4];
+          Real z[4];
+          stream.block(base + i / 4, word, w);
+          normals(w, z);
+          out[i] = z[i % 4];
+        }
+      }
+    }
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = a + b * out[i];
+    }
+    return result;
+  }/*}}}*/
+}
+
+// Stream of the unseeded random bindings, JS seeds it before first use
+static Philox global_stream = {{ 0x243F6A88, 0x85A308D3 }, 0};
+
 extern "C" {
-  Tensor* tensor_clone(Tensor* tensor) {
-    return new Tensor(tensor->rows, tensor->cols, tensor->is1d, tensor->data);
+  TensorHandle tensor_clone(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("clone", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->rows, tensor->cols, tensor->is1d, tensor->data);
+  }
+
+  TensorHandle tensor_eye(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("eye", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->eye());
+  }
+
+  TensorHandle tensor_diag(TensorHandle tensor, int* shape_wire = nullptr) {
+    TENSOR_PROFILE_OP("diag", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->diag());
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
   }
 
-  Tensor* tensor_eye(Tensor* tensor) {
-    return new Tensor(tensor->eye());
+  TensorHandle tensor_fill(size_t rows, size_t cols, bool is1d, Real value) {
+    TENSOR_PROFILE_OP("fill", rows * cols);
+    return TensorHandle::emplace(creation::full(rows, cols, is1d, value));
   }
 
-  Tensor* tensor_diag(Tensor* tensor, int* shape_wire = nullptr) {
-    Tensor* new_tensor = new Tensor(tensor->diag());
+  TensorHandle tensor_arange(double start, double stop, double step, int* shape_wire) {
+    TENSOR_PROFILE_OP("arange", 1);
+    TensorHandle new_tensor = TensorHandle::emplace(creation::arange(start, stop, step));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
+
+  TensorHandle tensor_linspace(Real start, Real stop, size_t num) {
+    TENSOR_PROFILE_OP("linspace", num);
+    return TensorHandle::emplace(creation::linspace(start, stop, num));
+  }
+
+  void tensor_random_seed(uint32_t seed_lo, uint32_t seed_hi) {
+    global_stream = {{ seed_lo, seed_hi }, 0};
+  }
+
+  // `seeded` draws from a fresh stream keyed by the seed instead of the global one
+  TensorHandle tensor_random(
+      size_t rows,
+      size_t cols,
+      bool is1d,
+      int dist,
+      Real a,
+      Real b,
+      bool seeded,
+      uint32_t seed_lo,
+      uint32_t seed_hi
+      ) {
+    TENSOR_PROFILE_OP("random", rows * cols);
+    Philox stream = {{ seed_lo, seed_hi }, 0};
+    return TensorHandle::emplace(creation::random(
+      rows, cols, is1d, static_cast<RANDOM_DIST>(dist), a, b, seeded ? stream : global_stream
+    ));
+  }
 }
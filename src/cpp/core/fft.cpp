@@ -0,0 +1,417 @@
+#include "../FFT.h"
+#include <unordered_map>
+
+namespace fft {
+  size_t next_pow2(size_t n) {
+    size_t size = 1;
+    while (size < n) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  Plan::Plan(size_t n) : n(n) {/*{{{*/
+    const double pi = std::acos(-1.0);
+    table.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+      table[k] = Complex(std::cos(-2.0 * pi * k / n), std::sin(-2.0 * pi * k / n));
+    }
+
+    // radix 4 first, then 2, then odd radices in increasing order
+    size_t remaining = n;
+    size_t radix = 4;
+    bool large = false;
+    while (remaining > 1) {
+      while (remaining % radix) {
+        radix = radix == 4 ? 2 : radix == 2 ? 3 : radix + 2;
+        if (radix * radix > remaining) {
+          radix = remaining;
+        }
+      }
+      remaining /= radix;
+      radices.push_back(radix);
+      radices.push_back(remaining);
+      large = large || radix > GENERIC_RADIX_MAX;
+    }
+
+    if (large) {
+      // X[k] = w[k] sum_j (x[j] w[j]) conj(w[k - j]), w[k] = exp(-pi i k^2 / n),
+      // a circular convolution at a power of two size
+      radices.clear();
+      size_t m = next_pow2(2 * n - 1);
+      padded = plan(m);
+      chirp.resize(n);
+      for (size_t k = 0; k < n; ++k) {
+        // k^2 mod 2n keeps the angle small and exact
+        uint64_t square = static_cast<uint64_t>(k) * k % (2 * n);
+        chirp[k] = Complex(std::cos(-pi * square / n), std::sin(-pi * square / n));
+      }
+      chirp_spectrum.assign(m, Complex(0.0f, 0.0f));
+      chirp_spectrum[0] = std::conj(chirp[0]);
+      for (size_t k = 1; k < n; ++k) {
+        chirp_spectrum[k] = chirp_spectrum[m - k] = std::conj(chirp[k]);
+      }
+      padded->transform(chirp_spectrum.data(), chirp_spectrum.data(), false);
+    }
+    if (n >= 2 && n % 2 == 0) {
+      half = plan(n / 2);
+    }
+    memory::object_created(state_bytes());
+  }/*}}}*/
+
+  Plan::~Plan() {
+    memory::object_destroyed(state_bytes());
+  }
+
+  size_t Plan::state_bytes() const {
+    return (table.capacity() + chirp.capacity() + chirp_spectrum.capacity()) * sizeof(Complex) \
+      + radices.capacity() * sizeof(size_t);
+  }
+
+  Complex Plan::twiddle(size_t index, bool inverse) const {
+    return inverse ? std::conj(table[index]) : table[index];
+  }
+
+  // Decimation in time: the `radix` interleaved subsequences are transformed
+  // into consecutive blocks of `m`, then combined by one butterfly pass
+  void Plan::work(Complex* out, const Complex* in, size_t stride, const size_t* radix, bool inverse) const {/*{{{*/
+    size_t p = radix[0];
+    size_t m = radix[1];
+    Complex* begin = out;
+    Complex* end = out + p * m;
+    if (m == 1) {
+      for (; out != end; ++out, in += stride) {
+        *out = *in;
+      }
+    } else {
+      for (; out != end; out += m, in += stride) {
+        work(out, in, stride * p, radix + 2, inverse);
+      }
+    }
+    butterfly(begin, stride, m, p, inverse);
+  }/*}}}*/
+
+  void Plan::butterfly(Complex* out, size_t stride, size_t m, size_t radix, bool inverse) const {/*{{{*/
+    if (radix == 2) {
+      for (size_t k = 0; k < m; ++k) {
+        Complex t = multiply(out[k + m], twiddle(k * stride, inverse));
+        out[k + m] = out[k] - t;
+        out[k] += t;
+      }
+      return;
+    }
+    if (radix == 4) {
+      for (size_t k = 0; k < m; ++k) {
+        Complex s0 = multiply(out[k + m], twiddle(k * stride, inverse));
+        Complex s1 = multiply(out[k + 2 * m], twiddle(2 * k * stride, inverse));
+        Complex s2 = multiply(out[k + 3 * m], twiddle(3 * k * stride, inverse));
+        Complex s5 = out[k] - s1;
+        out[k] += s1;
+        Complex s3 = s0 + s2;
+        Complex s4 = s0 - s2;
+        out[k + 2 * m] = out[k] - s3;
+        out[k] += s3;
+        // s4 rotated by -i (forward) or +i (inverse)
+        Complex rotated = inverse ? Complex(-s4.imag(), s4.real()) : Complex(s4.imag(), -s4.real());
+        out[k + m] = s5 + rotated;
+        out[k + 3 * m] = s5 - rotated;
+      }
+      return;
+    }
+    thread_local std::vector<Complex> scratch;
+    scratch.resize(radix);
+    for (size_t u = 0; u < m; ++u) {
+      for (size_t q = 0; q < radix; ++q) {
+        scratch[q] = out[u + q * m];
+      }
+      for (size_t q = 0; q < radix; ++q) {
+        size_t k = u + q * m;
+        size_t index = 0;
+        Complex sum = scratch[0];
+        for (size_t r = 1; r < radix; ++r) {
+          index += stride * k;
+          if (index >= n) {
+            index -= n;
+          }
+          sum += multiply(scratch[r], twiddle(index, inverse));
+        }
+        out[k] = sum;
+      }
+    }
+  }/*}}}*/
+
+  void Plan::bluestein(const Complex* in, Complex* out, bool inverse) const {/*{{{*/
+    // the inverse transform is conj(forward(conj(x))) / n
+    size_t m = padded->size();
+    thread_local std::vector<Complex> buffer;
+    buffer.assign(m, Complex(0.0f, 0.0f));
+    for (size_t k = 0; k < n; ++k) {
+      buffer[k] = multiply(inverse ? std::conj(in[k]) : in[k], chirp[k]);
+    }
+    padded->transform(buffer.data(), buffer.data(), false);
+    for (size_t k = 0; k < m; ++k) {
+      buffer[k] = multiply(buffer[k], chirp_spectrum[k]);
+    }
+    padded->transform(buffer.data(), buffer.data(), true);
+    Real scale = 1.0f / n;
+    for (size_t k = 0; k < n; ++k) {
+      Complex value = multiply(buffer[k], chirp[k]);
+      out[k] = inverse ? std::conj(value) * scale : value;
+    }
+  }/*}}}*/
+
+  void Plan::transform(const Complex* in, Complex* out, bool inverse) const {/*{{{*/
+    if (n <= 1) {
+      if (n) {
+        out[0] = in[0];
+      }
+      return;
+    }
+    if (!chirp.empty()) {
+      bluestein(in, out, inverse);
+      return;
+    }
+    if (in == out) {
+      thread_local std::vector<Complex> copy;
+      copy.assign(in, in + n);
+      in = copy.data();
+    }
+    work(out, in, 1, radices.data(), inverse);
+    if (inverse) {
+      Real scale = 1.0f / n;
+      for (size_t k = 0; k < n; ++k) {
+        out[k] *= scale;
+      }
+    }
+  }/*}}}*/
+
+  // Even sizes pack the samples into n/2 complex points (even samples real,
+  // odd samples imaginary), transform at half size and untangle the halves
+  void Plan::forward_real(const Real* in, Complex* out) const {/*{{{*/
+    if (n % 2) {
+      thread_local std::vector<Complex> full;
+      full.assign(in, in + n);
+      transform(full.data(), full.data(), false);
+      std::copy(full.begin(), full.begin() + n / 2 + 1, out);
+      return;
+    }
+    size_t h = n / 2;
+    thread_local std::vector<Complex> packed;
+    packed.resize(h);
+    for (size_t k = 0; k < h; ++k) {
+      packed[k] = Complex(in[2 * k], in[2 * k + 1]);
+    }
+    half->transform(packed.data(), packed.data(), false);
+    for (size_t k = 0; k < h; ++k) {
+      Complex z = packed[k];
+      Complex mirror = std::conj(packed[(h - k) % h]);
+      Complex even = (z + mirror) * Real(0.5f);
+      Complex odd = multiply(z - mirror, Complex(0.0f, -0.5f));
+      out[k] = even + multiply(table[k], odd);
+    }
+    out[h] = Complex(packed[0].real() - packed[0].imag(), 0.0f);
+  }/*}}}*/
+
+  void Plan::inverse_real(const Complex* in, Real* out) const {/*{{{*/
+    if (n % 2) {
+      thread_local std::vector<Complex> full;
+      full.resize(n);
+      for (size_t k = 0; k <= n / 2; ++k) {
+        full[k] = in[k];
+        if (k) {
+          full[n - k] = std::conj(in[k]);
+        }
+      }
+      transform(full.data(), full.data(), true);
+      for (size_t k = 0; k < n; ++k) {
+        out[k] = full[k].real();
+      }
+      return;
+    }
+    size_t h = n / 2;
+    thread_local std::vector<Complex> packed;
+    packed.resize(h);
+    for (size_t k = 0; k < h; ++k) {
+      Complex x = in[k];
+      Complex mirror = std::conj(in[h - k]);
+      Complex even = (x + mirror) * Real(0.5f);
+      Complex odd = multiply((x - mirror) * Real(0.5f), std::conj(table[k]));
+      packed[k] = even + Complex(-odd.imag(), odd.real());
+    }
+    half->transform(packed.data(), packed.data(), true);
+    for (size_t k = 0; k < h; ++k) {
+      out[2 * k] = packed[k].real();
+      out[2 * k + 1] = packed[k].imag();
+    }
+  }/*}}}*/
+
+  static std::unordered_map<size_t, std::shared_ptr<const Plan>> plans;
+
+  std::shared_ptr<const Plan> plan(size_t n) {
+    auto found = plans.find(n);
+    if (found != plans.end()) {
+      return found->second;
+    }
+    auto created = std::make_shared<const Plan>(n);
+    if (plans.size() >= PLAN_CACHE_MAX) {
+      plans.clear();
+    }
+    plans.emplace(n, created);
+    return created;
+  }
+
+  void clear_plans() {
+    plans.clear();
+  }
+}
+
+namespace {
+  size_t values_per_bin(FFT_FORMAT format) {
+    return format == FFT_MAGNITUDE ? 1 : 2;
+  }
+
+  void write_bins(const fft::Complex* bins, size_t count, FFT_FORMAT format, Real* out, size_t stride) {
+    for (size_t i = 0; i < count; ++i) {
+      if (format == FFT_MAGNITUDE) {
+        out[i * stride] = std::abs(bins[i]);
+      } else if (format == FFT_POLAR) {
+        out[2 * i * stride] = std::abs(bins[i]);
+        out[(2 * i + 1) * stride] = std::arg(bins[i]);
+      } else {
+        out[2 * i * stride] = bins[i].real();
+        out[(2 * i + 1) * stride] = bins[i].imag();
+      }
+    }
+  }
+}
+
+// Real transform of every row (axis 1) or column (axis 0), the n / 2 + 1
+// non-negative frequency bins are written along the same axis
+Tensor Tensor::rfft(int axis, FFT_FORMAT format) const {/*{{{*/
+  bool along_rows = is1d || axis == 1;
+  size_t length = along_rows ? cols : rows;
+  size_t lanes = along_rows ? rows : cols;
+  size_t bins = length / 2 + 1;
+  size_t width = bins * values_per_bin(format);
+  Tensor result(along_rows ? rows : width, along_rows ? width : cols, is1d);
+  if (!length) {
+    report_error("rfft: the transformed axis must not be empty");
+    return result;
+  }
+
+  auto plan = fft::plan(length);
+  std::vector<Real> lane(along_rows ? 0 : length);
+  std::vector<fft::Complex> spectrum(bins);
+  const Real* src = data_ref().data();
+  Real* out = result.data->data();
+  for (size_t index = 0; index < lanes; ++index) {
+    if (along_rows) {
+      plan->forward_real(src + index * cols, spectrum.data());
+      write_bins(spectrum.data(), bins, format, out + index * width, 1);
+    } else {
+      for (size_t i = 0; i < length; ++i) {
+        lane[i] = src[i * cols + index];
+      }
+      plan->forward_real(lane.data(), spectrum.data());
+      write_bins(spectrum.data(), bins, format, out + index, cols);
+    }
+  }
+  return result;
+}/*}}}*/
+
+// Inverse of rfft, the axis holds n / 2 + 1 interleaved bins, `n` = 0
+// assumes an even length signal
+Tensor Tensor::irfft(size_t n, int axis) const {/*{{{*/
+  bool along_rows = is1d || axis == 1;
+  size_t width = along_rows ? cols : rows;
+  size_t lanes = along_rows ? rows : cols;
+  size_t bins = width / 2;
+  if (!n && bins) {
+    n = 2 * (bins - 1);
+  }
+  Tensor result(along_rows ? rows : n, along_rows ? n : cols, is1d);
+  if (width % 2 || !n || bins != n / 2 + 1) {
+    std::string message = "irfft: expected " + std::to_string(n / 2 + 1) \
+                           + " interleaved (re, im) bins along the axis, got " + std::to_string(width) + " values";
+    report_error(message.c_str());
+    return result;
+  }
+
+  auto plan = fft::plan(n);
+  std::vector<fft::Complex> spectrum(bins);
+  std::vector<Real> lane(n);
+  const Real* src = data_ref().data();
+  Real* out = result.data->data();
+  size_t stride = along_rows ? 1 : cols;
+  for (size_t index = 0; index < lanes; ++index) {
+    const Real* base = src + (along_rows ? index * width : index);
+    for (size_t i = 0; i < bins; ++i) {
+      spectrum[i] = fft::Complex(base[2 * i * stride], base[(2 * i + 1) * stride]);
+    }
+    plan->inverse_real(spectrum.data(), along_rows ? out + index * n : lane.data());
+    if (!along_rows) {
+      for (size_t i = 0; i < n; ++i) {
+        out[i * cols + index] = lane[i];
+      }
+    }
+  }
+  return result;
+}/*}}}*/
+
+// Complex transform along an axis of interleaved (re, im) pairs
+Tensor Tensor::fft(int axis, bool inverse, FFT_FORMAT format) const {/*{{{*/
+  bool along_rows = is1d || axis == 1;
+  size_t width = along_rows ? cols : rows;
+  size_t lanes = along_rows ? rows : cols;
+  size_t points = width / 2;
+  size_t out_width = points * values_per_bin(format);
+  Tensor result(along_rows ? rows : out_width, along_rows ? out_width : cols, is1d);
+  if (width % 2) {
+    report_error("fft: expects interleaved (re, im) pairs, the axis length must be even");
+    return result;
+  }
+
+  auto plan = fft::plan(points);
+  std::vector<fft::Complex> lane(points);
+  const Real* src = data_ref().data();
+  Real* out = result.data->data();
+  size_t stride = along_rows ? 1 : cols;
+  for (size_t index = 0; index < lanes; ++index) {
+    const Real* base = src + (along_rows ? index * width : index);
+    for (size_t i = 0; i < points; ++i) {
+      lane[i] = fft::Complex(base[2 * i * stride], base[(2 * i + 1) * stride]);
+    }
+    plan->transform(lane.data(), lane.data(), inverse);
+    write_bins(lane.data(), points, format, out + (along_rows ? index * out_width : index), stride);
+  }
+  return result;
+}/*}}}*/
+
+extern "C" {
+  // `format`: 0 complex, 1 polar, 2 magnitude
+  TensorHandle tensor_rfft(TensorHandle tensor, int axis, int format, int* shape_wire) {
+    TENSOR_PROFILE_OP("rfft", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->rfft(axis, static_cast<FFT_FORMAT>(format)));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  TensorHandle tensor_irfft(TensorHandle tensor, size_t n, int axis, int* shape_wire) {
+    TENSOR_PROFILE_OP("irfft", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->irfft(n, axis));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  TensorHandle tensor_fft(TensorHandle tensor, int axis, bool inverse, int format, int* shape_wire) {
+    TENSOR_PROFILE_OP("fft", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->fft(axis, inverse, static_cast<FFT_FORMAT>(format)));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  // Drop the cached plans, plans in use are released once done
+  void tensor_fft_clear_plans() {
+    fft::clear_plans();
+  }
+}
@@ -0,0 +1,286 @@
+#include "../Filter.h"
+#include "../FFT.h"
+
+namespace filter {
+  static void correlate_direct(const Real* signal, size_t count, const Real* kernel, size_t size, Real* out) {/*{{{*/
+    std::fill(out, out + count, 0.0f);
+    // kernel taps outermost, the inner loop is a contiguous axpy that vectorizes
+    for (size_t j = 0; j < size; ++j) {
+      Real tap = kernel[j];
+      const Real* shifted = signal + j;
+      for (size_t i = 0; i < count; ++i) {
+        out[i] += tap * shifted[i];
+      }
+    }
+  }/*}}}*/
+
+  // Add a block's full convolution (starting at signal index `start`) into the
+  // correlation output, full index start + i lands on out[start + i - (size - 1)]
+  static void overlap_add(const fft::Complex* block, size_t start, size_t take, size_t size, size_t count,
+      bool imaginary, Real* out) {
+    size_t first = start < size - 1 ? size - 1 - start : 0;
+    size_t last = std::min(take + size - 1, count + size - 1 - start);
+    for (size_t i = first; i < last; ++i) {
+      out[start + i - (size - 1)] += imaginary ? block[i].imag() : block[i].real();
+    }
+  }
+
+  std::vector<fft::Complex> kernel_spectrum(const Real* kernel, size_t size) {/*{{{*/
+    if (size < FFT_KERNEL_MIN) {
+      return {};
+    }
+    // correlating with `kernel` is convolving with it reversed
+    std::vector<fft::Complex> spectrum(fft::next_pow2(4 * size));
+    for (size_t j = 0; j < size; ++j) {
+      spectrum[j] = kernel[size - 1 - j];
+    }
+    fft::plan(spectrum.size())->transform(spectrum.data(), spectrum.data(), false);
+    return spectrum;
+  }/*}}}*/
+
+  // Overlap-add against the kernel's precomputed spectrum
+  static void correlate_fft(const Real* signal, size_t length, size_t size,
+      const std::vector<fft::Complex>& spectrum, Real* out) {/*{{{*/
+    size_t count = length - size + 1;
+    size_t nfft = spectrum.size();
+    size_t block = nfft - size + 1;
+
+    auto plan = fft::plan(nfft);
+    std::fill(out, out + count, 0.0f);
+    std::vector<fft::Complex> buffer(nfft);
+    // the kernel is real, so two blocks ride in one transform: the first in
+    // the real part and the second in the imaginary part
+    for (size_t start = 0; start < length; start += 2 * block) {
+      size_t take = std::min(block, length - start);
+      size_t second = start + block < length ? std::min(block, length - start - block) : 0;
+      std::fill(buffer.begin(), buffer.end(), fft::Complex(0.0f, 0.0f));
+      for (size_t i = 0; i < take; ++i) {
+        buffer[i].real(signal[start + i]);
+      }
+      for (size_t i = 0; i < second; ++i) {
+        buffer[i].imag(signal[start + block + i]);
+      }
+      plan->transform(buffer.data(), buffer.data(), false);
+      for (size_t i = 0; i < nfft; ++i) {
+        buffer[i] = fft::multiply(buffer[i], spectrum[i]);
+      }
+      plan->transform(buffer.data(), buffer.data(), true);
+      overlap_add(buffer.data(), start, take, size, count, false, out);
+      if (second) {
+        overlap_add(buffer.data(), start + block, second, size, count, true, out);
+      }
+    }
+  }/*}}}*/
+
+  void correlate(const Real* signal, size_t length, const Real* kernel, size_t size,
+      const std::vector<fft::Complex>& spectrum, Real* out) {
+    if (!size || length < size) {
+      return;
+    }
+    if (!spectrum.empty() && length >= 2 * size) {
+      correlate_fft(signal, length, size, spectrum, out);
+    } else {
+      correlate_direct(signal, length - size + 1, kernel, size, out);
+    }
+  }
+
+  Tensor moving_average_kernel(size_t window) {
+    if (!window) {
+      report_error("moving_average_kernel: window must be at least 1");
+      return Tensor(1, 0, true);
+    }
+    return Tensor(1, window, true, Buffer(window, 1.0f / window));
+  }
+
+  Tensor savgol_kernel(size_t window, size_t order, size_t deriv) {/*{{{*/
+    if (window % 2 == 0 || order >= window || deriv > order) {
+      report_error("savgol_kernel: expects an odd window, order < window and deriv <= order");
+      return Tensor(1, 0, true);
+    }
+    int half = window / 2;
+    size_t terms = order + 1;
+    // normal equations (A^T A) z = deriv! e_deriv, A[i][j] = x_i^j
+    std::vector<double> system(terms * (terms + 1), 0.0);
+    for (int x = -half; x <= half; ++x) {
+      for (size_t r = 0; r < terms; ++r) {
+        for (size_t c = 0; c < terms; ++c) {
+          system[r * (terms + 1) + c] += std::pow(x, r + c);
+        }
+      }
+    }
+    double factorial = 1.0;
+    for (size_t i = 2; i <= deriv; ++i) {
+      factorial *= i;
+    }
+    system[deriv * (terms + 1) + terms] = factorial;
+
+    // Gauss-Jordan with partial pivoting, the system is tiny
+    for (size_t col = 0; col < terms; ++col) {
+      size_t pivot = col;
+      for (size_t r = col + 1; r < terms; ++r) {
+        if (std::abs(system[r * (terms + 1) + col]) > std::abs(system[pivot * (terms + 1) + col])) {
+          pivot = r;
+        }
+      }
+      for (size_t c = 0; c <= terms; ++c) {
+        std::swap(system[col * (terms + 1) + c], system[pivot * (terms + 1) + c]);
+      }
+      for (size_t r = 0; r < terms; ++r) {
+        if (r == col) {
+          continue;
+        }
+        double factor = system[r * (terms + 1) + col] / system[col * (terms + 1) + col];
+        for (size_t c = col; c <= terms; ++c) {
+          system[r * (terms + 1) + c] -= factor * system[col * (terms + 1) + c];
+        }
+      }
+    }
+
+    // coefficient for offset x is sum_j x^j z_j, reversed so it convolves
+    Buffer kernel(window);
+    for (int x = -half; x <= half; ++x) {
+      double coefficient = 0.0;
+      for (size_t j = 0; j < terms; ++j) {
+        double z = system[j * (terms + 1) + terms] / system[j * (terms + 1) + j];
+        coefficient += std::pow(x, j) * z;
+      }
+      kernel[half - x] = static_cast<Real>(coefficient);
+    }
+    return Tensor(1, window, true, std::move(kernel));
+  }/*}}}*/
+}
+
+// 1d convolution of every row (axis 1) or column (axis 0) with `kernel`,
+// zero padded at the edges, `mode` picks the full, same or valid window
+Tensor Tensor::conv1d(const Real* kernel, size_t kernel_size, int axis, CONV_MODE mode) const {/*{{{*/
+  bool along_rows = is1d || axis == 1;
+  size_t length = along_rows ? cols : rows;
+  size_t lanes = along_rows ? rows : cols;
+  size_t pad = kernel_size ? kernel_size - 1 : 0;
+
+  size_t start = 0;
+  size_t count = length + pad;
+  if (mode == CONV_SAME) {
+    start = pad / 2;
+    count = length;
+  } else if (mode == CONV_VALID) {
+    start = pad;
+    count = length >= kernel_size ? length - pad : 0;
+  }
+  Tensor result(along_rows ? rows : count, along_rows ? count : cols, is1d);
+  if (!kernel_size || (mode == CONV_VALID && length < kernel_size)) {
+    report_error("conv1d: kernel must not be empty or longer than the signal in valid mode");
+    return result;
+  }
+
+  std::vector<Real> reversed(kernel, kernel + kernel_size);
+  std::reverse(reversed.begin(), reversed.end());
+  auto spectrum = filter::kernel_spectrum(reversed.data(), kernel_size);
+  // zero padded lane, only the part the requested window reads
+  std::vector<Real> padded(length + 2 * pad, 0.0f);
+  std::vector<Real> lane_out(count);
+  const auto& vec = data_ref();
+  auto& out = (*result.data);
+
+  for (size_t lane = 0; lane < lanes; ++lane) {
+    for (size_t i = 0; i < length; ++i) {
+      padded[pad + i] = along_rows ? vec[lane * cols + i] : vec[i * cols + lane];
+    }
+    filter::correlate(padded.data() + start, count + pad, reversed.data(), kernel_size, spectrum, lane_out.data());
+    for (size_t i = 0; i < count; ++i) {
+      if (along_rows) {
+        out[lane * count + i] = lane_out[i];
+      } else {
+        out[i * cols + lane] = lane_out[i];
+      }
+    }
+  }
+  return result;
+}/*}}}*/
+
+FIRFilter::FIRFilter(const Real* kernel, size_t size, size_t channels)
+  : channels(channels), reversed(kernel, kernel + size), history(channels * (size ? size - 1 : 0), 0.0f) {
+  std::reverse(reversed.begin(), reversed.end());
+  spectrum = filter::kernel_spectrum(reversed.data(), size);
+  memory::object_created(state_bytes());
+}
+
+FIRFilter::~FIRFilter() {
+  memory::object_destroyed(state_bytes());
+}
+
+size_t FIRFilter::state_bytes() const {
+  return (reversed.capacity() + history.capacity() + scratch.capacity() + filtered.capacity()) * sizeof(Real) \
+    + spectrum.capacity() * sizeof(fft::Complex);
+}
+
+void FIRFilter::reset() {
+  std::fill(history.begin(), history.end(), 0.0f);
+}
+
+void FIRFilter::process(Real* frame, size_t samples) {/*{{{*/
+  size_t size = reversed.size();
+  if (!size || !samples) {
+    return;
+  }
+  size_t keep = size - 1;
+  size_t old_bytes = state_bytes();
+  scratch.resize(keep + samples);
+  filtered.resize(samples);
+  memory::object_resized(old_bytes, state_bytes());
+
+  for (size_t channel = 0; channel < channels; ++channel) {
+    Real* past = history.data() + channel * keep;
+    std::copy(past, past + keep, scratch.begin());
+    for (size_t t = 0; t < samples; ++t) {
+      scratch[keep + t] = frame[t * channels + channel];
+    }
+    filter::correlate(scratch.data(), keep + samples, reversed.data(), size, spectrum, filtered.data());
+    for (size_t t = 0; t < samples; ++t) {
+      frame[t * channels + channel] = filtered[t];
+    }
+    std::copy(scratch.end() - keep, scratch.end(), past);
+  }
+}/*}}}*/
+
+extern "C" {
+  // `mode`: 0 full, 1 same, 2 valid
+  TensorHandle tensor_conv1d(
+      TensorHandle tensor,
+      const Real* kernel,
+      size_t kernel_size,
+      int axis,
+      int mode,
+      int* shape_wire
+      ) {
+    TENSOR_PROFILE_OP("conv1d", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->conv1d(kernel, kernel_size, axis, static_cast<CONV_MODE>(mode)));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  TensorHandle tensor_moving_average_kernel(size_t window) {
+    return TensorHandle::emplace(filter::moving_average_kernel(window));
+  }
+
+  TensorHandle tensor_savgol_kernel(size_t window, size_t order, size_t deriv) {
+    return TensorHandle::emplace(filter::savgol_kernel(window, order, deriv));
+  }
+
+  FIRFilter* fir_create(const Real* kernel, size_t size, size_t channels) {
+    return new FIRFilter(kernel, size, channels);
+  }
+
+  void fir_delete(FIRFilter* fir) {
+    delete fir;
+  }
+
+  void fir_reset(FIRFilter* fir) {
+    fir->reset();
+  }
+
+  void fir_process(FIRFilter* fir, Real* frame, size_t samples) {
+    TENSOR_PROFILE_OP("fir_process", samples);
+    fir->process(frame, samples);
+  }
+}
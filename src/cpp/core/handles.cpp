@@ -0,0 +1,136 @@
+#include <deque>
+#include "../Tensor.h"
+
+namespace handles {
+  // Slots are allocated a chunk at a time so they never move
+  constexpr size_t CHUNK_SLOTS = 1024;
+
+  struct Slot {
+    alignas(Tensor) unsigned char storage[sizeof(Tensor)];
+    uint32_t generation;
+    bool live;
+  };
+
+  static std::vector<std::unique_ptr<Slot[]>> chunks;
+  static size_t slot_count = 0;
+  // FIFO, a freed slot waits behind every other free slot before it is
+  // reused, so its generation advances slowly
+  static std::deque<uint32_t> free_slots;
+  // handles created while a scope is open, `scope_starts` marks where each
+  // open scope begins, innermost last
+  static std::vector<uint32_t> scoped;
+  static std::vector<size_t> scope_starts;
+
+  static Slot& slot_at(uint32_t index) {
+    return chunks[index / CHUNK_SLOTS][index % CHUNK_SLOTS];
+  }
+
+  static Tensor* tensor_at(Slot& slot) {
+    return std::launder(reinterpret_cast<Tensor*>(slot.storage));
+  }
+
+  // Slot of a handle when it is live and of the current generation
+  static Slot* find(uint32_t handle) {
+    uint32_t index = handle & INDEX_MASK;
+    if (handle == 0 || index >= slot_count) {
+      return nullptr;
+    }
+    Slot& slot = slot_at(index);
+    return slot.live && slot.generation == handle >> INDEX_BITS ? &slot : nullptr;
+  }
+
+  Tensor* resolve(uint32_t handle) {
+    if (handle == 0) {
+      return nullptr;
+    }
+    Slot* slot = find(handle);
+    if (!slot) {
+      report_error("Tensor: stale handle, the tensor was deleted");
+      return nullptr;
+    }
+    return tensor_at(*slot);
+  }
+
+  void* reserve(uint32_t& handle) {/*{{{*/
+    if (free_slots.empty()) {
+      if (slot_count > INDEX_MASK) {
+        report_error("Tensor: out of tensor handles");
+      }
+      if (slot_count == chunks.size() * CHUNK_SLOTS) {
+        chunks.emplace_back(new Slot[CHUNK_SLOTS]);
+      }
+      // generations start at 1, so no handle is 0
+      Slot& slot = slot_at(slot_count);
+      slot.generation = 1;
+      slot.live = false;
+      free_slots.push_back(slot_count++);
+    }
+    uint32_t index = free_slots.front();
+    Slot& slot = slot_at(index);
+    handle = slot.generation << INDEX_BITS | index;
+    return slot.storage;
+  }/*}}}*/
+
+  void commit(uint32_t handle) {
+    free_slots.pop_front();
+    slot_at(handle & INDEX_MASK).live = true;
+    if (!scope_starts.empty()) {
+      scoped.push_back(handle);
+    }
+  }
+
+  bool release(uint32_t handle) {/*{{{*/
+    Slot* slot = find(handle);
+    if (!slot) {
+      return false;
+    }
+    tensor_at(*slot)->~Tensor();
+    slot->live = false;
+    // wrap past MAX_GENERATION, skipping 0 so no handle is 0. A stale handle
+    // only matches again after its slot went through the FIFO MAX_GENERATION
+    // more times
+    slot->generation = slot->generation == MAX_GENERATION ? 1 : slot->generation + 1;
+    free_slots.push_back(handle & INDEX_MASK);
+    return true;
+  }/*}}}*/
+
+  void begin_scope() {
+    scope_starts.push_back(scoped.size());
+  }
+
+  size_t end_scope(uint32_t keep) {/*{{{*/
+    if (scope_starts.empty()) {
+      report_error("Tensor: no scope to end");
+      return 0;
+    }
+    size_t start = scope_starts.back();
+    scope_starts.pop_back();
+    size_t released = 0;
+    bool kept = false;
+    for (size_t i = start; i < scoped.size(); ++i) {
+      uint32_t handle = scoped[i];
+      // handles deleted during the scope are stale and skipped
+      if (handle == keep) {
+        kept = true;
+      } else if (release(handle)) {
+        released++;
+      }
+    }
+    scoped.resize(start);
+    // the kept tensor now belongs to the enclosing scope
+    if (kept && !scope_starts.empty()) {
+      scoped.push_back(keep);
+    }
+    return released;
+  }/*}}}*/
+}
+
+extern "C" {
+  void tensor_scope_begin() {
+    handles::begin_scope();
+  }
+
+  size_t tensor_scope_end(TensorHandle keep) {
+    return handles::end_scope(keep.id);
+  }
+}
@@ -4,8 +4,16 @@
  * q - process noise - A smaller value will average movement more
  * r - measurement noise - Gives weight to the current observation, higher means smoother
  */
-KalmanFilter::KalmanFilter(Real q, Real r) : q(q), r(r) {} 
-KalmanFilter::~KalmanFilter(){}
+KalmanFilter::KalmanFilter(Real q, Real r) : q(q), r(r) {
+  memory::object_created(state_bytes());
+}
+KalmanFilter::~KalmanFilter() {
+  memory::object_destroyed(state_bytes());
+}
+
+size_t KalmanFilter::state_bytes() const {
+  return (state.capacity() + covariance.capacity()) * sizeof(Real);
+}
 
 void KalmanFilter::reset() {
   initialized = false;
@@ -19,8 +27,10 @@ void KalmanFilter::update(Real* observation, size_t size, Real q_temp, Real r_te
 
   // Initialize states if this is the first frame
   if (!initialized) {
+    size_t old_bytes = state_bytes();
     state.resize(size, 0.0f);
     covariance.resize(size, 1.0f);
+    memory::object_resized(old_bytes, state_bytes());
     for (size_t i = 0; i < size; ++i) {
       state[i] = observation[i];
     }
@@ -43,6 +53,137 @@ void KalmanFilter::update(Real* observation, size_t size, Real q_temp, Real r_te
   }
 }
 
+// Restart streams [start, start + count), clamped to the frame
+static void unprime(std::vector<Real>& primed, size_t start, size_t count) {/*{{{*/
+  if (start >= primed.size()) {
+    return;
+  }
+  size_t end = start + std::min(count, primed.size() - start);
+  std::fill(primed.begin() + start, primed.begin() + end, 0.0f);
+}/*}}}*/
+
+constexpr Real TWO_PI = 6.283185307179586f;
+
+// Smoothing factor of a first order low pass at `cutoff` Hz
+static inline Real low_pass_alpha(Real cutoff, Real dt) {
+  Real tau = 1 / (TWO_PI * cutoff);
+  return 1 / (1 + tau / dt);
+}
+
+OneEuroFilter::OneEuroFilter(Real min_cutoff, Real beta, Real d_cutoff)
+  : min_cutoff(min_cutoff), beta(beta), d_cutoff(d_cutoff) {
+  memory::object_created(state_bytes());
+}
+
+OneEuroFilter::~OneEuroFilter() {
+  memory::object_destroyed(state_bytes());
+}
+
+size_t OneEuroFilter::state_bytes() const {
+  return (value.capacity() + derivative.capacity() + primed.capacity()) * sizeof(Real);
+}
+
+// A frame of another size keeps the common streams, new ones start unprimed
+void OneEuroFilter::resize(size_t size) {/*{{{*/
+  size_t old_bytes = state_bytes();
+  value.resize(size, 0.0f);
+  derivative.resize(size, 0.0f);
+  primed.resize(size, 0.0f);
+  memory::object_resized(old_bytes, state_bytes());
+}/*}}}*/
+
+void OneEuroFilter::reset(size_t start, size_t count) {
+  unprime(primed, start, count);
+}
+
+void OneEuroFilter::update(Real* observation, size_t size, Real dt) {/*{{{*/
+  if (!(dt > 0)) {
+    report_error("OneEuroFilter: dt must be positive");
+    return;
+  }
+  if (size != value.size()) {
+    resize(size);
+  }
+  Real d_alpha = low_pass_alpha(d_cutoff, dt);
+  Real rate = TWO_PI * dt;
+  Real* x_hat = value.data();
+  Real* dx_hat = derivative.data();
+  Real* ready = primed.data();
+  // branch free, unprimed streams take the observation as is. Selects
+  // rather than blends by `primed`, so a NaN left in the state by an earlier
+  // observation doesn't survive a reset (0 * NaN is NaN).
+  for (size_t i = 0; i < size; ++i) {
+    Real x = observation[i];
+    bool p = ready[i] != 0;
+    Real dx = (x - x_hat[i]) / dt;
+    Real edx = dx_hat[i] + d_alpha * (dx - dx_hat[i]);
+    Real cutoff = min_cutoff + beta * std::abs(edx);
+    // low_pass_alpha(cutoff, dt) without the double division
+    Real alpha = rate * cutoff / (1 + rate * cutoff);
+    Real filtered = x_hat[i] + alpha * (x - x_hat[i]);
+    x_hat[i] = p ? filtered : x;
+    dx_hat[i] = p ? edx : 0.0f;
+    ready[i] = 1.0f;
+    observation[i] = x_hat[i];
+  }
+}/*}}}*/
+
+ExponentialSmoothing::ExponentialSmoothing(Real alpha, Real beta) : alpha(alpha), beta(beta) {
+  memory::object_created(state_bytes());
+}
+
+ExponentialSmoothing::~ExponentialSmoothing() {
+  memory::object_destroyed(state_bytes());
+}
+
+size_t ExponentialSmoothing::state_bytes() const {
+  return (level.capacity() + trend.capacity() + primed.capacity()) * sizeof(Real);
+}
+
+void ExponentialSmoothing::resize(size_t size) {/*{{{*/
+  size_t old_bytes = state_bytes();
+  level.resize(size, 0.0f);
+  trend.resize(size, 0.0f);
+  primed.resize(size, 0.0f);
+  memory::object_resized(old_bytes, state_bytes());
+}/*}}}*/
+
+void ExponentialSmoothing::reset(size_t start, size_t count) {
+  unprime(primed, start, count);
+}
+
+void ExponentialSmoothing::update(Real* observation, size_t size) {/*{{{*/
+  if (size != level.size()) {
+    resize(size);
+  }
+  Real* l = level.data();
+  Real* b = trend.data();
+  Real* ready = primed.data();
+  if (beta < 0) {
+    for (size_t i = 0; i < size; ++i) {
+      Real x = observation[i];
+      bool p = ready[i] != 0;
+      Real smoothed = l[i] + alpha * (x - l[i]);
+      l[i] = p ? smoothed : x;
+      ready[i] = 1.0f;
+      observation[i] = l[i];
+    }
+    return;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    Real x = observation[i];
+    bool p = ready[i] != 0;
+    Real forecast = l[i] + b[i];
+    Real next = forecast + alpha * (x - forecast);
+    Real slope = b[i] + beta * (next - l[i] - b[i]);
+    // a fresh stream starts at the observation with no trend
+    l[i] = p ? next : x;
+    b[i] = p ? slope : 0.0f;
+    ready[i] = 1.0f;
+    observation[i] = l[i];
+  }
+}/*}}}*/
+
 extern "C" {
 
   KalmanFilter* kalman_create(Real q, Real r) {
@@ -58,7 +199,43 @@ extern "C" {
   }
 
   void kalman_update(KalmanFilter* kalman, Real* observation, size_t size, const Real q_temp, const Real r_temp) {
+    TENSOR_PROFILE_OP("kalman_update", size);
     kalman->update(observation, size, q_temp, r_temp);
   }
 
+  OneEuroFilter* one_euro_create(Real min_cutoff, Real beta, Real d_cutoff) {
+    return new OneEuroFilter(min_cutoff, beta, d_cutoff);
+  }
+
+  void one_euro_delete(OneEuroFilter* filter) {
+    delete filter;
+  }
+
+  void one_euro_reset(OneEuroFilter* filter, size_t start, size_t count) {
+    filter->reset(start, count);
+  }
+
+  void one_euro_update(OneEuroFilter* filter, Real* observation, size_t size, Real dt) {
+    TENSOR_PROFILE_OP("one_euro_update", size);
+    filter->update(observation, size, dt);
+  }
+
+  // `beta` < 0 for single smoothing
+  ExponentialSmoothing* exp_smoothing_create(Real alpha, Real beta) {
+    return new ExponentialSmoothing(alpha, beta);
+  }
+
+  void exp_smoothing_delete(ExponentialSmoothing* smoothing) {
+    delete smoothing;
+  }
+
+  void exp_smoothing_reset(ExponentialSmoothing* smoothing, size_t start, size_t count) {
+    smoothing->reset(start, count);
+  }
+
+  void exp_smoothing_update(ExponentialSmoothing* smoothing, Real* observation, size_t size) {
+    TENSOR_PROFILE_OP("exp_smoothing_update", size);
+    smoothing->update(observation, size);
+  }
+
 }
@@ -1,4 +1,4 @@
-#include "../Tensor.h"
+#include "../Linalg.h"
 
 // QR decomposition
 Tensor Tensor::qr(Tensor* Q) const {/*{{{*/
@@ -62,7 +62,332 @@ Tensor Tensor::qr(Tensor* Q) const {/*{{{*/
   return R;
 }/*}}}*/
 
+namespace linalg {
+  void givens(Real a, Real b, Real& c, Real& s, Real& r) {/*{{{*/
+    if (b == 0) {
+      c = 1;
+      s = 0;
+      r = a;
+      return;
+    }
+    r = std::hypot(a, b);
+    c = a / r;
+    s = b / r;
+  }/*}}}*/
+
+  void add_row(Real* R, size_t n, size_t cols, Real* x) {/*{{{*/
+    for (size_t k = 0; k < n; ++k) {
+      if (x[k] == 0) {
+        continue;
+      }
+      Real* row = R + k * cols;
+      Real c, s, r;
+      givens(row[k], x[k], c, s, r);
+      row[k] = r;
+      x[k] = 0;
+      for (size_t j = k + 1; j < cols; ++j) {
+        Real a = row[j];
+        Real b = x[j];
+        row[j] = c * a + s * b;
+        x[j] = c * b - s * a;
+      }
+    }
+  }/*}}}*/
+
+  bool remove_row(Real* R, size_t n, size_t cols, Real* x) {/*{{{*/
+    for (size_t k = 0; k < n; ++k) {
+      if (x[k] == 0) {
+        continue;
+      }
+      Real* row = R + k * cols;
+      if (row[k] < 0) {
+        // flipping a row of R leaves RᵀR as is
+        for (size_t j = k; j < cols; ++j) {
+          row[j] = -row[j];
+        }
+      }
+      Real a = row[k];
+      Real r2 = (a - x[k]) * (a + x[k]);
+      if (!(r2 > 0)) {
+        return false;
+      }
+      Real r = std::sqrt(r2);
+      // the mixed form of the hyperbolic rotation, c = cosh, s = sinh * c
+      Real c = r / a;
+      Real s = x[k] / a;
+      row[k] = r;
+      x[k] = 0;
+      for (size_t j = k + 1; j < cols; ++j) {
+        row[j] = (row[j] - s * x[j]) / c;
+        x[j] = c * x[j] - s * row[j];
+      }
+    }
+    return true;
+  }/*}}}*/
+
+  void back_substitute(const Real* R, size_t n, size_t stride, const Real* b, Real* x) {/*{{{*/
+    for (size_t i = n; i-- > 0;) {
+      const Real* row = R + i * stride;
+      Real sum = b[i];
+      for (size_t j = i + 1; j < n; ++j) {
+        sum -= row[j] * x[j];
+      }
+      x[i] = row[i] != 0 ? sum / row[i] : 0;
+    }
+  }/*}}}*/
+}
+
+// Rotate rows `i` and `i + 1` of `R` (cols wide) and the same columns of
+// the m x m `Q`, so Q R is unchanged
+static void rotate_pair(Real* R, size_t cols, Real* Q, size_t m, size_t i, Real c, Real s) {/*{{{*/
+  Real* top = R + i * cols;
+  Real* bottom = top + cols;
+  for (size_t j = 0; j < cols; ++j) {
+    Real a = top[j];
+    Real b = bottom[j];
+    top[j] = c * a + s * b;
+    bottom[j] = c * b - s * a;
+  }
+  for (size_t k = 0; k < m; ++k) {
+    Real* q = Q + k * m + i;
+    Real a = q[0];
+    Real b = q[1];
+    q[0] = c * a + s * b;
+    q[1] = c * b - s * a;
+  }
+}/*}}}*/
+
+// Golub & Van Loan 6.5.1: rotate w = Qᵀu down to its first entry, which
+// turns R into upper Hessenberg, add w[0] vᵀ to the first row and rotate
+// the subdiagonal away again. O(m² + mn) against O(mn²) for a new QR.
+Tensor Tensor::qr_update(Tensor* Q, const Real* u, size_t u_size, const Real* v, size_t v_size) const {/*{{{*/
+  size_t m = rows;
+  if (Q->rows != m || Q->cols != m || u_size != m || v_size != cols) {
+    report_error("Tensor.qrUpdate(): expects Q of m x m, R of m x n, u of m and v of n values");
+    return deepcopy();
+  }
+  // Q usually arrives as a clone sharing the caller's buffer, rotate a copy
+  Q->ensure_unique();
+  Tensor R = deepcopy();
+  Real* r = R.data->data();
+  Real* q = Q->data->data();
+
+  std::vector<Real> w(m, 0.0f);
+  for (size_t i = 0; i < m; ++i) {
+    const Real* q_row = q + i * m;
+    for (size_t j = 0; j < m; ++j) {
+      w[j] += q_row[j] * u[i];
+    }
+  }
+  for (size_t i = m; i-- > 1;) {
+    Real c, s, norm;
+    linalg::givens(w[i - 1], w[i], c, s, norm);
+    w[i - 1] = norm;
+    w[i] = 0;
+    rotate_pair(r, cols, q, m, i - 1, c, s);
+  }
+  for (size_t j = 0; j < cols; ++j) {
+    r[j] += w[0] * v[j];
+  }
+  for (size_t i = 0; i + 1 < m && i < cols; ++i) {
+    Real c, s, norm;
+    linalg::givens(r[i * cols + i], r[(i + 1) * cols + i], c, s, norm);
+    rotate_pair(r, cols, q, m, i, c, s);
+    r[(i + 1) * cols + i] = 0;
+  }
+  return R;
+}/*}}}*/
+
+Tensor Tensor::cholesky() const {/*{{{*/
+  if (rows != cols) {
+    report_error("Tensor.cholesky(): expects a square matrix");
+    return deepcopy();
+  }
+  size_t n = rows;
+  Tensor L(n, n, false);
+  const Real* a = data_ref().data();
+  Real* l = L.data->data();
+  for (size_t j = 0; j < n; ++j) {
+    const Real* l_j = l + j * n;
+    Real diag = a[j * n + j];
+    for (size_t k = 0; k < j; ++k) {
+      diag -= l_j[k] * l_j[k];
+    }
+    if (!(diag > 0)) {
+      report_error("Tensor.cholesky(): the matrix is not positive definite");
+      return L;
+    }
+    Real pivot = std::sqrt(diag);
+    l[j * n + j] = pivot;
+    for (size_t i = j + 1; i < n; ++i) {
+      const Real* l_i = l + i * n;
+      Real sum = a[i * n + j];
+      for (size_t k = 0; k < j; ++k) {
+        sum -= l_i[k] * l_j[k];
+      }
+      l[i * n + j] = sum / pivot;
+    }
+  }
+  return L;
+}/*}}}*/
+
+Tensor Tensor::cholesky_update(const Real* x, size_t size, bool downdate) const {/*{{{*/
+  if (rows != cols || size != rows) {
+    report_error("Tensor.choleskyUpdate(): expects a square L and a vector of its size");
+    return deepcopy();
+  }
+  size_t n = rows;
+  // Lᵀ is the upper triangular R the row kernels work on
+  Tensor R = transpose();
+  std::vector<Real> scratch(x, x + n);
+  Real* r = R.data->data();
+  if (downdate) {
+    if (!linalg::remove_row(r, n, n, scratch.data())) {
+      report_error("Tensor.choleskyUpdate(): the downdated matrix is not positive definite");
+      return deepcopy();
+    }
+  } else {
+    linalg::add_row(r, n, n, scratch.data());
+  }
+  // back to lower with a positive diagonal
+  for (size_t k = 0; k < n; ++k) {
+    if (r[k * n + k] < 0) {
+      for (size_t j = k; j < n; ++j) {
+        r[k * n + j] = -r[k * n + j];
+      }
+    }
+  }
+  return R.transpose();
+}/*}}}*/
+
+RecursiveLeastSquares::RecursiveLeastSquares(size_t features, Real forgetting, Real regularization)
+  : n(features), forgetting(forgetting), regularization(regularization),
+  factor(features * (features + 1)), scratch(features + 1) {
+  reset();
+  memory::object_created(state_bytes());
+}
+
+RecursiveLeastSquares::~RecursiveLeastSquares() {
+  memory::object_destroyed(state_bytes());
+}
+
+size_t RecursiveLeastSquares::state_bytes() const {
+  return (factor.capacity() + scratch.capacity()) * sizeof(Real);
+}
+
+// The prior R = sqrt(regularization) I keeps early solves well posed (ridge)
+void RecursiveLeastSquares::reset() {/*{{{*/
+  std::fill(factor.begin(), factor.end(), 0.0f);
+  Real prior = std::sqrt(regularization);
+  for (size_t i = 0; i < n; ++i) {
+    factor[i * (n + 1) + i] = prior;
+  }
+}/*}}}*/
+
+void RecursiveLeastSquares::update(const Real* x, const Real* y, size_t rows) {/*{{{*/
+  size_t cols = n + 1;
+  Real decay = std::sqrt(forgetting);
+  for (size_t i = 0; i < rows; ++i) {
+    if (forgetting != 1) {
+      for (size_t k = 0; k < n; ++k) {
+        Real* row = factor.data() + k * cols;
+        for (size_t j = k; j < cols; ++j) {
+          row[j] *= decay;
+        }
+      }
+    }
+    std::copy(x + i * n, x + (i + 1) * n, scratch.begin());
+    scratch[n] = y[i];
+    linalg::add_row(factor.data(), n, cols, scratch.data());
+  }
+}/*}}}*/
+
+bool RecursiveLeastSquares::downdate(const Real* x, const Real* y, size_t rows) {/*{{{*/
+  // rows decay by an amount that depends on their age, which isn't known here
+  if (forgetting != 1) {
+    report_error("RecursiveLeastSquares.downdate(): needs a forgetting of 1, older rows have decayed");
+    return false;
+  }
+  std::vector<Real> saved = factor;
+  for (size_t i = 0; i < rows; ++i) {
+    std::copy(x + i * n, x + (i + 1) * n, scratch.begin());
+    scratch[n] = y[i];
+    if (!linalg::remove_row(factor.data(), n, n + 1, scratch.data())) {
+      factor = std::move(saved);
+      return false;
+    }
+  }
+  return true;
+}/*}}}*/
+
+void RecursiveLeastSquares::weights(Real* out) const {/*{{{*/
+  std::vector<Real> z(n);
+  for (size_t i = 0; i < n; ++i) {
+    z[i] = factor[i * (n + 1) + n];
+  }
+  linalg::back_substitute(factor.data(), n, n + 1, z.data(), out);
+}/*}}}*/
+
+Real RecursiveLeastSquares::predict(const Real* x) const {/*{{{*/
+  std::vector<Real> w(n);
+  weights(w.data());
+  Real sum = 0;
+  for (size_t i = 0; i < n; ++i) {
+    sum += w[i] * x[i];
+  }
+  return sum;
+}/*}}}*/
 
 extern "C" {
-  Tensor* tensor_qr(Tensor* tensor, Tensor* Q) { return new Tensor(tensor->qr(Q)); }
+  TensorHandle tensor_qr(TensorHandle tensor, TensorHandle Q) {
+    TENSOR_PROFILE_OP("qr", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->qr(Q));
+  }
+
+  // `Q` is rotated in place, the updated R is returned
+  TensorHandle tensor_qr_update(TensorHandle R, TensorHandle Q, const Real* u, size_t u_size, const Real* v, size_t v_size) {
+    TENSOR_PROFILE_OP("qr_update", Q->rows * Q->cols);
+    return TensorHandle::emplace(R->qr_update(Q, u, u_size, v, v_size));
+  }
+
+  TensorHandle tensor_cholesky(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("cholesky", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->cholesky());
+  }
+
+  TensorHandle tensor_cholesky_update(TensorHandle tensor, const Real* x, size_t size, bool downdate) {
+    TENSOR_PROFILE_OP("cholesky_update", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->cholesky_update(x, size, downdate));
+  }
+
+  RecursiveLeastSquares* rls_create(size_t features, Real forgetting, Real regularization) {
+    return new RecursiveLeastSquares(features, forgetting, regularization);
+  }
+
+  void rls_delete(RecursiveLeastSquares* rls) {
+    delete rls;
+  }
+
+  void rls_reset(RecursiveLeastSquares* rls) {
+    rls->reset();
+  }
+
+  void rls_update(RecursiveLeastSquares* rls, const Real* x, const Real* y, size_t rows) {
+    TENSOR_PROFILE_OP("rls_update", rows);
+    rls->update(x, y, rows);
+  }
+
+  bool rls_downdate(RecursiveLeastSquares* rls, const Real* x, const Real* y, size_t rows) {
+    TENSOR_PROFILE_OP("rls_downdate", rows);
+    return rls->downdate(x, y, rows);
+  }
+
+  // `out` receives a weight per feature
+  void rls_weights(RecursiveLeastSquares* rls, Real* out) {
+    rls->weights(out);
+  }
+
+  Real rls_predict(RecursiveLeastSquares* rls, const Real* x) {
+    return rls->predict(x);
+  }
 }
@@ -0,0 +1,235 @@
+#include "../Tensor.h"
+
+// Elementwise comparison against a scalar, column-wise array, or tensor
+Tensor Tensor::compare(COMPARE_OP op, const Real* input, size_t input_size) const {/*{{{*/
+  Tensor result(rows, cols, is1d);
+  compare_into(result, op, input, input_size);
+  return result;
+}/*}}}*/
+
+void Tensor::compare_into(Tensor& dst, COMPARE_OP op, const Real* input, size_t input_size) const {/*{{{*/
+  // one loop per op, so each compiles to a vector compare and select
+  switch (op) {
+    case CMP_EQUAL:
+      broadcast_op_into(dst, input, input_size, [](Real a, Real b) { return Real(a == b); });
+      break;
+    case CMP_NOT_EQUAL:
+      broadcast_op_into(dst, input, input_size, [](Real a, Real b) { return Real(a != b); });
+      break;
+    case CMP_GREATER:
+      broadcast_op_into(dst, input, input_size, [](Real a, Real b) { return Real(a > b); });
+      break;
+    case CMP_GREATER_EQUAL:
+      broadcast_op_into(dst, input, input_size, [](Real a, Real b) { return Real(a >= b); });
+      break;
+    case CMP_LESS:
+      broadcast_op_into(dst, input, input_size, [](Real a, Real b) { return Real(a < b); });
+      break;
+    case CMP_LESS_EQUAL:
+      broadcast_op_into(dst, input, input_size, [](Real a, Real b) { return Real(a <= b); });
+      break;
+  }
+}/*}}}*/
+
+// Rows of a broadcast input: row i starts at `base + i * step`, a scalar
+// has no rows and is read as `base[0]` everywhere
+struct BroadcastRows {
+  const Real* base;
+  size_t step;
+  bool scalar;
+};
+
+static bool broadcast_rows(const Real* input, size_t input_size, size_t rows, size_t cols,
+    BroadcastRows& view) {/*{{{*/
+  view = { input, 0, input_size == 1 };
+  if (input_size == 1 || input_size == cols) {
+    return true;
+  } else if (input_size == rows * cols) {
+    view.step = cols;
+    return true;
+  }
+  std::string message = "Cannot broadcast input against shape[" \
+      + std::to_string(rows) + "," + std::to_string(cols) + "]";
+  report_error(message.c_str());
+  return false;
+}/*}}}*/
+
+// Hand `func` a reader (row, col) -> value of the broadcast input. A scalar
+// gets its own instantiation that keeps the value in a register, so nothing
+// is allocated to spread it over a row.
+template <typename Func>
+static void with_broadcast(const BroadcastRows& view, Func func) {/*{{{*/
+  if (view.scalar) {
+    Real value = view.base[0];
+    func([value](size_t, size_t) { return value; });
+  } else {
+    const Real* base = view.base;
+    size_t step = view.step;
+    func([base, step](size_t i, size_t j) { return base[i * step + j]; });
+  }
+}/*}}}*/
+
+// Pick from `a` where this tensor is nonzero and from `b` elsewhere, both
+// broadcast against it
+Tensor Tensor::where(const Real* a, size_t a_size, const Real* b, size_t b_size) const {/*{{{*/
+  Tensor result(rows, cols, is1d);
+  where_into(result, a, a_size, b, b_size);
+  return result;
+}/*}}}*/
+
+void Tensor::where_into(Tensor& dst, const Real* a, size_t a_size, const Real* b, size_t b_size) const {/*{{{*/
+  BroadcastRows a_view;
+  BroadcastRows b_view;
+  if (!broadcast_rows(a, a_size, rows, cols, a_view) || !broadcast_rows(b, b_size, rows, cols, b_view)) {
+    return;
+  }
+  const Real* cond = data_ref().data();
+  Real* out = dst.data->data();
+  with_broadcast(a_view, [&](auto a_at) {
+    with_broadcast(b_view, [&](auto b_at) {
+      for (size_t i = 0; i < rows; ++i) {
+        const Real* c = cond + i * cols;
+        Real* o = out + i * cols;
+        for (size_t j = 0; j < cols; ++j) {
+          o[j] = c[j] != 0 ? a_at(i, j) : b_at(i, j);
+        }
+      }
+    });
+  });
+}/*}}}*/
+
+// Replace values with `value` where the broadcast mask is nonzero
+Tensor Tensor::masked_fill(const Real* mask, size_t mask_size, Real value) const {/*{{{*/
+  Tensor result(rows, cols, is1d);
+  masked_fill_into(result, mask, mask_size, value);
+  return result;
+}/*}}}*/
+
+void Tensor::masked_fill_into(Tensor& dst, const Real* mask, size_t mask_size, Real value) const {/*{{{*/
+  BroadcastRows mask_view;
+  if (!broadcast_rows(mask, mask_size, rows, cols, mask_view)) {
+    return;
+  }
+  const Real* src = data_ref().data();
+  Real* out = dst.data->data();
+  with_broadcast(mask_view, [&](auto mask_at) {
+    for (size_t i = 0; i < rows; ++i) {
+      const Real* x = src + i * cols;
+      Real* o = out + i * cols;
+      for (size_t j = 0; j < cols; ++j) {
+        o[j] = mask_at(i, j) != 0 ? value : x[j];
+      }
+    }
+  });
+}/*}}}*/
+
+// Positions of the nonzero mask values in `kept`, returns how many. Every
+// position is written and the cursor only moves past kept ones, so there is
+// no branch on the mask.
+static size_t compact_indices(const Real* mask, size_t size, std::vector<uint32_t>& kept) {/*{{{*/
+  kept.resize(size + 1);
+  uint32_t* out = kept.data();
+  size_t count = 0;
+  for (size_t i = 0; i < size; ++i) {
+    out[count] = static_cast<uint32_t>(i);
+    count += mask[i] != 0;
+  }
+  return count;
+}/*}}}*/
+
+// Keep the rows (axis 0), columns (axis 1) or values (axis -1, flattened)
+// where the mask is nonzero, densely packed in one pass over the data
+Tensor Tensor::boolean_mask(const Real* mask, size_t mask_size, int axis) const {/*{{{*/
+  size_t expected = axis == 0 ? rows : axis == 1 ? cols : rows * cols;
+  if (axis < -1 || axis > 1 || mask_size != expected) {
+    std::string message = "Tensor.booleanMask(): expected a mask of " \
+        + std::to_string(expected) + " values, found " + std::to_string(mask_size);
+    report_error(message.c_str());
+    return Tensor(0, cols, false);
+  }
+  std::vector<uint32_t> kept;
+  size_t count = compact_indices(mask, mask_size, kept);
+  const Real* src = data_ref().data();
+
+  if (axis == 0) {
+    Tensor result(count, cols, false);
+    Real* out = result.data->data();
+    for (size_t k = 0; k < count; ++k) {
+      std::copy(src + kept[k] * cols, src + (kept[k] + 1) * cols, out + k * cols);
+    }
+    return result;
+  } else if (axis == 1) {
+    Tensor result(rows, count, is1d);
+    Real* out = result.data->data();
+    for (size_t i = 0; i < rows; ++i) {
+      const Real* x = src + i * cols;
+      Real* o = out + i * count;
+      for (size_t k = 0; k < count; ++k) {
+        o[k] = x[kept[k]];
+      }
+    }
+    return result;
+  }
+  Tensor result(1, count, true);
+  Real* out = result.data->data();
+  for (size_t k = 0; k < count; ++k) {
+    out[k] = src[kept[k]];
+  }
+  return result;
+}/*}}}*/
+
+extern "C" {
+  TensorHandle tensor_compare(TensorHandle tensor, int op, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("compare", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->compare(static_cast<COMPARE_OP>(op), input, input_size));
+  }
+
+  TensorHandle tensor_where(TensorHandle cond, const Real* a, size_t a_size, const Real* b, size_t b_size) {
+    TENSOR_PROFILE_OP("where", cond->rows * cond->cols);
+    return TensorHandle::emplace(cond->where(a, a_size, b, b_size));
+  }
+
+  TensorHandle tensor_masked_fill(TensorHandle tensor, const Real* mask, size_t mask_size, Real value) {
+    TENSOR_PROFILE_OP("masked_fill", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->masked_fill(mask, mask_size, value));
+  }
+
+  TensorHandle tensor_boolean_mask(
+      TensorHandle tensor,
+      const Real* mask,
+      size_t mask_size,
+      int axis = -1,
+      int* shape_wire = nullptr
+      ) {
+
+    TENSOR_PROFILE_OP("boolean_mask", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->boolean_mask(mask, mask_size, axis));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  // `*_into` write into `out` (same shape as `tensor`) and return its data
+  Real* tensor_compare_into(TensorHandle out, TensorHandle tensor, int op, const Real* input, size_t input_size) {
+    TENSOR_PROFILE_OP("compare", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->compare_into(*out, static_cast<COMPARE_OP>(op), input, input_size);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_where_into(TensorHandle out, TensorHandle cond, const Real* a, size_t a_size, const Real* b, size_t b_size) {
+    TENSOR_PROFILE_OP("where", cond->rows * cond->cols);
+    if (prepare_out(out, cond->rows, cond->cols)) {
+      cond->where_into(*out, a, a_size, b, b_size);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_masked_fill_into(TensorHandle out, TensorHandle tensor, const Real* mask, size_t mask_size, Real value) {
+    TENSOR_PROFILE_OP("masked_fill", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols)) {
+      tensor->masked_fill_into(*out, mask, mask_size, value);
+    }
+    return out->data->data();
+  }
+}
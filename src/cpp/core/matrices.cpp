@@ -1,24 +1,27 @@
 #include "../Tensor.h"
+#include "../FixedMatrix.h"
 
 // Transpose
 Tensor Tensor::transpose() const {/*{{{*/
   // swap dimensions
   Tensor result(cols, rows, is1d);
-  const auto& cur_data = data_ref();
-  auto& vec = (*result.data);
+  transpose_into(result);
+  return result;
+}/*}}}*/
 
-  // Perform transpose
+void Tensor::transpose_into(Tensor& dst) const {/*{{{*/
+  const auto& cur_data = data_ref();
+  auto& vec = (*dst.data);
   for (size_t i = 0; i < rows; ++i) {
     for (size_t j = 0; j < cols; ++j) {
       vec[j * rows + i] = cur_data[i * cols + j];
     }
   }
-  return result;
 }/*}}}*/
 
 // Norm
 Tensor Tensor::norm(NORM_ORD ord, int axis, bool keepdims) const {/*{{{*/
-  std::vector<Real> norms;
+  Buffer norms;
   const auto& vec = data_ref();
   const Real lowest = std::numeric_limits<Real>::lowest();
   size_t nrows = rows;
@@ -112,31 +115,68 @@ Tensor Tensor::norm(NORM_ORD ord, int axis, bool keepdims) const {/*{{{*/
 }/*}}}*/
 
 // Tensor Multiplication
+// Every row of `a` against a K x C matrix kept in registers
+template <size_t K, size_t C>
+static void matmul_fixed(const Real* a, size_t rows, const Real* b, Real* out) {
+  const auto mat = fixed::Mat<K, C>::load(b);
+  for (size_t i = 0; i < rows; ++i) {
+    (fixed::Vec<K>::load(a + i * K) * mat).store(out + i * C);
+  }
+}
+
+template <size_t K>
+static bool matmul_fixed_cols(const Real* a, size_t rows, const Real* b, size_t cols, Real* out) {
+  switch (cols) {
+    case 2: matmul_fixed<K, 2>(a, rows, b, out); return true;
+    case 3: matmul_fixed<K, 3>(a, rows, b, out); return true;
+    case 4: matmul_fixed<K, 4>(a, rows, b, out); return true;
+  }
+  return false;
+}
+
+// Unrolled kernels when the right hand side is 2x2 up to 4x4 (any number
+// of rows on the left), returns false for other shapes
+static bool matmul_small(const Real* a, size_t rows, size_t inner, const Real* b, size_t cols, Real* out) {
+  switch (inner) {
+    case 2: return matmul_fixed_cols<2>(a, rows, b, cols, out);
+    case 3: return matmul_fixed_cols<3>(a, rows, b, cols, out);
+    case 4: return matmul_fixed_cols<4>(a, rows, b, cols, out);
+  }
+  return false;
+}
+
 Tensor Tensor::matmul(const Tensor& other) const {/*{{{*/
   // Validate shapes for multiplication
   if (cols != other.rows) {
     report_error("Tensor shapes are incompatible for multiplication");
   }
 
-  // Determine the shape of the result
-  size_t result_rows = rows;
-  size_t result_cols = other.cols;
-
   // Allocate space for the result
-  Tensor result(result_rows, other.cols, is1d);
+  Tensor result(rows, other.cols, is1d);
+  matmul_into(result, other);
+  return result;
+}/*}}}*/
+
+void Tensor::matmul_into(Tensor& dst, const Tensor& other) const {/*{{{*/
+  size_t result_cols = other.cols;
   const auto& cur_data = data_ref();
   const auto& other_data = (*other.data);
-  auto& vec = (*result.data);
+  auto& vec = (*dst.data);
+
+  if (matmul_small(cur_data.data(), rows, cols, other_data.data(), other.cols, vec.data())) {
+    return;
+  }
 
   // Perform tensor multiplication
-  for (size_t i = 0; i < result_rows; ++i) {
+  for (size_t i = 0; i < rows; ++i) {
     for (size_t j = 0; j < result_cols; ++j) {
+      Real sum = 0;
       for (size_t k = 0; k < cols; ++k) { // `cols` of `this` is equal to `other.rows`
-        vec[i * result_cols + j] += cur_data[i * cols + k] * other_data[k * other.cols + j];
+        sum += cur_data[i * cols + k] * other_data[k * other.cols + j];
       }
+      vec[i * result_cols + j] = sum;
     }
   }
-  return result;
 }/*}}}*/
 
 // Dot product
@@ -181,32 +221,286 @@ Tensor Tensor::dot(const Tensor& other) const {
   return result;
 }
 
+// Output columns computed per block, keeps the transposed block of `b`
+// and one output row segment in cache while the rows of `a` stream past
+constexpr size_t CDIST_BLOCK = 256;
+
+// Sum of |a - b| per pair, `bt` is `b` transposed to dims x m
+static void cdist_cityblock(const Real* a, const Real* bt, Real* out, size_t n, size_t m, size_t dims) {/*{{{*/
+  for (size_t j0 = 0; j0 < m; j0 += CDIST_BLOCK) {
+    size_t j1 = std::min(j0 + CDIST_BLOCK, m);
+    for (size_t i = 0; i < n; ++i) {
+      Real* row = out + i * m;
+      for (size_t k = 0; k < dims; ++k) {
+        Real a_ik = a[i * dims + k];
+        const Real* b_k = bt + k * m;
+        for (size_t j = j0; j < j1; ++j) {
+          row[j] += std::abs(a_ik - b_k[j]);
+        }
+      }
+    }
+  }
+}/*}}}*/
+
+// ||a||^2 + ||b||^2 - 2ab, the ab term is a blocked (i, k, j) GEMM against `bt`
+static void cdist_gemm(const Real* a, const Real* bt, Real* out, size_t n, size_t m, size_t dims,
+    DIST_METRIC metric) {/*{{{*/
+  std::vector<Real> a_sq(n, 0.0f);
+  std::vector<Real> b_sq(m, 0.0f);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t k = 0; k < dims; ++k) {
+      a_sq[i] += a[i * dims + k] * a[i * dims + k];
+    }
+  }
+  for (size_t k = 0; k < dims; ++k) {
+    const Real* b_k = bt + k * m;
+    for (size_t j = 0; j < m; ++j) {
+      b_sq[j] += b_k[j] * b_k[j];
+    }
+  }
+
+  for (size_t j0 = 0; j0 < m; j0 += CDIST_BLOCK) {
+    size_t j1 = std::min(j0 + CDIST_BLOCK, m);
+    for (size_t i = 0; i < n; ++i) {
+      Real* row = out + i * m;
+      for (size_t k = 0; k < dims; ++k) {
+        Real a_ik = a[i * dims + k];
+        const Real* b_k = bt + k * m;
+        for (size_t j = j0; j < j1; ++j) {
+          row[j] += a_ik * b_k[j];
+        }
+      }
+      // finish the segment while it is still hot
+      Real a_norm = a_sq[i];
+      if (metric == COSINE) {
+        for (size_t j = j0; j < j1; ++j) {
+          Real denom = std::sqrt(a_norm * b_sq[j]);
+          // zero vectors have no direction, treat them as orthogonal
+          row[j] = denom > 0.0f ? 1.0f - row[j] / denom : 1.0f;
+        }
+        continue;
+      }
+      for (size_t j = j0; j < j1; ++j) {
+        // clamp rounding error on (near) identical points
+        row[j] = std::max(a_norm + b_sq[j] - 2.0f * row[j], Real(0.0f));
+      }
+      if (metric == EUCLIDEAN) {
+        for (size_t j = j0; j < j1; ++j) {
+          row[j] = std::sqrt(row[j]);
+        }
+      }
+    }
+  }
+}/*}}}*/
+
+// Pairwise distances between the rows of `this` (N x D) and `other` (M x D),
+// a 1d tensor is a single point
+Tensor Tensor::cdist(const Tensor& other, DIST_METRIC metric) const {/*{{{*/
+  if (cols != other.cols) {
+    report_error("Tensor.cdist(): points must have the same number of columns");
+    return Tensor(0, 0, false);
+  }
+  size_t dims = cols;
+  Tensor result(rows, other.rows, false);
+  const auto& a = data_ref();
+  const auto& b = other.data_ref();
+
+  // Euclidean distances don't change under translation, centering both sets
+  // on their joint mean keeps the norms small, otherwise the float
+  // cancellation in the GEMM form wipes out sub-pixel distances at pixel
+  // scale coordinates
+  std::vector<Real> center(dims, 0.0f);
+  if ((metric == EUCLIDEAN || metric == SQEUCLIDEAN) && rows + other.rows > 0) {
+    for (size_t k = 0; k < dims; ++k) {
+      double sum = 0.0;
+      for (size_t i = 0; i < rows; ++i) sum += a[i * dims + k];
+      for (size_t j = 0; j < other.rows; ++j) sum += b[j * dims + k];
+      center[k] = sum / (rows + other.rows);
+    }
+  }
+  std::vector<Real> centered(a.size());
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t k = 0; k < dims; ++k) {
+      centered[i * dims + k] = a[i * dims + k] - center[k];
+    }
+  }
+  // `other` transposed to D x M, so the inner loops run over contiguous output columns
+  std::vector<Real> bt(b.size());
+  for (size_t j = 0; j < other.rows; ++j) {
+    for (size_t k = 0; k < dims; ++k) {
+      bt[k * other.rows + j] = b[j * dims + k] - center[k];
+    }
+  }
+
+  if (metric == CITYBLOCK) {
+    cdist_cityblock(centered.data(), bt.data(), result.data->data(), rows, other.rows, dims);
+  } else {
+    cdist_gemm(centered.data(), bt.data(), result.data->data(), rows, other.rows, dims, metric);
+  }
+  return result;
+}/*}}}*/
+
+// One pass over (n x D) points with a homogeneous (D + 1) x (D + 1) matrix,
+// `bounds` gets [mins..., maxes...] of the output when not null
+template <size_t D, bool PROJECTIVE>
+static void transform_rows(const Real* src, Real* dst, size_t n, const fixed::Mat<D + 1, D + 1> m, Real* bounds) {/*{{{*/
+  fixed::Vec<D> lo, hi;
+  for (size_t k = 0; k < D; ++k) {
+    lo[k] = std::numeric_limits<Real>::infinity();
+    hi[k] = -std::numeric_limits<Real>::infinity();
+  }
+  for (size_t i = 0; i < n; ++i) {
+    fixed::Vec<D> p = fixed::Vec<D>::load(src + i * D);
+    fixed::Vec<D> q;
+    for (size_t r = 0; r < D; ++r) {
+      Real sum = m(r, D);
+      for (size_t c = 0; c < D; ++c) {
+        sum += m(r, c) * p[c];
+      }
+      q[r] = sum;
+    }
+    if (PROJECTIVE) {
+      Real w = m(D, D);
+      for (size_t c = 0; c < D; ++c) {
+        w += m(D, c) * p[c];
+      }
+      q = q * (Real(1) / w);
+    }
+    q.store(dst + i * D);
+    for (size_t k = 0; k < D; ++k) {
+      lo[k] = std::min(lo[k], q[k]);
+      hi[k] = std::max(hi[k], q[k]);
+    }
+  }
+  if (bounds) {
+    for (size_t k = 0; k < D; ++k) {
+      bounds[k] = n ? lo[k] : 0;
+      bounds[D + k] = n ? hi[k] : 0;
+    }
+  }
+}/*}}}*/
+
+template <size_t D>
+static void transform_points_dim(const Real* src, Real* dst, size_t n, const Tensor& matrix, bool divide, Real* bounds) {/*{{{*/
+  // Every supported shape is a leading block of the homogeneous matrix, the
+  // missing rows and columns come from the identity
+  auto m = fixed::Mat<D + 1, D + 1>::identity();
+  const auto& mat = matrix.data_ref();
+  for (size_t r = 0; r < matrix.rows; ++r) {
+    for (size_t c = 0; c < matrix.cols; ++c) {
+      m(r, c) = mat[r * matrix.cols + c];
+    }
+  }
+  bool projective = false;
+  for (size_t c = 0; c < D; ++c) {
+    projective |= m(D, c) != 0;
+  }
+  projective |= m(D, D) != 1;
+
+  if (projective && divide) {
+    transform_rows<D, true>(src, dst, n, m, bounds);
+  } else {
+    transform_rows<D, false>(src, dst, n, m, bounds);
+  }
+}/*}}}*/
+
+// Apply an affine or projective transform to the rows of an Nx2 or Nx3 point
+// tensor. Nx2 takes a 2x3 affine or 3x3 homogeneous matrix, Nx3 a 3x3 linear,
+// 3x4 affine or 4x4 homogeneous one. `divide` does the perspective divide for
+// homogeneous matrices, `bounds` (2 * cols values) is filled when not null.
+Tensor Tensor::transform_points(const Tensor& matrix, bool divide, Real* bounds) const {/*{{{*/
+  size_t dims = is1d ? rows * cols : cols;
+  bool valid = matrix.rows == dims || matrix.rows == dims + 1;
+  valid = valid && (matrix.cols == dims || matrix.cols == dims + 1);
+  // a 3x3 matrix on 2d points is homogeneous, there is no 2x2 linear case
+  valid = valid && (dims == 2 || dims == 3) && !(dims == 2 && matrix.cols == 2);
+  // the last row alone can't be given without the translation column
+  valid = valid && !(matrix.rows > matrix.cols);
+  if (!valid) {
+    report_error("Tensor.transform_points(): expects a 2x3 or 3x3 matrix for Nx2 points, 3x3, 3x4 or 4x4 for Nx3");
+    return Tensor(0, 0, false);
+  }
+  Tensor result(rows, cols, is1d);
+  transform_points_into(result, matrix, divide, bounds);
+  return result;
+}/*}}}*/
+
+// Expects a matrix already validated by transform_points()
+void Tensor::transform_points_into(Tensor& dst, const Tensor& matrix, bool divide, Real* bounds) const {/*{{{*/
+  size_t dims = is1d ? rows * cols : cols;
+  // a 1d tensor is a single point
+  size_t n = is1d ? 1 : rows;
+  const Real* src = data_ref().data();
+  Real* out = dst.data->data();
+  if (dims == 2) {
+    transform_points_dim<2>(src, out, n, matrix, divide, bounds);
+  } else {
+    transform_points_dim<3>(src, out, n, matrix, divide, bounds);
+  }
+}/*}}}*/
+
 extern "C" {
-  Tensor* tensor_transpose(Tensor* tensor) {
-    return new Tensor(tensor->transpose());
+  TensorHandle tensor_transpose(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("transpose", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->transpose());
   }
 
-  Tensor* tensor_norm(
-      Tensor* tensor,
+  Real* tensor_transpose_into(TensorHandle out, TensorHandle tensor) {
+    TENSOR_PROFILE_OP("transpose", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->cols, tensor->rows, { tensor })) {
+      tensor->transpose_into(*out);
+    }
+    return out->data->data();
+  }
+
+  TensorHandle tensor_norm(
+      TensorHandle tensor,
       int ord = 0,
       int axis = -1,
       bool keepdims = false,
       int* shape_wire = nullptr
       ) {
-    Tensor* new_tensor = new Tensor(tensor->norm(static_cast<NORM_ORD>(ord), axis, keepdims));
+    TENSOR_PROFILE_OP("norm", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->norm(static_cast<NORM_ORD>(ord), axis, keepdims));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  TensorHandle tensor_matmul(TensorHandle tensor, TensorHandle other, int* shape_wire) {
+    TENSOR_PROFILE_OP("matmul", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->matmul(*other));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_matmul(Tensor* tensor, const Tensor& other, int* shape_wire) {
-    Tensor* new_tensor = new Tensor(tensor->matmul(other));
+  Real* tensor_matmul_into(TensorHandle out, TensorHandle tensor, TensorHandle other) {
+    TENSOR_PROFILE_OP("matmul", tensor->rows * tensor->cols);
+    if (tensor->cols != other->rows) {
+      report_error("Tensor shapes are incompatible for multiplication");
+    } else if (prepare_out(out, tensor->rows, other->cols, { tensor, other })) {
+      tensor->matmul_into(*out, *other);
+    }
+    return out->data->data();
+  }
+
+  TensorHandle tensor_dot(TensorHandle tensor, TensorHandle other, int* shape_wire) {
+    TENSOR_PROFILE_OP("dot", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->dot(*other));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_dot(Tensor* tensor, const Tensor& other, int* shape_wire) {
-    Tensor* new_tensor = new Tensor(tensor->dot(other));
+  // `metric`: 0 euclidean, 1 squared euclidean, 2 cityblock (L1), 3 cosine
+  TensorHandle tensor_cdist(TensorHandle tensor, TensorHandle other, int metric, int* shape_wire) {
+    TENSOR_PROFILE_OP("cdist", tensor->rows * other->rows);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->cdist(*other, static_cast<DIST_METRIC>(metric)));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
+
+  // `bounds` is null or 2 * cols values, [mins..., maxes...]
+  TensorHandle tensor_transform_points(TensorHandle tensor, TensorHandle matrix, bool divide, Real* bounds) {
+    TENSOR_PROFILE_OP("transform_points", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->transform_points(*matrix, divide, bounds));
+  }
 }
@@ -0,0 +1,242 @@
+#include "../Tensor.h"
+#include <cstdlib>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/heap.h>
+#include <malloc.h>
+#endif
+
+#ifdef TENSOR_DEBUG
+#include <unordered_map>
+#endif
+
+namespace memory {
+  static Stats counters = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+  // Size classes: multiples of 64 bytes up to 1KB, then 4 classes per power
+  // of two (at most 25% slack) up to POOL_MAX_BLOCK
+  constexpr size_t SMALL_CLASS_BYTES = 1024;
+  constexpr size_t SMALL_CLASSES = SMALL_CLASS_BYTES / BUFFER_ALIGNMENT;
+  constexpr size_t SMALL_CLASS_SHIFT = 10;
+  constexpr size_t POOL_MAX_SHIFT = 24;
+  constexpr size_t POOL_CLASSES = SMALL_CLASSES + (POOL_MAX_SHIFT - SMALL_CLASS_SHIFT) * 4;
+  static_assert(POOL_MAX_BLOCK == size_t(1) << POOL_MAX_SHIFT, "POOL_MAX_SHIFT out of sync");
+
+  // Cached blocks form a singly linked list through their first bytes
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+  static FreeBlock* free_lists[POOL_CLASSES] = {};
+
+  // Class index of a request, `class_bytes` receives the block size
+  static size_t size_class(size_t bytes, size_t& class_bytes) {/*{{{*/
+    bytes = std::max<size_t>(bytes, 1);
+    if (bytes <= SMALL_CLASS_BYTES) {
+      size_t index = (bytes - 1) / BUFFER_ALIGNMENT;
+      class_bytes = (index + 1) * BUFFER_ALIGNMENT;
+      return index;
+    }
+    // bytes in (2^shift, 2^(shift + 1)]
+    size_t shift = 63 - __builtin_clzll(static_cast<unsigned long long>(bytes - 1));
+    size_t step = size_t(1) << (shift - 2);
+    size_t sub = (bytes - 1 - (size_t(1) << shift)) / step;
+    class_bytes = (size_t(1) << shift) + (sub + 1) * step;
+    return SMALL_CLASSES + (shift - SMALL_CLASS_SHIFT) * 4 + sub;
+  }/*}}}*/
+
+  static void* system_allocate(size_t bytes) {
+    void* block = std::aligned_alloc(BUFFER_ALIGNMENT, bytes);
+    if (!block) {
+      report_error("Out of memory");
+    }
+    return block;
+  }
+
+  void* pool_allocate(size_t bytes) {/*{{{*/
+    if (bytes > POOL_MAX_BLOCK) {
+      counters.pool_misses++;
+      return system_allocate((bytes + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT);
+    }
+    size_t class_bytes;
+    size_t index = size_class(bytes, class_bytes);
+    FreeBlock* block = free_lists[index];
+    if (block) {
+      free_lists[index] = block->next;
+      counters.pool_bytes -= class_bytes;
+      counters.pool_hits++;
+      return block;
+    }
+    counters.pool_misses++;
+    return system_allocate(class_bytes);
+  }/*}}}*/
+
+  void pool_release(void* block, size_t bytes) {/*{{{*/
+    if (!block) {
+      return;
+    }
+    if (bytes > POOL_MAX_BLOCK) {
+      std::free(block);
+      return;
+    }
+    size_t class_bytes;
+    size_t index = size_class(bytes, class_bytes);
+    if (counters.pool_bytes + class_bytes > POOL_MAX_BYTES) {
+      std::free(block);
+      return;
+    }
+    FreeBlock* head = static_cast<FreeBlock*>(block);
+    head->next = free_lists[index];
+    free_lists[index] = head;
+    counters.pool_bytes += class_bytes;
+  }/*}}}*/
+
+  void pool_trim() {
+    for (FreeBlock*& head : free_lists) {
+      while (head) {
+        FreeBlock* next = head->next;
+        std::free(head);
+        head = next;
+      }
+    }
+    counters.pool_bytes = 0;
+  }
+
+#ifdef TENSOR_DEBUG
+  struct Allocation {
+    size_t bytes;
+    size_t rows;
+    size_t cols;
+    const char* site;
+  };
+
+  static std::unordered_map<const void*, Allocation>& registry() {
+    static std::unordered_map<const void*, Allocation> live;
+    return live;
+  }
+#endif
+
+  const Stats& stats() {
+    return counters;
+  }
+
+  void reset_peak() {
+    counters.peak_bytes = counters.buffer_bytes;
+  }
+
+  void tensor_created() {
+    counters.tensors++;
+  }
+
+  void tensor_destroyed() {
+    counters.tensors--;
+  }
+
+  void buffer_allocated(const void* block, size_t bytes, size_t rows, size_t cols) {/*{{{*/
+    counters.buffers++;
+    counters.buffer_bytes += bytes;
+    counters.peak_bytes = std::max(counters.peak_bytes, counters.buffer_bytes);
+#ifdef TENSOR_DEBUG
+    const char* site = nullptr;
+#ifdef TENSOR_PROFILE
+    site = profiler::current_op();
+#endif
+    registry()[block] = { bytes, rows, cols, site ? site : "tensor_create" };
+#else
+    (void)block;
+    (void)rows;
+    (void)cols;
+#endif
+  }/*}}}*/
+
+  void buffer_released(const void* block, size_t bytes) {
+    counters.buffers--;
+    counters.buffer_bytes -= bytes;
+#ifdef TENSOR_DEBUG
+    registry().erase(block);
+#else
+    (void)block;
+#endif
+  }
+
+  void object_created(size_t bytes) {
+    counters.objects++;
+    counters.object_bytes += bytes;
+  }
+
+  void object_resized(size_t old_bytes, size_t new_bytes) {
+    counters.object_bytes += new_bytes;
+    counters.object_bytes -= old_bytes;
+  }
+
+  void object_destroyed(size_t bytes) {
+    counters.objects--;
+    counters.object_bytes -= bytes;
+  }
+}
+
+extern "C" {
+  // Write [tensors, buffers, buffer_bytes, peak_bytes, objects, object_bytes,
+  // heap_size, heap_used, heap_free, pool_bytes, pool_hits, pool_misses],
+  // heap figures are 0 outside of wasm
+  void tensor_memory_stats(double* stats) {
+    const memory::Stats& counters = memory::stats();
+    stats[0] = counters.tensors;
+    stats[1] = counters.buffers;
+    stats[2] = counters.buffer_bytes;
+    stats[3] = counters.peak_bytes;
+    stats[4] = counters.objects;
+    stats[5] = counters.object_bytes;
+#ifdef __EMSCRIPTEN__
+    struct mallinfo info = mallinfo();
+    stats[6] = emscripten_get_heap_size();
+    stats[7] = info.uordblks;
+    stats[8] = info.fordblks;
+#else
+    stats[6] = 0;
+    stats[7] = 0;
+    stats[8] = 0;
+#endif
+    stats[9] = counters.pool_bytes;
+    stats[10] = counters.pool_hits;
+    stats[11] = counters.pool_misses;
+  }
+
+  // Release the blocks cached by the buffer pool
+  void tensor_memory_trim() {
+    memory::pool_trim();
+  }
+
+  void tensor_memory_reset_peak() {
+    memory::reset_peak();
+  }
+
+  // Write the `limit` largest live buffers, one "bytes\trowsxcols\tsite" line each,
+  // into `out` (when it fits) and return the length required. Empty unless TENSOR_DEBUG.
+  size_t tensor_memory_report(char* out, size_t size, size_t limit) {
+    std::string report;
+#ifdef TENSOR_DEBUG
+    std::vector<memory::Allocation> live;
+    live.reserve(memory::registry().size());
+    for (const auto& entry : memory::registry()) {
+      live.push_back(entry.second);
+    }
+    size_t count = std::min(limit, live.size());
+    std::partial_sort(live.begin(), live.begin() + count, live.end(),
+        [](const memory::Allocation& a, const memory::Allocation& b) { return a.bytes > b.bytes; });
+    for (size_t i = 0; i < count; ++i) {
+      if (!report.empty()) {
+        report += '\n';
+      }
+      report += std::to_string(live[i].bytes) + "\t" \
+                + std::to_string(live[i].rows) + "x" + std::to_string(live[i].cols) + "\t" \
+                + live[i].site;
+    }
+#else
+    (void)limit;
+#endif
+    if (out && size >= report.size()) {
+      std::copy(report.begin(), report.end(), out);
+    }
+    return report.size();
+  }
+}
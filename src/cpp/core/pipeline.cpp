@@ -0,0 +1,177 @@
+#include "../Pipeline.h"
+#include "../FastMath.h"
+
+// Validates `step` against an input of shape `in` and returns the shape of
+// its result, errors surface while building rather than per frame
+static Shape step_shape(const PipelineStep& step, const Shape& in) {/*{{{*/
+  const Tensor* operand = step.operand.get();
+  switch (step.op) {
+    case PIPE_ADD:
+    case PIPE_SUB:
+    case PIPE_MUL:
+    case PIPE_DIV:
+    case PIPE_MAXIMUM:
+    case PIPE_MINIMUM: {
+      size_t size = operand->rows * operand->cols;
+      if (size != 1 && size != in.cols && size != in.rows * in.cols) {
+        std::string message = "Cannot broadcast input against shape[" \
+            + std::to_string(in.rows) + "," + std::to_string(in.cols) + "]";
+        report_error(message.c_str());
+      }
+      return in;
+    }
+    case PIPE_MATMUL:
+      if (in.cols != operand->rows) {
+        report_error("Tensor shapes are incompatible for multiplication");
+      }
+      return { in.rows, operand->cols, in.is1d };
+    case PIPE_TRANSFORM_POINTS: {
+      // a single point goes through the same validation as transform_points()
+      size_t dims = in.is1d ? in.rows * in.cols : in.cols;
+      Tensor(1, dims, in.is1d).transform_points(*operand);
+      return in;
+    }
+    case PIPE_TRANSPOSE:
+      return { in.cols, in.rows, in.is1d };
+    case PIPE_SUM:
+    case PIPE_MEAN:
+    case PIPE_MIN:
+    case PIPE_MAX: {
+      int axis = static_cast<int>(step.param0);
+      if (axis < -1 || axis > 1) {
+        report_error("Pipeline: axis must be -1 (flat), 0 (column-wise) or 1 (row-wise)");
+      }
+      if (axis == 0) {
+        return { 1, in.cols, false };
+      }
+      if (axis == 1) {
+        return { in.rows, 1, false };
+      }
+      return { 1, 1, step.param1 == 0 };
+    }
+    default:
+      return in;
+  }
+}/*}}}*/
+
+// Run one step of a frame, every op writes straight into `dst`
+static void run_step(const PipelineStep& step, const Tensor& in, Tensor& dst) {/*{{{*/
+  const Tensor* operand = step.operand.get();
+  const Real* rhs = operand ? operand->data_ref().data() : nullptr;
+  size_t rhs_size = operand ? operand->rows * operand->cols : 0;
+  int param = static_cast<int>(step.param0);
+  switch (step.op) {
+    case PIPE_ADD: in.add_into(dst, rhs, rhs_size); break;
+    case PIPE_SUB: in.sub_into(dst, rhs, rhs_size); break;
+    case PIPE_MUL: in.mul_into(dst, rhs, rhs_size); break;
+    case PIPE_DIV: in.div_into(dst, param != 0, rhs, rhs_size); break;
+    case PIPE_MAXIMUM: in.maximum_into(dst, rhs, rhs_size); break;
+    case PIPE_MINIMUM: in.minimum_into(dst, rhs, rhs_size); break;
+    case PIPE_ABS: in.abs_into(dst); break;
+    case PIPE_SQUARE: in.square_into(dst); break;
+    case PIPE_CLIP: in.clip_into(dst, step.param0, step.param1); break;
+    // the math mode is resolved per frame, so a global mode change applies
+    case PIPE_EXP: in.exp_into(dst, fastmath::resolve(param)); break;
+    case PIPE_LOG: in.log_into(dst, fastmath::resolve(param)); break;
+    case PIPE_SIGMOID: in.sigmoid_into(dst, fastmath::resolve(param)); break;
+    case PIPE_TANH: in.tanh_into(dst, fastmath::resolve(param)); break;
+    case PIPE_MATMUL: in.matmul_into(dst, *operand); break;
+    case PIPE_TRANSFORM_POINTS: in.transform_points_into(dst, *operand, param != 0); break;
+    case PIPE_TRANSPOSE: in.transpose_into(dst); break;
+    case PIPE_SUM: in.sum_into(dst, param); break;
+    case PIPE_MEAN: in.mean_into(dst, param); break;
+    case PIPE_MIN: in.min_into(dst, param); break;
+    case PIPE_MAX: in.max_into(dst, param); break;
+  }
+}/*}}}*/
+
+Pipeline::Pipeline(size_t rows, size_t cols, bool is1d) {/*{{{*/
+  for (size_t i = 0; i < 2; ++i) {
+    inputs[i] = std::make_shared<Tensor>(rows, cols, is1d);
+    outputs[i] = std::make_shared<Tensor>(rows, cols, is1d);
+  }
+  memory::object_created(state_bytes());
+}/*}}}*/
+
+Pipeline::~Pipeline() {
+  memory::object_destroyed(state_bytes());
+}
+
+size_t Pipeline::state_bytes() const {
+  return steps.capacity() * sizeof(PipelineStep);
+}
+
+void Pipeline::add_step(PIPELINE_OP op, const Tensor* operand, Real param0, Real param1) {/*{{{*/
+  if (op < PIPE_ADD || op > PIPE_MAX) {
+    report_error("Pipeline: unknown op");
+    return;
+  }
+  bool needs_operand = op <= PIPE_MINIMUM || op == PIPE_MATMUL || op == PIPE_TRANSFORM_POINTS;
+  if (needs_operand && !operand) {
+    report_error("Pipeline: step expects a tensor operand");
+    return;
+  }
+  PipelineStep step = { op, nullptr, param0, param1, nullptr };
+  if (operand) {
+    // share the data, the caller is free to delete its tensor
+    step.operand = std::make_shared<Tensor>(operand->rows, operand->cols, operand->is1d, operand->data);
+  }
+  Shape shape = step_shape(step, outputs[0]->get_shape());
+
+  // the previous last step now writes to an intermediate, the output slots
+  // take the new result shape
+  size_t old_bytes = state_bytes();
+  if (!steps.empty()) {
+    steps.back().out = std::move(outputs[0]);
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    outputs[i] = std::make_shared<Tensor>(shape.rows, shape.cols, shape.is1d);
+  }
+  steps.push_back(std::move(step));
+  memory::object_resized(old_bytes, state_bytes());
+}/*}}}*/
+
+size_t Pipeline::run() {/*{{{*/
+  size_t used = slot;
+  const Tensor* in = inputs[used].get();
+  Tensor& out = *outputs[used];
+  if (steps.empty()) {
+    std::copy(in->data->begin(), in->data->end(), out.data->begin());
+  }
+  for (size_t i = 0; i < steps.size(); ++i) {
+    Tensor& dst = i + 1 < steps.size() ? *steps[i].out : out;
+    run_step(steps[i], *in, dst);
+    in = &dst;
+  }
+  slot ^= 1;
+  return used;
+}/*}}}*/
+
+extern "C" {
+  Pipeline* pipeline_create(size_t rows, size_t cols, bool is1d) {
+    return new Pipeline(rows, cols, is1d);
+  }
+
+  void pipeline_delete(Pipeline* pipeline) {
+    delete pipeline;
+  }
+
+  // `operand` is optional (null), `shape_wire` receives the new output shape
+  void pipeline_add(Pipeline* pipeline, int op, TensorHandle operand, Real param0, Real param1, int* shape_wire) {
+    pipeline->add_step(static_cast<PIPELINE_OP>(op), operand, param0, param1);
+    update_shape_wire(&pipeline->output(0), shape_wire);
+  }
+
+  size_t pipeline_run(Pipeline* pipeline) {
+    TENSOR_PROFILE_OP("pipeline_run", pipeline->size());
+    return pipeline->run();
+  }
+
+  Real* pipeline_input(Pipeline* pipeline, size_t slot) {
+    return pipeline->input(slot).data->data();
+  }
+
+  Real* pipeline_output(Pipeline* pipeline, size_t slot) {
+    return pipeline->output(slot).data->data();
+  }
+}
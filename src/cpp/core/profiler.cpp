@@ -0,0 +1,116 @@
+#include "../Tensor.h"
+
+// Number of fields written per op by tensor_profile_snapshot
+constexpr size_t PROFILE_FIELDS = 5;
+
+#ifdef TENSOR_PROFILE
+namespace profiler {
+  constexpr size_t NO_OP = static_cast<size_t>(-1);
+
+  static std::vector<OpStats>& registry() {
+    static std::vector<OpStats> ops;
+    return ops;
+  }
+  static size_t active = NO_OP;
+
+  size_t register_op(const char* name) {/*{{{*/
+    auto& ops = registry();
+    ops.push_back({ name, 0, 0, 0, 0, 0 });
+    return ops.size() - 1;
+  }/*}}}*/
+
+  void record_alloc(size_t bytes) {
+    if (active != NO_OP) {
+      registry()[active].bytes += bytes;
+    }
+  }
+
+  const char* current_op() {
+    return active == NO_OP ? nullptr : registry()[active].name;
+  }
+
+  Scope::Scope(size_t op, size_t elements)
+    : op(op), parent(active), start(std::chrono::steady_clock::now()) {
+    OpStats& stats = registry()[op];
+    stats.calls++;
+    stats.elements += elements;
+    active = op;
+  }
+
+  Scope::~Scope() {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    OpStats& stats = registry()[op];
+    stats.total_ns += ns;
+    stats.max_ns = std::max(stats.max_ns, ns);
+    active = parent;
+  }
+}
+#endif
+
+extern "C" {
+  bool tensor_profile_enabled() {
+#ifdef TENSOR_PROFILE
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // Number of ops recorded so far
+  size_t tensor_profile_count() {
+#ifdef TENSOR_PROFILE
+    return profiler::registry().size();
+#else
+    return 0;
+#endif
+  }
+
+  // Write [calls, total_ns, max_ns, elements, bytes] per op, in registration order
+  void tensor_profile_snapshot(double* stats) {
+#ifdef TENSOR_PROFILE
+    const auto& ops = profiler::registry();
+    for (size_t i = 0; i < ops.size(); ++i) {
+      double* row = stats + i * PROFILE_FIELDS;
+      row[0] = static_cast<double>(ops[i].calls);
+      row[1] = static_cast<double>(ops[i].total_ns);
+      row[2] = static_cast<double>(ops[i].max_ns);
+      row[3] = static_cast<double>(ops[i].elements);
+      row[4] = static_cast<double>(ops[i].bytes);
+    }
+#else
+    (void)stats;
+#endif
+  }
+
+  // Write the newline separated op names into `out` (when it fits)
+  // and return the length required
+  size_t tensor_profile_names(char* out, size_t size) {
+    std::string names;
+#ifdef TENSOR_PROFILE
+    for (const auto& op : profiler::registry()) {
+      if (!names.empty()) {
+        names += '\n';
+      }
+      names += op.name;
+    }
+#endif
+    if (out && size >= names.size()) {
+      std::copy(names.begin(), names.end(), out);
+    }
+    return names.size();
+  }
+
+  // Zero the counters, keeping the registered ops
+  void tensor_profile_reset() {
+#ifdef TENSOR_PROFILE
+    for (auto& op : profiler::registry()) {
+      op.calls = 0;
+      op.total_ns = 0;
+      op.max_ns = 0;
+      op.elements = 0;
+      op.bytes = 0;
+    }
+#endif
+  }
+}
@@ -2,26 +2,25 @@
 
 // All bitwise AND op
 Tensor Tensor::all(int axis, bool keepdims) const {/*{{{*/
-  std::vector<Real> result;
+  Tensor result = reduction_result(axis, keepdims);
+  all_into(result, axis);
+  return result;
+}/*}}}*/
+
+void Tensor::all_into(Tensor& dst, int axis) const {/*{{{*/
   const auto& vec = data_ref();
-  size_t nrows = rows;
-  size_t ncols = cols;
-  float zero = 0.0f;
+  auto& result = (*dst.data);
+  const Real zero = 0.0f;
 
   if (axis == -1) {
     bool found = false;
-    for (auto& elem : vec) {
-      if (elem == zero) {
-        found = true;
-        break;
-      }
+    for (size_t i = 0; i < rows * cols && !found; ++i) {
+      found = vec[i] == zero;
     }
-    result.push_back(found ? zero : 1.0f);
-    nrows = 1;
-    ncols = 1;
+    result[0] = found ? zero : 1.0f;
   } else if (axis == 0) {
-    result.resize(cols, 1.0f);
     for (size_t j = 0; j < cols; ++j) {
+      result[j] = 1.0f;
       for (size_t i = 0; i < rows; ++i) {
         if (vec[i * cols + j] == zero) {
           result[j] = zero;
@@ -29,10 +28,9 @@ Tensor Tensor::all(int axis, bool keepdims) const {/*{{{*/
         }
       }
     }
-    nrows = 1;
   } else if (axis == 1) {
-    result.resize(rows, 1.0f);
     for (size_t i = 0; i < rows; ++i) {
+      result[i] = 1.0f;
       for (size_t j = 0; j < cols; ++j) {
         if (vec[i * cols + j] == zero) {
           result[i] = zero;
@@ -40,34 +38,30 @@ Tensor Tensor::all(int axis, bool keepdims) const {/*{{{*/
         }
       }
     }
-    ncols = 1;
   }
-
-  return Tensor(nrows, ncols, !keepdims && axis < 0, std::move(result));
 }/*}}}*/
 
 // Any bitwise OR op
 Tensor Tensor::any(int axis, bool keepdims) const {/*{{{*/
-  std::vector<Real> result;
+  Tensor result = reduction_result(axis, keepdims);
+  any_into(result, axis);
+  return result;
+}/*}}}*/
+
+void Tensor::any_into(Tensor& dst, int axis) const {/*{{{*/
   const auto& vec = data_ref();
-  size_t nrows = rows;
-  size_t ncols = cols;
-  float zero = 0.0f;
+  auto& result = (*dst.data);
+  const Real zero = 0.0f;
 
   if (axis == -1) {
     bool found = false;
-    for (auto& elem : vec) {
-      if (elem != zero) {
-        found = true;
-        break;
-      }
+    for (size_t i = 0; i < rows * cols && !found; ++i) {
+      found = vec[i] != zero;
     }
-    result.push_back(found ? 1.0f : zero);
-    nrows = 1;
-    ncols = 1;
+    result[0] = found ? 1.0f : zero;
   } else if (axis == 0) {
-    result.resize(cols, 0.0f);
     for (size_t j = 0; j < cols; ++j) {
+      result[j] = zero;
       for (size_t i = 0; i < rows; ++i) {
         if (vec[i * cols + j] != zero) {
           result[j] = 1.0f;
@@ -75,10 +69,9 @@ Tensor Tensor::any(int axis, bool keepdims) const {/*{{{*/
         }
       }
     }
-    nrows = 1;
   } else if (axis == 1) {
-    result.resize(rows, 0.0f);
     for (size_t i = 0; i < rows; ++i) {
+      result[i] = zero;
       for (size_t j = 0; j < cols; ++j) {
         if (vec[i * cols + j] != zero) {
           result[i] = 1.0f;
@@ -86,407 +79,553 @@ Tensor Tensor::any(int axis, bool keepdims) const {/*{{{*/
         }
       }
     }
-    ncols = 1;
   }
-
-  return Tensor(nrows, ncols, !keepdims && axis < 0, std::move(result));
 }/*}}}*/
 
-// ArgMax
+// ArgMax, 1d tensors ignore the axis
 Tensor Tensor::arg_max(int axis) const {/*{{{*/
-  std::vector<Real> result;
+  Tensor result = is1d ? Tensor(1, 1, true) : reduction_result(axis, false);
+  arg_max_into(result, axis);
+  return result;
+}/*}}}*/
+
+void Tensor::arg_max_into(Tensor& dst, int axis) const {/*{{{*/
   const auto& vec = data_ref();
-  size_t nrows = rows;
-  size_t ncols = cols;
+  auto& result = (*dst.data);
   if (is1d) {
-    int max_index = std::distance(vec.begin(), std::max_element(vec.begin(), vec.end()));
-    result.push_back(static_cast<Real>(max_index));
-    ncols = 1;
-    nrows = 1;
+    size_t max_index = std::distance(vec.begin(), std::max_element(vec.begin(), vec.begin() + cols));
+    result[0] = static_cast<Real>(max_index);
   } else if (axis == 0) {
-    result.resize(cols, 0.0f);
     for (size_t j = 0; j < cols; ++j) {
+      // compare against the running best, not the previous element
+      size_t best = 0;
       for (size_t i = 1; i < rows; ++i) {
-        if (vec[i * cols + j] > vec[(i - 1) * cols + j]) {
-          result[j] = static_cast<Real>(i);
+        if (vec[i * cols + j] > vec[best * cols + j]) {
+          best = i;
         }
       }
+      result[j] = static_cast<Real>(best);
     }
-    nrows = 1;
   } else if (axis == 1) {
-    result.resize(rows, 0.0f);
     for (size_t i = 0; i < rows; ++i) {
+      size_t best = 0;
       for (size_t j = 1; j < cols; ++j) {
-        if (vec[i * cols + j] > vec[i * cols + (j - 1)]) {
-          result[i] = static_cast<Real>(j);
+        if (vec[i * cols + j] > vec[i * cols + best]) {
+          best = j;
         }
       }
+      result[i] = static_cast<Real>(best);
     }
-    ncols = 1;
   }
-  return Tensor(nrows, ncols, is1d, std::move(result));
 }/*}}}*/
 
-// ArgMin
+// ArgMin, 1d tensors ignore the axis
 Tensor Tensor::arg_min(int axis) const {/*{{{*/
-  std::vector<Real> result;
+  Tensor result = is1d ? Tensor(1, 1, true) : reduction_result(axis, false);
+  arg_min_into(result, axis);
+  return result;
+}/*}}}*/
+
+void Tensor::arg_min_into(Tensor& dst, int axis) const {/*{{{*/
   const auto& vec = data_ref();
-  size_t nrows = rows;
-  size_t ncols = cols;
+  auto& result = (*dst.data);
   if (is1d) {
-    int min_index = std::distance(vec.begin(), std::min_element(vec.begin(), vec.end()));
-    result.push_back(static_cast<Real>(min_index));
-    ncols = 1;
-    nrows = 1;
+    size_t min_index = std::distance(vec.begin(), std::min_element(vec.begin(), vec.begin() + cols));
+    result[0] = static_cast<Real>(min_index);
   } else if (axis == 0) {
-    result.resize(cols, 0.0f);
     for (size_t j = 0; j < cols; ++j) {
+      // compare against the running best, not the previous element
+      size_t best = 0;
       for (size_t i = 1; i < rows; ++i) {
-        if (vec[i * cols + j] < vec[(i - 1) * cols + j]) {
-          result[j] = static_cast<Real>(i);
+        if (vec[i * cols + j] < vec[best * cols + j]) {
+          best = i;
         }
       }
+      result[j] = static_cast<Real>(best);
     }
-    nrows = 1;
   } else if (axis == 1) {
-    result.resize(rows, 0.0f);
     for (size_t i = 0; i < rows; ++i) {
+      size_t best = 0;
       for (size_t j = 1; j < cols; ++j) {
-        if (vec[i * cols + j] < vec[i * cols + (j - 1)]) {
-          result[i] = static_cast<Real>(j);
+        if (vec[i * cols + j] < vec[i * cols + best]) {
+          best = j;
         }
       }
+      result[i] = static_cast<Real>(best);
     }
-    ncols = 1;
   }
-  return Tensor(nrows, ncols, is1d, std::move(result));
 }/*}}}*/
 
+// Reducing along `axis` leaves a single value, one value per column
+// (axis 0) or one per row (axis 1)
+Shape Tensor::reduction_shape(int axis, bool keepdims) const {/*{{{*/
+  if (axis == 0) {
+    return { 1, cols, false };
+  }
+  if (axis == 1) {
+    return { rows, 1, false };
+  }
+  return { 1, 1, !keepdims && axis < 0 };
+}/*}}}*/
+
+Tensor Tensor::reduction_result(int axis, bool keepdims) const {
+  Shape shape = reduction_shape(axis, keepdims);
+  return Tensor(shape.rows, shape.cols, shape.is1d);
+}
+
 // Max
 Tensor Tensor::max(int axis, bool keepdims) const {/*{{{*/
-  std::vector<Real> result;
+  Tensor result = reduction_result(axis, keepdims);
+  max_into(result, axis);
+  return result;
+}/*}}}*/
+
+void Tensor::max_into(Tensor& dst, int axis) const {/*{{{*/
   const auto& vec = data_ref();
-  size_t nrows = rows;
-  size_t ncols = cols;
+  auto& result = (*dst.data);
   const Real lowest = std::numeric_limits<Real>::lowest();
 
   if (axis == -1) {
-    // Mean of all elements
     Real max_val = lowest;
-    for (auto& elem : vec) {
-      if (elem > max_val) {
-        max_val = elem;
-      }
+    for (size_t i = 0; i < rows * cols; ++i) {
+      max_val = std::max(max_val, vec[i]);
     }
-    result.push_back(max_val);
-    nrows = 1;
-    ncols = 1;
+    result[0] = max_val;
   } else if (axis == 0) {
-    // Mean column-wise (reduce rows)
-    result.resize(cols, 0.0f);
+    // column-wise (reduce rows)
     for (size_t j = 0; j < cols; ++j) {
       Real max_val = lowest;
       for (size_t i = 0; i < rows; ++i) {
-        Real val = vec[i * cols + j];
-        if (val > max_val) {
-          std::swap(max_val, val);
-        }
+        max_val = std::max(max_val, vec[i * cols + j]);
       }
-      std::swap(result[j], max_val);
+      result[j] = max_val;
     }
-    nrows = 1;
   } else if (axis == 1) {
-    // Mean row-wise (reduce columns)
-    result.resize(rows, 0.0f);
+    // row-wise (reduce columns)
     for (size_t i = 0; i < rows; ++i) {
       Real max_val = lowest;
       for (size_t j = 0; j < cols; ++j) {
-        Real val = vec[i * cols + j];
-        if (val > max_val) {
-          std::swap(max_val, val);
-        }
+        max_val = std::max(max_val, vec[i * cols + j]);
       }
-      std::swap(result[i], max_val);
+      result[i] = max_val;
     }
-    ncols = 1;
   }
-
-  return Tensor(nrows, ncols, !keepdims && axis < 0, std::move(result));
 }/*}}}*/
 
 // Mean
 Tensor Tensor::mean(int axis, bool keepdims) const {/*{{{*/
-  std::vector<Real> means;
-  const auto& vec = data_ref();
-  size_t nrows = rows;
-  size_t ncols = cols;
+  Tensor result = reduction_result(axis, keepdims);
+  mean_into(result, axis);
+  return result;
+}/*}}}*/
 
-  if (axis == -1) {
-    // Mean of all elements
-    Real sum = 0.0f;
-    size_t size = vec.size();
-    for (auto& elem : vec) {
-      sum += elem;
-    }
-    means.push_back(sum / size);
-    nrows = 1;
-    ncols = 1;
-  } else if (axis == 0) {
-    // Mean column-wise (reduce rows)
-    means.resize(cols, 0.0f);
-    for (size_t j = 0; j < cols; ++j) {
-      Real sum = 0.0f;
-      for (size_t i = 0; i < rows; ++i) {
-        sum += vec[i * cols + j];
-      }
-      means[j] = sum / rows;
-    }
-    nrows = 1;
-  } else if (axis == 1) {
-    // Mean row-wise (reduce columns)
-    means.resize(rows, 0.0f);
-    for (size_t i = 0; i < rows; ++i) {
-      Real sum = 0.0f;
-      for (size_t j = 0; j < cols; ++j) {
-        sum += vec[i * cols + j];
-      }
-      means[i] = sum / cols;
-    }
-    ncols = 1;
+void Tensor::mean_into(Tensor& dst, int axis) const {/*{{{*/
+  sum_into(dst, axis);
+  size_t count = axis == 0 ? rows : (axis == 1 ? cols : rows * cols);
+  auto& result = (*dst.data);
+  for (size_t i = 0; i < dst.rows * dst.cols; ++i) {
+    result[i] /= count;
   }
-
-  return Tensor(nrows, ncols, !keepdims && axis < 0, std::move(means));
 }/*}}}*/
 
 // Min
 Tensor Tensor::min(int axis, bool keepdims) const {/*{{{*/
-  std::vector<Real> result;
+  Tensor result = reduction_result(axis, keepdims);
+  min_into(result, axis);
+  return result;
+}/*}}}*/
+
+void Tensor::min_into(Tensor& dst, int axis) const {/*{{{*/
   const auto& vec = data_ref();
-  size_t nrows = rows;
-  size_t ncols = cols;
+  auto& result = (*dst.data);
 
   if (axis == -1) {
-    // Mean of all elements
     Real min_val = Tensor::INF;
-    for (auto& elem : vec) {
-      if (elem < min_val) {
-        min_val = elem;
-      }
+    for (size_t i = 0; i < rows * cols; ++i) {
+      min_val = std::min(min_val, vec[i]);
     }
-    result.push_back(min_val);
-    nrows = 1;
-    ncols = 1;
+    result[0] = min_val;
   } else if (axis == 0) {
-    // Mean column-wise (reduce rows)
-    result.resize(cols, 0.0f);
+    // column-wise (reduce rows)
     for (size_t j = 0; j < cols; ++j) {
       Real min_val = Tensor::INF;
       for (size_t i = 0; i < rows; ++i) {
-        Real val = vec[i * cols + j];
-        if (val < min_val) {
-          std::swap(min_val, val);
-        }
+        min_val = std::min(min_val, vec[i * cols + j]);
       }
-      std::swap(result[j], min_val);
+      result[j] = min_val;
     }
-    nrows = 1;
   } else if (axis == 1) {
-    // Mean row-wise (reduce columns)
-    result.resize(rows, 0.0f);
+    // row-wise (reduce columns)
     for (size_t i = 0; i < rows; ++i) {
       Real min_val = Tensor::INF;
       for (size_t j = 0; j < cols; ++j) {
-        Real val = vec[i * cols + j];
-        if (val < min_val) {
-          std::swap(min_val, val);
-        }
+        min_val = std::min(min_val, vec[i * cols + j]);
       }
-      std::swap(result[i], min_val);
+      result[i] = min_val;
     }
-    ncols = 1;
   }
-
-  return Tensor(nrows, ncols, !keepdims && axis < 0, std::move(result));
 }/*}}}*/
 
 // Sum
 Tensor Tensor::sum(int axis, bool keepdims) const {/*{{{*/
-  std::vector<Real> result;
+  Tensor result = reduction_result(axis, keepdims);
+  sum_into(result, axis);
+  return result;
+}/*}}}*/
+
+void Tensor::sum_into(Tensor& dst, int axis) const {/*{{{*/
   const auto& vec = data_ref();
-  size_t nrows = rows;
-  size_t ncols = cols;
+  auto& result = (*dst.data);
 
   if (axis == -1) {
     Real sum = 0.0f;
-    for (auto& elem : vec) {
-      sum += elem;
+    for (size_t i = 0; i < rows * cols; ++i) {
+      sum += vec[i];
     }
-    result.push_back(sum);
-    nrows = 1;
-    ncols = 1;
+    result[0] = sum;
   } else if (axis == 0) {
-    // Mean column-wise (reduce rows)
-    result.resize(cols, 0.0f);
+    // column-wise (reduce rows)
     for (size_t j = 0; j < cols; ++j) {
       Real sum = 0.0f;
       for (size_t i = 0; i < rows; ++i) {
         sum += vec[i * cols + j];
       }
-      std::swap(result[j], sum);
+      result[j] = sum;
     }
-    nrows = 1;
   } else if (axis == 1) {
-    // Mean row-wise (reduce columns)
-    result.resize(rows, 0.0f);
+    // row-wise (reduce columns)
     for (size_t i = 0; i < rows; ++i) {
       Real sum = 0.0f;
       for (size_t j = 0; j < cols; ++j) {
         sum += vec[i * cols + j];
       }
-      std::swap(result[i], sum);
+      result[i] = sum;
     }
-    ncols = 1;
   }
-
-  return Tensor(nrows, ncols, !keepdims && axis < 0, std::move(result));
 }/*}}}*/
 
 // Product
 Tensor Tensor::prod(int axis, bool keepdims) const {/*{{{*/
-  std::vector<Real> result;
+  Tensor result = reduction_result(axis, keepdims);
+  prod_into(result, axis);
+  return result;
+}/*}}}*/
+
+void Tensor::prod_into(Tensor& dst, int axis) const {/*{{{*/
   const auto& vec = data_ref();
-  size_t nrows = rows;
-  size_t ncols = cols;
+  auto& result = (*dst.data);
 
   if (axis == -1) {
     Real prod = 1.0f;
-    for (auto& elem : vec) {
-      prod *= elem;
+    for (size_t i = 0; i < rows * cols; ++i) {
+      prod *= vec[i];
     }
-    result.push_back(prod);
-    nrows = 1;
-    ncols = 1;
+    result[0] = prod;
   } else if (axis == 0) {
-    // Mean column-wise (reduce rows)
-    result.resize(cols, 0.0f);
+    // column-wise (reduce rows)
     for (size_t j = 0; j < cols; ++j) {
       Real prod = 1.0f;
       for (size_t i = 0; i < rows; ++i) {
         prod *= vec[i * cols + j];
       }
-      std::swap(result[j], prod);
+      result[j] = prod;
     }
-    nrows = 1;
   } else if (axis == 1) {
-    // Mean row-wise (reduce columns)
-    result.resize(rows, 0.0f);
+    // row-wise (reduce columns)
     for (size_t i = 0; i < rows; ++i) {
       Real prod = 1.0f;
       for (size_t j = 0; j < cols; ++j) {
         prod *= vec[i * cols + j];
       }
-      std::swap(result[i], prod);
+      result[i] = prod;
     }
-    ncols = 1;
   }
+}/*}}}*/
 
-  return Tensor(nrows, ncols, !keepdims && axis < 0, std::move(result));
+// Running sum, product, max or min
+Tensor Tensor::scan(SCAN_OP op, int axis, bool exclusive) const {/*{{{*/
+  Tensor result(rows, cols, is1d);
+  scan_into(result, op, axis, exclusive);
+  return result;
+}/*}}}*/
+
+// `identity` starts exclusive scans, `func` is inlined into the sweeps
+template <typename Func>
+static void scan_values(
+    const Real* src,
+    Real* out,
+    size_t rows,
+    size_t cols,
+    int axis,
+    bool exclusive,
+    Real identity,
+    Func func
+    ) {/*{{{*/
+  if (axis == 0) {
+    // sweep down whole rows, each step combines two contiguous rows and
+    // vectorizes, instead of walking every column with a stride of `cols`
+    if (rows == 0) {
+      return;
+    }
+    if (exclusive) {
+      std::fill(out, out + cols, identity);
+    } else {
+      std::copy(src, src + cols, out);
+    }
+    for (size_t i = 1; i < rows; ++i) {
+      const Real* prev = out + (i - 1) * cols;
+      const Real* x = src + (exclusive ? i - 1 : i) * cols;
+      Real* o = out + i * cols;
+      for (size_t j = 0; j < cols; ++j) {
+        o[j] = func(prev[j], x[j]);
+      }
+    }
+    return;
+  }
+  // axis 1 scans each row, -1 the values in order as one row
+  size_t count = axis == 1 ? rows : 1;
+  size_t length = axis == 1 ? cols : rows * cols;
+  for (size_t i = 0; i < count; ++i) {
+    const Real* x = src + i * length;
+    Real* o = out + i * length;
+    Real acc = identity;
+    for (size_t j = 0; j < length; ++j) {
+      Real next = func(acc, x[j]);
+      o[j] = exclusive ? acc : next;
+      acc = next;
+    }
+  }
+}/*}}}*/
+
+void Tensor::scan_into(Tensor& dst, SCAN_OP op, int axis, bool exclusive) const {/*{{{*/
+  if (axis < -1 || axis > 1) {
+    report_error("Axis must be -1 (flat), 0 (column-wise) or 1 (row-wise)");
+    return;
+  }
+  const Real* src = data_ref().data();
+  Real* out = dst.data->data();
+  switch (op) {
+    case SCAN_SUM:
+      scan_values(src, out, rows, cols, axis, exclusive, Real(0),
+          [](Real a, Real b) { return a + b; });
+      break;
+    case SCAN_PROD:
+      scan_values(src, out, rows, cols, axis, exclusive, Real(1),
+          [](Real a, Real b) { return a * b; });
+      break;
+    // NaN propagates whichever side it is on, std::max/min only keep it
+    // as the first argument
+    case SCAN_MAX:
+      scan_values(src, out, rows, cols, axis, exclusive, -INF,
+          [](Real a, Real b) { return (a != a) | (a > b) ? a : b; });
+      break;
+    case SCAN_MIN:
+      scan_values(src, out, rows, cols, axis, exclusive, INF,
+          [](Real a, Real b) { return (a != a) | (a < b) ? a : b; });
+      break;
+  }
 }/*}}}*/
 
 extern "C" {
-  Tensor* tensor_all(
-      Tensor* tensor,
+  TensorHandle tensor_all(
+      TensorHandle tensor,
       int axis = -1,
       bool keepdims = false,
       int* shape_wire = nullptr
       ) {
 
-    Tensor* new_tensor = new Tensor(tensor->all(axis, keepdims));
+    TENSOR_PROFILE_OP("all", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->all(axis, keepdims));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_any(
-      Tensor* tensor,
+  TensorHandle tensor_any(
+      TensorHandle tensor,
       int axis = -1,
       bool keepdims = false,
       int* shape_wire = nullptr
       ) {
 
-    Tensor* new_tensor = new Tensor(tensor->any(axis, keepdims));
+    TENSOR_PROFILE_OP("any", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->any(axis, keepdims));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_arg_max(Tensor* tensor, int axis = 0, int* shape_wire = nullptr) {
-    Tensor* new_tensor = new Tensor(tensor->arg_max(axis));
+  TensorHandle tensor_arg_max(TensorHandle tensor, int axis = 0, int* shape_wire = nullptr) {
+    TENSOR_PROFILE_OP("arg_max", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->arg_max(axis));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_arg_min(Tensor* tensor, int axis = 0, int* shape_wire = nullptr) {
-    Tensor* new_tensor = new Tensor(tensor->arg_min(axis));
+  TensorHandle tensor_arg_min(TensorHandle tensor, int axis = 0, int* shape_wire = nullptr) {
+    TENSOR_PROFILE_OP("arg_min", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->arg_min(axis));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_max(
-      Tensor* tensor,
+  TensorHandle tensor_max(
+      TensorHandle tensor,
       int axis = -1,
       bool keepdims = false,
       int* shape_wire = nullptr
       ) {
 
-    Tensor* new_tensor = new Tensor(tensor->max(axis, keepdims));
+    TENSOR_PROFILE_OP("max", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->max(axis, keepdims));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_mean(
-      Tensor* tensor,
+  TensorHandle tensor_mean(
+      TensorHandle tensor,
       int axis = -1,
       bool keepdims = false,
       int* shape_wire = nullptr
       ) {
 
-    Tensor* new_tensor = new Tensor(tensor->mean(axis, keepdims));
+    TENSOR_PROFILE_OP("mean", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->mean(axis, keepdims));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_min(
-      Tensor* tensor,
+  TensorHandle tensor_min(
+      TensorHandle tensor,
       int axis = -1,
       bool keepdims = false,
       int* shape_wire = nullptr
       ) {
 
-    Tensor* new_tensor = new Tensor(tensor->min(axis, keepdims));
+    TENSOR_PROFILE_OP("min", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->min(axis, keepdims));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_prod(
-      Tensor* tensor,
+  TensorHandle tensor_prod(
+      TensorHandle tensor,
       int axis = -1,
       bool keepdims = false,
       int* shape_wire = nullptr
       ) {
 
-    Tensor* new_tensor = new Tensor(tensor->prod(axis, keepdims));
+    TENSOR_PROFILE_OP("prod", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->prod(axis, keepdims));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_sum(
-      Tensor* tensor,
+  TensorHandle tensor_sum(
+      TensorHandle tensor,
       int axis = -1,
       bool keepdims = false,
       int* shape_wire = nullptr
       ) {
 
-    Tensor* new_tensor = new Tensor(tensor->sum(axis, keepdims));
+    TENSOR_PROFILE_OP("sum", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->sum(axis, keepdims));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
+  TensorHandle tensor_scan(TensorHandle tensor, int op, int axis = -1, bool exclusive = false) {
+    TENSOR_PROFILE_OP("scan", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->scan(static_cast<SCAN_OP>(op), axis, exclusive));
+  }
+
+  // `*_into` write into `out`, shaped like the reduction result, and return its data
+  Real* tensor_all_into(TensorHandle out, TensorHandle tensor, int axis = -1) {
+    TENSOR_PROFILE_OP("all", tensor->rows * tensor->cols);
+    Shape shape = tensor->reduction_shape(axis, false);
+    if (prepare_out(out, shape.rows, shape.cols, { tensor })) {
+      tensor->all_into(*out, axis);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_any_into(TensorHandle out, TensorHandle tensor, int axis = -1) {
+    TENSOR_PROFILE_OP("any", tensor->rows * tensor->cols);
+    Shape shape = tensor->reduction_shape(axis, false);
+    if (prepare_out(out, shape.rows, shape.cols, { tensor })) {
+      tensor->any_into(*out, axis);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_max_into(TensorHandle out, TensorHandle tensor, int axis = -1) {
+    TENSOR_PROFILE_OP("max", tensor->rows * tensor->cols);
+    Shape shape = tensor->reduction_shape(axis, false);
+    if (prepare_out(out, shape.rows, shape.cols, { tensor })) {
+      tensor->max_into(*out, axis);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_mean_into(TensorHandle out, TensorHandle tensor, int axis = -1) {
+    TENSOR_PROFILE_OP("mean", tensor->rows * tensor->cols);
+    Shape shape = tensor->reduction_shape(axis, false);
+    if (prepare_out(out, shape.rows, shape.cols, { tensor })) {
+      tensor->mean_into(*out, axis);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_min_into(TensorHandle out, TensorHandle tensor, int axis = -1) {
+    TENSOR_PROFILE_OP("min", tensor->rows * tensor->cols);
+    Shape shape = tensor->reduction_shape(axis, false);
+    if (prepare_out(out, shape.rows, shape.cols, { tensor })) {
+      tensor->min_into(*out, axis);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_prod_into(TensorHandle out, TensorHandle tensor, int axis = -1) {
+    TENSOR_PROFILE_OP("prod", tensor->rows * tensor->cols);
+    Shape shape = tensor->reduction_shape(axis, false);
+    if (prepare_out(out, shape.rows, shape.cols, { tensor })) {
+      tensor->prod_into(*out, axis);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_sum_into(TensorHandle out, TensorHandle tensor, int axis = -1) {
+    TENSOR_PROFILE_OP("sum", tensor->rows * tensor->cols);
+    Shape shape = tensor->reduction_shape(axis, false);
+    if (prepare_out(out, shape.rows, shape.cols, { tensor })) {
+      tensor->sum_into(*out, axis);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_arg_max_into(TensorHandle out, TensorHandle tensor, int axis = 0) {
+    TENSOR_PROFILE_OP("arg_max", tensor->rows * tensor->cols);
+    size_t rows = tensor->is1d || axis == 0 ? 1 : tensor->rows;
+    size_t cols = tensor->is1d || axis == 1 ? 1 : tensor->cols;
+    if (prepare_out(out, rows, cols, { tensor })) {
+      tensor->arg_max_into(*out, axis);
+    }
+    return out->data->data();
+  }
+
+  Real* tensor_arg_min_into(TensorHandle out, TensorHandle tensor, int axis = 0) {
+    TENSOR_PROFILE_OP("arg_min", tensor->rows * tensor->cols);
+    size_t rows = tensor->is1d || axis == 0 ? 1 : tensor->rows;
+    size_t cols = tensor->is1d || axis == 1 ? 1 : tensor->cols;
+    if (prepare_out(out, rows, cols, { tensor })) {
+      tensor->arg_min_into(*out, axis);
+    }
+    return out->data->data();
+  }
+
+  // scans keep the shape, `out` is shaped like `tensor`
+  Real* tensor_scan_into(TensorHandle out, TensorHandle tensor, int op, int axis = -1, bool exclusive = false) {
+    TENSOR_PROFILE_OP("scan", tensor->rows * tensor->cols);
+    if (prepare_out(out, tensor->rows, tensor->cols, { tensor })) {
+      tensor->scan_into(*out, static_cast<SCAN_OP>(op), axis, exclusive);
+    }
+    return out->data->data();
+  }
 }
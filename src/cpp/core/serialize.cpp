@@ -0,0 +1,352 @@
+#include "../Serialize.h"
+#include <cstring>
+
+#ifdef TENSOR_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace serialize {
+  constexpr uint8_t REAL_DTYPE = sizeof(Real) == sizeof(double) ? FLOAT64 : FLOAT32;
+
+  static size_t dtype_size(uint8_t dtype) {
+    return dtype == FLOAT64 ? sizeof(double) : sizeof(float);
+  }
+
+  size_t tensor_size(const Tensor& tensor) {
+    return align(sizeof(TensorHeader)) + tensor.data->size() * sizeof(Real);
+  }
+
+  size_t write_tensor(const Tensor& tensor, uint8_t* out) {/*{{{*/
+    const auto& vec = tensor.data_ref();
+    TensorHeader header = {};
+    std::memcpy(header.magic, "FTNS", 4);
+    header.version = VERSION;
+    header.dtype = REAL_DTYPE;
+    header.flags = tensor.is1d ? 1 : 0;
+    header.rows = static_cast<uint32_t>(tensor.rows);
+    header.cols = static_cast<uint32_t>(tensor.cols);
+    header.alignment = ALIGNMENT;
+    header.data_offset = align(sizeof(TensorHeader));
+    header.data_bytes = vec.size() * sizeof(Real);
+
+    std::memcpy(out, &header, sizeof(TensorHeader));
+    std::memset(out + sizeof(TensorHeader), 0, header.data_offset - sizeof(TensorHeader));
+    std::memcpy(out + header.data_offset, vec.data(), header.data_bytes);
+    return header.data_offset + header.data_bytes;
+  }/*}}}*/
+
+  bool read_header(const uint8_t* buffer, size_t size, TensorHeader& header) {/*{{{*/
+    if (size < sizeof(TensorHeader)) {
+      report_error("Serialized tensor is truncated");
+      return false;
+    }
+    std::memcpy(&header, buffer, sizeof(TensorHeader));
+    if (std::memcmp(header.magic, "FTNS", 4) != 0) {
+      report_error("Buffer is not a serialized tensor");
+      return false;
+    }
+    if (header.version > VERSION || header.dtype > FLOAT64) {
+      std::string message = "Unsupported tensor format version " + std::to_string(header.version) \
+                             + " dtype " + std::to_string(header.dtype);
+      report_error(message.c_str());
+      return false;
+    }
+    // the payload follows the header and is aligned for its dtype, so a
+    // mapped file can be viewed in place
+    if (header.data_offset < sizeof(TensorHeader) || header.data_offset % dtype_size(header.dtype) != 0) {
+      report_error("Serialized tensor has an invalid data offset");
+      return false;
+    }
+    uint64_t expected;
+    bool overflow = __builtin_mul_overflow(static_cast<uint64_t>(header.rows), header.cols, &expected)
+      || __builtin_mul_overflow(expected, static_cast<uint64_t>(dtype_size(header.dtype)), &expected);
+    if (overflow || header.data_bytes != expected
+        || header.data_offset > size || header.data_bytes > size - header.data_offset) {
+      report_error("Serialized tensor data does not match its shape");
+      return false;
+    }
+    return true;
+  }/*}}}*/
+
+  Tensor read_tensor(const uint8_t* buffer, size_t size) {/*{{{*/
+    TensorHeader header;
+    if (!read_header(buffer, size, header)) {
+      return Tensor(0, 0, false);
+    }
+    Tensor result(header.rows, header.cols, header.flags & 1);
+    auto& vec = (*result.data);
+    const uint8_t* payload = buffer + header.data_offset;
+
+    if (header.dtype == REAL_DTYPE) {
+      std::memcpy(vec.data(), payload, header.data_bytes);
+    } else if (header.dtype == FLOAT64) {
+      for (size_t i = 0; i < vec.size(); ++i) {
+        double value;
+        std::memcpy(&value, payload + i * sizeof(double), sizeof(double));
+        vec[i] = static_cast<Real>(value);
+      }
+    } else {
+      for (size_t i = 0; i < vec.size(); ++i) {
+        float value;
+        std::memcpy(&value, payload + i * sizeof(float), sizeof(float));
+        vec[i] = static_cast<Real>(value);
+      }
+    }
+    return result;
+  }/*}}}*/
+
+  static size_t bundle_data_offset(size_t count) {
+    return align(sizeof(BundleHeader) + count * sizeof(uint64_t));
+  }
+
+  size_t bundle_size(const Tensor* const* tensors, size_t count) {
+    size_t size = bundle_data_offset(count);
+    for (size_t i = 0; i < count; ++i) {
+      size = align(size) + tensor_size(*tensors[i]);
+    }
+    return size;
+  }
+
+  size_t write_bundle(const Tensor* const* tensors, size_t count, uint8_t* out) {/*{{{*/
+    BundleHeader header = {};
+    std::memcpy(header.magic, "FTNB", 4);
+    header.version = VERSION;
+    header.count = static_cast<uint32_t>(count);
+    header.table_offset = sizeof(BundleHeader);
+    std::memcpy(out, &header, sizeof(BundleHeader));
+
+    size_t offset = bundle_data_offset(count);
+    std::memset(out + sizeof(BundleHeader), 0, offset - sizeof(BundleHeader));
+    for (size_t i = 0; i < count; ++i) {
+      size_t start = align(offset);
+      std::memset(out + offset, 0, start - offset);
+      uint64_t entry = start;
+      std::memcpy(out + header.table_offset + i * sizeof(uint64_t), &entry, sizeof(uint64_t));
+      offset = start + write_tensor(*tensors[i], out + start);
+    }
+    return offset;
+  }/*}}}*/
+
+  static bool read_bundle_header(const uint8_t* buffer, size_t size, BundleHeader& header) {
+    if (size < sizeof(BundleHeader)) {
+      report_error("Serialized bundle is truncated");
+      return false;
+    }
+    std::memcpy(&header, buffer, sizeof(BundleHeader));
+    if (std::memcmp(header.magic, "FTNB", 4) != 0 || header.version > VERSION) {
+      report_error("Buffer is not a serialized tensor bundle");
+      return false;
+    }
+    if (header.table_offset + static_cast<uint64_t>(header.count) * sizeof(uint64_t) > size) {
+      report_error("Serialized bundle is truncated");
+      return false;
+    }
+    return true;
+  }
+
+  size_t bundle_count(const uint8_t* buffer, size_t size) {
+    BundleHeader header;
+    return read_bundle_header(buffer, size, header) ? header.count : 0;
+  }
+
+  size_t bundle_table_size(const uint8_t* buffer, size_t size) {
+    BundleHeader header;
+    return read_bundle_header(buffer, size, header)
+      ? header.table_offset + static_cast<size_t>(header.count) * sizeof(uint64_t)
+      : 0;
+  }
+
+  bool bundle_range(const uint8_t* buffer, size_t size, size_t index, size_t* start, size_t* entry_size) {/*{{{*/
+    BundleHeader header;
+    if (!read_bundle_header(buffer, size, header)) {
+      return false;
+    }
+    if (index >= header.count) {
+      std::string message = "Bundle index " + std::to_string(index) \
+                             + " out of range for " + std::to_string(header.count) + " tensors";
+      report_error(message.c_str());
+      return false;
+    }
+    uint64_t first;
+    uint64_t end = size;
+    std::memcpy(&first, buffer + header.table_offset + index * sizeof(uint64_t), sizeof(uint64_t));
+    if (index + 1 < header.count) {
+      std::memcpy(&end, buffer + header.table_offset + (index + 1) * sizeof(uint64_t), sizeof(uint64_t));
+    }
+    if (first > end || end > size) {
+      report_error("Serialized bundle is truncated");
+      return false;
+    }
+    *start = first;
+    *entry_size = end - first;
+    return true;
+  }/*}}}*/
+
+  const uint8_t* bundle_entry(const uint8_t* buffer, size_t size, size_t index, size_t* entry_size) {
+    size_t start;
+    return bundle_range(buffer, size, index, &start, entry_size) ? buffer + start : nullptr;
+  }
+}
+
+#ifdef TENSOR_MMAP
+MappedTensorFile::MappedTensorFile(const char* path) {/*{{{*/
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    std::string message = std::string("Unable to open ") + path;
+    report_error(message.c_str());
+    return;
+  }
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped != MAP_FAILED) {
+      mapping = static_cast<const uint8_t*>(mapped);
+      size = info.st_size;
+    }
+  }
+  close(fd);
+  if (!mapping) {
+    std::string message = std::string("Unable to map ") + path;
+    report_error(message.c_str());
+    return;
+  }
+  is_bundle = size >= 4 && std::memcmp(mapping, "FTNB", 4) == 0;
+}/*}}}*/
+
+MappedTensorFile::~MappedTensorFile() {
+  if (mapping) {
+    munmap(const_cast<uint8_t*>(mapping), size);
+  }
+}
+
+bool MappedTensorFile::is_open() const {
+  return mapping != nullptr;
+}
+
+size_t MappedTensorFile::count() const {
+  if (!mapping) {
+    return 0;
+  }
+  return is_bundle ? serialize::bundle_count(mapping, size) : 1;
+}
+
+const uint8_t* MappedTensorFile::entry(size_t index, size_t* entry_size) const {
+  if (is_bundle) {
+    return serialize::bundle_entry(mapping, size, index, entry_size);
+  }
+  if (index != 0) {
+    report_error("File holds a single tensor, index must be 0");
+    return nullptr;
+  }
+  *entry_size = size;
+  return mapping;
+}
+
+TensorView MappedTensorFile::view(size_t index) const {/*{{{*/
+  TensorView view = { 0, 0, false, nullptr };
+  size_t entry_size = 0;
+  const uint8_t* buffer = mapping ? entry(index, &entry_size) : nullptr;
+  serialize::TensorHeader header;
+  if (!buffer || !serialize::read_header(buffer, entry_size, header)) {
+    return view;
+  }
+  if (header.dtype != serialize::REAL_DTYPE) {
+    report_error("Stored dtype does not match Real, use load() to convert");
+    return view;
+  }
+  view.rows = header.rows;
+  view.cols = header.cols;
+  view.is1d = header.flags & 1;
+  view.data = reinterpret_cast<const Real*>(buffer + header.data_offset);
+  return view;
+}/*}}}*/
+
+Tensor MappedTensorFile::load(size_t index) const {
+  size_t entry_size = 0;
+  const uint8_t* buffer = mapping ? entry(index, &entry_size) : nullptr;
+  if (!buffer) {
+    return Tensor(0, 0, false);
+  }
+  return serialize::read_tensor(buffer, entry_size);
+}
+#endif
+
+// JS passes tensor handles as a uint32 array
+static std::vector<const Tensor*> wire_tensors(const uint32_t* instances, size_t count) {
+  std::vector<const Tensor*> tensors(count);
+  for (size_t i = 0; i < count; ++i) {
+    tensors[i] = handles::resolve(instances[i]);
+  }
+  return tensors;
+}
+
+extern "C" {
+  size_t tensor_serialized_size(TensorHandle tensor) {
+    return serialize::tensor_size(*tensor);
+  }
+
+  // Write the tensor into `out`, which must hold tensor_serialized_size bytes
+  size_t tensor_serialize(TensorHandle tensor, uint8_t* out) {
+    TENSOR_PROFILE_OP("serialize", tensor->rows * tensor->cols);
+    return serialize::write_tensor(*tensor, out);
+  }
+
+  // Validate the header, a copy of the first bytes of a `size` byte tensor,
+  // and return where the payload starts, 0 when its dtype needs converting
+  // and the whole buffer has to go through tensor_deserialize
+  size_t tensor_serialized_offset(const uint8_t* header, size_t size) {
+    serialize::TensorHeader parsed;
+    if (!serialize::read_header(header, size, parsed)) {
+      return 0;
+    }
+    return parsed.dtype == serialize::REAL_DTYPE ? parsed.data_offset : 0;
+  }
+
+  // Tensor shaped by a validated header, the caller copies the payload into its buffer
+  TensorHandle tensor_deserialize_header(const uint8_t* header, size_t size, int* shape_wire) {
+    TENSOR_PROFILE_OP("deserialize", size);
+    serialize::TensorHeader parsed;
+    TensorHandle new_tensor = TensorHandle::emplace(serialize::read_header(header, size, parsed)
+        ? Tensor(parsed.rows, parsed.cols, parsed.flags & 1)
+        : Tensor(0, 0, false));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  TensorHandle tensor_deserialize(const uint8_t* buffer, size_t size, int* shape_wire) {
+    TENSOR_PROFILE_OP("deserialize", size);
+    TensorHandle new_tensor = TensorHandle::emplace(serialize::read_tensor(buffer, size));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  size_t tensor_bundle_size(const uint32_t* instances, size_t count) {
+    return serialize::bundle_size(wire_tensors(instances, count).data(), count);
+  }
+
+  size_t tensor_bundle_serialize(const uint32_t* instances, size_t count, uint8_t* out) {
+    TENSOR_PROFILE_OP("bundle_serialize", count);
+    return serialize::write_bundle(wire_tensors(instances, count).data(), count, out);
+  }
+
+  // Bytes of the bundle header and offset table, from a copy of the header
+  size_t tensor_bundle_table_size(const uint8_t* header, size_t size) {
+    return serialize::bundle_table_size(header, size);
+  }
+
+  // `table` is a copy of the bundle header and offset table, the bundle is `size` bytes
+  size_t tensor_bundle_count(const uint8_t* table, size_t size) {
+    return serialize::bundle_count(table, size);
+  }
+
+  // Offset of a tensor in the bundle, `entry_size` receives the bytes available to it
+  size_t tensor_bundle_entry(const uint8_t* table, size_t size, size_t index, size_t* entry_size) {
+    size_t start = 0;
+    *entry_size = 0;
+    serialize::bundle_range(table, size, index, &start, entry_size);
+    return start;
+  }
+}
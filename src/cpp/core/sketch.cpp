@@ -0,0 +1,231 @@
+#include "../Sketch.h"
+
+QuantileSketch::QuantileSketch(size_t k) : k(std::max(k, MIN_CAPACITY)) {/*{{{*/
+  reset();
+  memory::object_created(state_bytes());
+}/*}}}*/
+
+QuantileSketch::~QuantileSketch() {
+  memory::object_destroyed(state_bytes());
+}
+
+size_t QuantileSketch::state_bytes() const {/*{{{*/
+  size_t items = 0;
+  for (const auto& level : levels) {
+    items += level.capacity();
+  }
+  return items * sizeof(Real) + levels.capacity() * sizeof(std::vector<Real>);
+}/*}}}*/
+
+void QuantileSketch::reset() {/*{{{*/
+  size_t old_bytes = state_bytes();
+  n = 0;
+  lo = std::numeric_limits<Real>::infinity();
+  hi = -std::numeric_limits<Real>::infinity();
+  coin = 0x9E3779B9;
+  levels.assign(1, {});
+  stored = 0;
+  limit = capacity(0);
+  memory::object_resized(old_bytes, state_bytes());
+}/*}}}*/
+
+// The top level holds k items, each one below 2/3 of the one above
+size_t QuantileSketch::capacity(size_t level) const {/*{{{*/
+  size_t depth = levels.size() - 1 - level;
+  double size = k * std::pow(2.0 / 3.0, static_cast<double>(depth));
+  return std::max(MIN_CAPACITY, static_cast<size_t>(std::ceil(size)));
+}/*}}}*/
+
+void QuantileSketch::compact(size_t level) {/*{{{*/
+  if (level + 1 == levels.size()) {
+    levels.emplace_back();
+    limit = 0;
+    for (size_t h = 0; h < levels.size(); ++h) {
+      limit += capacity(h);
+    }
+  }
+  auto& items = levels[level];
+  auto& above = levels[level + 1];
+  std::sort(items.begin(), items.end());
+  // xorshift32, the offset only has to be unpredictable to the data
+  coin ^= coin << 13;
+  coin ^= coin >> 17;
+  coin ^= coin << 5;
+  size_t pairs = items.size() / 2;
+  size_t offset = coin & 1;
+  for (size_t i = 0; i < pairs; ++i) {
+    above.push_back(items[2 * i + offset]);
+  }
+  // an odd item out stays behind
+  if (items.size() % 2) {
+    items[0] = items.back();
+    items.resize(1);
+  } else {
+    items.clear();
+  }
+  stored -= pairs;
+}/*}}}*/
+
+// Compact the lowest full levels until the items fit the capacity again
+void QuantileSketch::compress() {/*{{{*/
+  while (stored >= limit) {
+    size_t level = 0;
+    while (levels[level].size() < capacity(level)) {
+      level++;
+    }
+    compact(level);
+  }
+}/*}}}*/
+
+void QuantileSketch::push(const Real* values, size_t size) {/*{{{*/
+  size_t old_bytes = state_bytes();
+  for (size_t i = 0; i < size; ++i) {
+    Real value = values[i];
+    if (std::isnan(value)) {
+      continue;
+    }
+    lo = std::min(lo, value);
+    hi = std::max(hi, value);
+    n += 1;
+    levels[0].push_back(value);
+    if (++stored >= limit) {
+      compress();
+    }
+  }
+  memory::object_resized(old_bytes, state_bytes());
+}/*}}}*/
+
+void QuantileSketch::merge(const QuantileSketch& other) {/*{{{*/
+  if (&other == this) {
+    report_error("QuantileSketch.merge(): can't merge a sketch into itself");
+    return;
+  }
+  size_t old_bytes = state_bytes();
+  while (levels.size() < other.levels.size()) {
+    levels.emplace_back();
+  }
+  limit = 0;
+  for (size_t level = 0; level < levels.size(); ++level) {
+    limit += capacity(level);
+  }
+  for (size_t level = 0; level < other.levels.size(); ++level) {
+    const auto& items = other.levels[level];
+    levels[level].insert(levels[level].end(), items.begin(), items.end());
+  }
+  stored += other.stored;
+  n += other.n;
+  lo = std::min(lo, other.lo);
+  hi = std::max(hi, other.hi);
+  compress();
+  memory::object_resized(old_bytes, state_bytes());
+}/*}}}*/
+
+double QuantileSketch::count() const {
+  return n;
+}
+
+size_t QuantileSketch::retained() const {
+  return stored;
+}
+
+Real QuantileSketch::min() const {
+  return n ? lo : std::numeric_limits<Real>::quiet_NaN();
+}
+
+Real QuantileSketch::max() const {
+  return n ? hi : std::numeric_limits<Real>::quiet_NaN();
+}
+
+void QuantileSketch::quantiles(const Real* qs, size_t q_count, Real* out) const {/*{{{*/
+  // every retained item with its weight, sorted by value
+  std::vector<std::pair<Real, double>> items;
+  items.reserve(retained());
+  for (size_t level = 0; level < levels.size(); ++level) {
+    double weight = std::ldexp(1.0, static_cast<int>(level));
+    for (Real value : levels[level]) {
+      items.emplace_back(value, weight);
+    }
+  }
+  std::sort(items.begin(), items.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+  // weights add up to n, cumulative in place
+  double total = 0;
+  for (auto& item : items) {
+    total += item.second;
+    item.second = total;
+  }
+
+  for (size_t q = 0; q < q_count; ++q) {
+    if (!(qs[q] >= 0 && qs[q] <= 1)) {
+      report_error("QuantileSketch: quantiles must be between 0 and 1");
+      return;
+    }
+    if (items.empty()) {
+      out[q] = std::numeric_limits<Real>::quiet_NaN();
+    } else if (qs[q] == 0) {
+      out[q] = lo;
+    } else if (qs[q] == 1) {
+      out[q] = hi;
+    } else {
+      double target = qs[q] * total;
+      auto it = std::lower_bound(items.begin(), items.end(), target,
+          [](const auto& item, double weight) { return item.second < weight; });
+      out[q] = it == items.end() ? hi : it->first;
+    }
+  }
+}/*}}}*/
+
+Real QuantileSketch::rank(Real value) const {/*{{{*/
+  if (!n) {
+    return std::numeric_limits<Real>::quiet_NaN();
+  }
+  double below = 0;
+  for (size_t level = 0; level < levels.size(); ++level) {
+    double weight = std::ldexp(1.0, static_cast<int>(level));
+    for (Real item : levels[level]) {
+      below += item <= value ? weight : 0;
+    }
+  }
+  return static_cast<Real>(below / n);
+}/*}}}*/
+
+extern "C" {
+  QuantileSketch* sketch_create(size_t k) {
+    return new QuantileSketch(k);
+  }
+
+  void sketch_delete(QuantileSketch* sketch) {
+    delete sketch;
+  }
+
+  void sketch_reset(QuantileSketch* sketch) {
+    sketch->reset();
+  }
+
+  void sketch_push(QuantileSketch* sketch, const Real* values, size_t size) {
+    TENSOR_PROFILE_OP("sketch_push", size);
+    sketch->push(values, size);
+  }
+
+  void sketch_merge(QuantileSketch* sketch, QuantileSketch* other) {
+    TENSOR_PROFILE_OP("sketch_merge", other->retained());
+    sketch->merge(*other);
+  }
+
+  double sketch_count(QuantileSketch* sketch) {
+    return sketch->count();
+  }
+
+  size_t sketch_retained(QuantileSketch* sketch) {
+    return sketch->retained();
+  }
+
+  // `out` receives a value per quantile
+  void sketch_quantiles(QuantileSketch* sketch, const Real* qs, size_t q_count, Real* out) {
+    sketch->quantiles(qs, q_count, out);
+  }
+
+  Real sketch_rank(QuantileSketch* sketch, Real value) {
+    return sketch->rank(value);
+  }
+}
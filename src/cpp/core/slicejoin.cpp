@@ -3,7 +3,7 @@
 Tensor Tensor::reverse(const int axis) const {/*{{{*/
   Tensor result = deepcopy();
   auto& vec = (*result.data);
-  std::vector<float>::iterator begin = vec.begin();
+  auto begin = vec.begin();
 
   if (axis == -1) {
     std::reverse(begin, vec.end());
@@ -23,31 +23,66 @@ Tensor Tensor::reverse(const int axis) const {/*{{{*/
   return result;
 }/*}}}*/
 
+// Copy `size` tensors of one shape one after the other into `dst`
+static void stack_into(Tensor& dst, const uint32_t* instances, size_t size) {/*{{{*/
+  auto iter = dst.data->begin();
+  for (size_t i = 0; i < size; ++i) {
+    Tensor* tensor = handles::resolve(instances[i]);
+    // Dereference the shared_ptr to access the vector
+    auto& vec = (*tensor->data);
+    iter = std::copy(vec.begin(), vec.begin() + tensor->rows * tensor->cols, iter);
+  }
+}/*}}}*/
+
+// Shape of stacking the instances, every one must match the first
+static bool stack_shape(const uint32_t* instances, size_t size, size_t& rows, size_t& cols) {/*{{{*/
+  rows = 0;
+  cols = 0;
+  for (size_t i = 0; i < size; ++i) {
+    Tensor* tensor = handles::resolve(instances[i]);
+    if (i == 0) {
+      rows = tensor->rows * size;
+      cols = tensor->cols;
+    } else if (tensor->rows * size != rows || tensor->cols != cols) {
+      report_error("Tensor.stack(): every tensor must have the same shape");
+      return false;
+    }
+  }
+  return true;
+}/*}}}*/
+
 extern "C" {
-  Tensor* tensor_reverse(Tensor* tensor, int axis = -1) {
-    return new Tensor(tensor->reverse(axis));
+  TensorHandle tensor_reverse(TensorHandle tensor, int axis = -1) {
+    TENSOR_PROFILE_OP("reverse", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->reverse(axis));
+  }
+
+  TensorHandle tensor_stack(const uint32_t* instances, size_t size) {
+    TENSOR_PROFILE_OP("stack", size);
+    size_t rows;
+    size_t cols;
+    if (!stack_shape(instances, size, rows, cols)) {
+      return TensorHandle::emplace(0, 0, false);
+    }
+    TensorHandle new_tensor = TensorHandle::emplace(rows, cols, false);
+    stack_into(*new_tensor, instances, size);
+    return new_tensor;
   }
 
-  Tensor* tensor_stack(const uint32_t* instances, size_t size) {
-    bool init = true;
-    size_t rows = 0;
-    size_t cols = 0;
-    std::vector<Real>::iterator iter;
-    std::vector<Real> stack;
+  Real* tensor_stack_into(TensorHandle out, const uint32_t* instances, size_t size) {
+    TENSOR_PROFILE_OP("stack", size);
+    size_t rows;
+    size_t cols;
+    if (!stack_shape(instances, size, rows, cols)) {
+      return out->data->data();
+    }
+    std::vector<const Tensor*> inputs(size);
     for (size_t i = 0; i < size; ++i) {
-      Tensor* tensor = reinterpret_cast<Tensor*>(instances[i]);
-      if (init) {
-        rows = tensor->rows * size;
-        cols = tensor->cols;
-        stack.resize(rows * cols);
-        // Use iterators to copy - more efficient than insert
-        iter = stack.begin();
-        init = false;
-      }
-      // Dereference the shared_ptr to access the vector
-      auto& vec = (*tensor->data);
-      iter = std::copy(vec.begin(), vec.end(), iter);
+      inputs[i] = handles::resolve(instances[i]);
+    }
+    if (prepare_out(out, rows, cols, inputs.data(), size)) {
+      stack_into(*out, instances, size);
     }
-    return new Tensor(rows, cols, false, std::move(stack));
+    return out->data->data();
   }
 }
@@ -0,0 +1,237 @@
+#include "../Tensor.h"
+
+// Lanes up to this length are sorted together with a sorting network
+constexpr size_t NETWORK_MAX = 8;
+// Top-k keeps a bounded heap while k is this much smaller than the lane,
+// otherwise it partitions the whole lane with nth_element
+constexpr size_t HEAP_RATIO = 16;
+
+namespace {
+  // (value, index) ordered by value, ties broken by the lower index
+  using Entry = std::pair<Real, uint32_t>;
+
+  struct Order {
+    bool descending;
+    bool operator()(const Entry& a, const Entry& b) const {
+      if (a.first != b.first) {
+        return descending ? a.first > b.first : a.first < b.first;
+      }
+      return a.second < b.second;
+    }
+  };
+
+  // Independent 1d runs through a tensor, `count` lanes of `length`
+  // elements, `stride` apart, each lane starting `step` after the last
+  struct Lanes {
+    size_t count;
+    size_t length;
+    size_t stride;
+    size_t step;
+  };
+
+  Lanes lanes_along(const Tensor& tensor, int axis) {
+    if (tensor.is1d || axis == 1) {
+      return { tensor.rows, tensor.cols, 1, tensor.cols };
+    }
+    return { tensor.cols, tensor.rows, tensor.cols, 1 };
+  }
+
+  // Batcher odd-even merge sort comparators for `size` (a power of two) inputs
+  std::vector<std::pair<uint8_t, uint8_t>> network_pairs(size_t size) {/*{{{*/
+    std::vector<std::pair<uint8_t, uint8_t>> pairs;
+    for (size_t p = 1; p < size; p <<= 1) {
+      for (size_t k = p; k >= 1; k >>= 1) {
+        for (size_t j = k % p; j + k < size; j += 2 * k) {
+          for (size_t i = 0; i < std::min(k, size - j - k); ++i) {
+            if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+              pairs.emplace_back(i + j, i + j + k);
+            }
+          }
+        }
+      }
+    }
+    return pairs;
+  }/*}}}*/
+
+  // Sorts every lane at once: lanes are transposed so each compare-exchange
+  // is a branchless min/max loop across all lanes, which vectorizes
+  void sort_network(const Real* src, const Lanes& lanes, bool descending, Real* values, Real* indices) {/*{{{*/
+    static const std::vector<std::pair<uint8_t, uint8_t>> networks[] = {
+      network_pairs(2), network_pairs(4), network_pairs(8)
+    };
+    size_t size = lanes.length <= 2 ? 2 : lanes.length <= 4 ? 4 : 8;
+    const auto& pairs = networks[size == 2 ? 0 : size == 4 ? 1 : 2];
+    size_t count = lanes.count;
+    // descending sorts the negated keys, so ties still favour the lower index
+    Real sign = descending ? -1.0f : 1.0f;
+
+    std::vector<Real> keys(size * count, std::numeric_limits<Real>::infinity());
+    std::vector<Real> order(size * count);
+    for (size_t p = 0; p < size; ++p) {
+      std::fill(order.begin() + p * count, order.begin() + (p + 1) * count, static_cast<Real>(p));
+    }
+    for (size_t lane = 0; lane < count; ++lane) {
+      for (size_t p = 0; p < lanes.length; ++p) {
+        keys[p * count + lane] = sign * src[lane * lanes.step + p * lanes.stride];
+      }
+    }
+
+    for (const auto& pair : pairs) {
+      Real* key_a = keys.data() + pair.first * count;
+      Real* key_b = keys.data() + pair.second * count;
+      Real* index_a = order.data() + pair.first * count;
+      Real* index_b = order.data() + pair.second * count;
+      for (size_t lane = 0; lane < count; ++lane) {
+        Real ka = key_a[lane];
+        Real kb = key_b[lane];
+        Real ia = index_a[lane];
+        Real ib = index_b[lane];
+        bool swap = kb < ka || (kb == ka && ib < ia);
+        key_a[lane] = swap ? kb : ka;
+        key_b[lane] = swap ? ka : kb;
+        index_a[lane] = swap ? ib : ia;
+        index_b[lane] = swap ? ia : ib;
+      }
+    }
+
+    // padding sorts to the end, only the first `length` entries are real
+    for (size_t lane = 0; lane < count; ++lane) {
+      for (size_t p = 0; p < lanes.length; ++p) {
+        size_t out = lane * lanes.step + p * lanes.stride;
+        if (values) {
+          values[out] = sign * keys[p * count + lane];
+        }
+        if (indices) {
+          indices[out] = order[p * count + lane];
+        }
+      }
+    }
+  }/*}}}*/
+
+  void sort_lanes(const Real* src, const Lanes& lanes, bool descending, Real* values, Real* indices) {/*{{{*/
+    if (lanes.length <= 1) {
+      for (size_t lane = 0; lane < lanes.count && lanes.length; ++lane) {
+        if (values) {
+          values[lane * lanes.step] = src[lane * lanes.step];
+        }
+        if (indices) {
+          indices[lane * lanes.step] = 0.0f;
+        }
+      }
+      return;
+    }
+    if (lanes.length <= NETWORK_MAX) {
+      sort_network(src, lanes, descending, values, indices);
+      return;
+    }
+    std::vector<Entry> entries(lanes.length);
+    Order order = { descending };
+    for (size_t lane = 0; lane < lanes.count; ++lane) {
+      const Real* base = src + lane * lanes.step;
+      for (size_t p = 0; p < lanes.length; ++p) {
+        entries[p] = { base[p * lanes.stride], static_cast<uint32_t>(p) };
+      }
+      std::sort(entries.begin(), entries.end(), order);
+      for (size_t p = 0; p < lanes.length; ++p) {
+        size_t out = lane * lanes.step + p * lanes.stride;
+        if (values) {
+          values[out] = entries[p].first;
+        }
+        if (indices) {
+          indices[out] = static_cast<Real>(entries[p].second);
+        }
+      }
+    }
+  }/*}}}*/
+}
+
+Tensor Tensor::sort(int axis, bool descending) const {
+  Tensor result(rows, cols, is1d);
+  sort_lanes(data_ref().data(), lanes_along(*this, axis), descending, result.data->data(), nullptr);
+  return result;
+}
+
+Tensor Tensor::argsort(int axis, bool descending) const {
+  Tensor result(rows, cols, is1d);
+  sort_lanes(data_ref().data(), lanes_along(*this, axis), descending, nullptr, result.data->data());
+  return result;
+}
+
+// The `k` largest (or smallest) values along an axis, best first, their
+// positions along the axis are written to `indices` (same shape as the result)
+Tensor Tensor::topk(size_t k, int axis, bool largest, Tensor* indices) const {/*{{{*/
+  Lanes lanes = lanes_along(*this, axis);
+  bool along_rows = is1d || axis == 1;
+  Tensor result(along_rows ? rows : k, along_rows ? k : cols, is1d);
+  if (k > lanes.length) {
+    std::string message = "topk: k (" + std::to_string(k) + ") is larger than the axis (" \
+                           + std::to_string(lanes.length) + ")";
+    report_error(message.c_str());
+    return result;
+  }
+  if (indices->data->size() != result.data->size()) {
+    report_error("topk: indices must have the same shape as the result");
+    return result;
+  }
+  auto& values = (*result.data);
+  auto& positions = (*indices->data);
+  // lanes of the (k long) output, laid out like the input lanes
+  Lanes out = along_rows ? Lanes{ rows, k, 1, k } : Lanes{ cols, k, cols, 1 };
+  const Real* src = data_ref().data();
+  Order better = { largest };
+  std::vector<Entry> entries;
+  entries.reserve(k * HEAP_RATIO <= lanes.length ? k : lanes.length);
+
+  for (size_t lane = 0; lane < lanes.count; ++lane) {
+    const Real* base = src + lane * lanes.step;
+    entries.clear();
+    if (k && k * HEAP_RATIO <= lanes.length) {
+      // bounded heap, front is the worst kept entry, most values are
+      // rejected by a single compare against it
+      for (size_t p = 0; p < lanes.length; ++p) {
+        Entry entry = { base[p * lanes.stride], static_cast<uint32_t>(p) };
+        if (entries.size() < k) {
+          entries.push_back(entry);
+          std::push_heap(entries.begin(), entries.end(), better);
+        } else if (better(entry, entries.front())) {
+          std::pop_heap(entries.begin(), entries.end(), better);
+          entries.back() = entry;
+          std::push_heap(entries.begin(), entries.end(), better);
+        }
+      }
+      std::sort_heap(entries.begin(), entries.end(), better);
+    } else {
+      for (size_t p = 0; p < lanes.length; ++p) {
+        entries.emplace_back(base[p * lanes.stride], static_cast<uint32_t>(p));
+      }
+      std::nth_element(entries.begin(), entries.begin() + k, entries.end(), better);
+      std::sort(entries.begin(), entries.begin() + k, better);
+    }
+    for (size_t p = 0; p < k; ++p) {
+      size_t index = lane * out.step + p * out.stride;
+      values[index] = entries[p].first;
+      positions[index] = static_cast<Real>(entries[p].second);
+    }
+  }
+  return result;
+}/*}}}*/
+
+extern "C" {
+  TensorHandle tensor_sort(TensorHandle tensor, int axis, bool descending) {
+    TENSOR_PROFILE_OP("sort", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->sort(axis, descending));
+  }
+
+  TensorHandle tensor_argsort(TensorHandle tensor, int axis, bool descending) {
+    TENSOR_PROFILE_OP("argsort", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->argsort(axis, descending));
+  }
+
+  // `indices` must be preallocated with the shape of the result
+  TensorHandle tensor_topk(TensorHandle tensor, size_t k, int axis, bool largest, TensorHandle indices, int* shape_wire) {
+    TENSOR_PROFILE_OP("topk", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->topk(k, axis, largest, indices));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+}
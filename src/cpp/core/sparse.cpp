@@ -0,0 +1,331 @@
+#include "../Sparse.h"
+
+SparseTensor::SparseTensor(size_t rows, size_t cols) : nrows(rows), ncols(cols), indptr(rows + 1, 0) {
+  memory::object_created(state_bytes());
+}
+
+SparseTensor::SparseTensor(const Tensor& dense, Real tolerance)
+  : nrows(dense.rows), ncols(dense.cols), indptr(dense.rows + 1, 0) {/*{{{*/
+  const auto& vec = dense.data_ref();
+  size_t count = 0;
+  for (Real value : vec) {
+    count += std::abs(value) > tolerance;
+  }
+  indices.reserve(count);
+  values.reserve(count);
+  for (size_t i = 0; i < nrows; ++i) {
+    const Real* row = vec.data() + i * ncols;
+    for (size_t j = 0; j < ncols; ++j) {
+      if (std::abs(row[j]) > tolerance) {
+        indices.push_back(j);
+        values.push_back(row[j]);
+      }
+    }
+    indptr[i + 1] = indices.size();
+  }
+  memory::object_created(state_bytes());
+}/*}}}*/
+
+bool SparseTensor::check_coo(size_t rows, size_t cols, const Tensor& row_indices, const Tensor& col_indices, const Tensor& values) {/*{{{*/
+  size_t count = values.rows * values.cols;
+  if (row_indices.rows * row_indices.cols != count || col_indices.rows * col_indices.cols != count) {
+    report_error("SparseTensor: row indices, column indices and values must have the same length");
+    return false;
+  }
+  const auto& r = row_indices.data_ref();
+  const auto& c = col_indices.data_ref();
+  for (size_t k = 0; k < count; ++k) {
+    if (!(r[k] >= 0 && r[k] < rows && r[k] == std::floor(r[k]) \
+        && c[k] >= 0 && c[k] < cols && c[k] == std::floor(c[k]))) {
+      report_error("SparseTensor: index out of range");
+      return false;
+    }
+  }
+  return true;
+}/*}}}*/
+
+SparseTensor::SparseTensor(size_t rows, size_t cols, const Tensor& row_indices, const Tensor& col_indices, const Tensor& values_in)
+  : nrows(rows), ncols(cols), indptr(rows + 1, 0) {/*{{{*/
+  // validated before counting the object, report_error may throw
+  bool valid = check_coo(rows, cols, row_indices, col_indices, values_in);
+  memory::object_created(state_bytes());
+  if (!valid) {
+    return;
+  }
+  size_t count = values_in.rows * values_in.cols;
+  const auto& r = row_indices.data_ref();
+  const auto& c = col_indices.data_ref();
+
+  // two counting sort passes, by column then (stable) by row, order the
+  // triplets by (row, column) in O(nnz + rows + cols)
+  std::vector<uint32_t> by_col(count);
+  std::vector<uint32_t> offsets(ncols + 1, 0);
+  for (size_t k = 0; k < count; ++k) {
+    offsets[static_cast<size_t>(c[k]) + 1]++;
+  }
+  for (size_t j = 0; j < ncols; ++j) {
+    offsets[j + 1] += offsets[j];
+  }
+  for (size_t k = 0; k < count; ++k) {
+    by_col[offsets[static_cast<size_t>(c[k])]++] = k;
+  }
+  for (size_t k = 0; k < count; ++k) {
+    indptr[static_cast<size_t>(r[k]) + 1]++;
+  }
+  for (size_t i = 0; i < nrows; ++i) {
+    indptr[i + 1] += indptr[i];
+  }
+  std::vector<uint32_t> order(count);
+  std::vector<uint32_t> next(indptr.begin(), indptr.end() - 1);
+  for (uint32_t k : by_col) {
+    order[next[static_cast<size_t>(r[k])]++] = k;
+  }
+
+  // merge duplicates, each row is now sorted by column
+  size_t old_bytes = state_bytes();
+  const auto& v = values_in.data_ref();
+  indices.reserve(count);
+  values.reserve(count);
+  size_t begin = 0;
+  for (size_t i = 0; i < nrows; ++i) {
+    size_t end = indptr[i + 1];
+    for (size_t p = begin; p < end; ++p) {
+      uint32_t col = static_cast<uint32_t>(c[order[p]]);
+      if (p > begin && indices.back() == col) {
+        values.back() += v[order[p]];
+      } else {
+        indices.push_back(col);
+        values.push_back(v[order[p]]);
+      }
+    }
+    begin = end;
+    indptr[i + 1] = indices.size();
+  }
+  memory::object_resized(old_bytes, state_bytes());
+}/*}}}*/
+
+SparseTensor::SparseTensor(const SparseTensor& other)
+  : nrows(other.nrows), ncols(other.ncols), indptr(other.indptr), indices(other.indices), values(other.values) {
+  memory::object_created(state_bytes());
+}
+
+SparseTensor::~SparseTensor() {
+  memory::object_destroyed(state_bytes());
+}
+
+size_t SparseTensor::state_bytes() const {
+  return indptr.capacity() * sizeof(uint32_t) \
+    + indices.capacity() * sizeof(uint32_t) \
+    + values.capacity() * sizeof(Real);
+}
+
+Tensor SparseTensor::to_dense() const {/*{{{*/
+  Tensor result(nrows, ncols, false);
+  auto& vec = *result.data;
+  for (size_t i = 0; i < nrows; ++i) {
+    Real* row = vec.data() + i * ncols;
+    for (size_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+      row[indices[p]] = values[p];
+    }
+  }
+  return result;
+}/*}}}*/
+
+Tensor SparseTensor::spmv(const Tensor& vec) const {/*{{{*/
+  if (vec.rows * vec.cols != ncols || !(vec.is1d || vec.cols == 1)) {
+    report_error("SparseTensor.spmv(): expects a 1d tensor or column with one value per column");
+    return Tensor(0, 0, false);
+  }
+  // a column in gives a column out
+  Tensor result(vec.is1d ? 1 : nrows, vec.is1d ? nrows : 1, vec.is1d);
+  const Real* x = vec.data_ref().data();
+  Real* out = result.data->data();
+  for (size_t i = 0; i < nrows; ++i) {
+    Real sum = 0;
+    for (size_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+      sum += values[p] * x[indices[p]];
+    }
+    out[i] = sum;
+  }
+  return result;
+}/*}}}*/
+
+Tensor SparseTensor::spmm(const Tensor& dense) const {/*{{{*/
+  if (dense.is1d) {
+    return spmv(dense);
+  }
+  if (dense.rows != ncols) {
+    report_error("SparseTensor.spmm(): dense tensor rows must match the sparse columns");
+    return Tensor(0, 0, false);
+  }
+  size_t k = dense.cols;
+  Tensor result(nrows, k, false);
+  const Real* b = dense.data_ref().data();
+  Real* out = result.data->data();
+  // each nonzero adds a scaled row of `dense`, a contiguous axpy
+  for (size_t i = 0; i < nrows; ++i) {
+    Real* out_row = out + i * k;
+    for (size_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+      Real value = values[p];
+      const Real* b_row = b + static_cast<size_t>(indices[p]) * k;
+      for (size_t j = 0; j < k; ++j) {
+        out_row[j] += value * b_row[j];
+      }
+    }
+  }
+  return result;
+}/*}}}*/
+
+SparseTensor SparseTensor::transpose() const {/*{{{*/
+  SparseTensor result(ncols, nrows);
+  size_t old_bytes = result.state_bytes();
+  auto& ptr = result.indptr;
+  for (uint32_t col : indices) {
+    ptr[col + 1]++;
+  }
+  for (size_t j = 0; j < ncols; ++j) {
+    ptr[j + 1] += ptr[j];
+  }
+  result.indices.resize(nnz());
+  result.values.resize(nnz());
+  // walking rows in order keeps every output row sorted
+  std::vector<uint32_t> next(ptr.begin(), ptr.end() - 1);
+  for (size_t i = 0; i < nrows; ++i) {
+    for (size_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+      uint32_t dst = next[indices[p]]++;
+      result.indices[dst] = i;
+      result.values[dst] = values[p];
+    }
+  }
+  memory::object_resized(old_bytes, result.state_bytes());
+  return result;
+}/*}}}*/
+
+SparseTensor SparseTensor::scale(Real factor) const {
+  SparseTensor result(*this);
+  for (Real& value : result.values) {
+    value *= factor;
+  }
+  return result;
+}
+
+bool SparseTensor::check_row_factors(const Tensor& factors) const {
+  if (factors.rows * factors.cols != nrows) {
+    report_error("SparseTensor.scale_rows(): expects one factor per row");
+    return false;
+  }
+  return true;
+}
+
+bool SparseTensor::check_col_factors(const Tensor& factors) const {
+  if (factors.rows * factors.cols != ncols) {
+    report_error("SparseTensor.scale_cols(): expects one factor per column");
+    return false;
+  }
+  return true;
+}
+
+SparseTensor SparseTensor::scale_rows(const Tensor& factors) const {/*{{{*/
+  if (!check_row_factors(factors)) {
+    return SparseTensor(nrows, ncols);
+  }
+  SparseTensor result(*this);
+  const auto& f = factors.data_ref();
+  for (size_t i = 0; i < nrows; ++i) {
+    for (size_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+      result.values[p] *= f[i];
+    }
+  }
+  return result;
+}/*}}}*/
+
+SparseTensor SparseTensor::scale_cols(const Tensor& factors) const {/*{{{*/
+  if (!check_col_factors(factors)) {
+    return SparseTensor(nrows, ncols);
+  }
+  SparseTensor result(*this);
+  const auto& f = factors.data_ref();
+  for (size_t p = 0; p < nnz(); ++p) {
+    result.values[p] *= f[indices[p]];
+  }
+  return result;
+}/*}}}*/
+
+extern "C" {
+  SparseTensor* sparse_from_dense(TensorHandle dense, Real tolerance) {
+    TENSOR_PROFILE_OP("sparse_from_dense", dense->rows * dense->cols);
+    return new SparseTensor(*dense, tolerance);
+  }
+
+  SparseTensor* sparse_from_coo(size_t rows, size_t cols, TensorHandle row_indices, TensorHandle col_indices, TensorHandle values) {
+    // checked before allocating, report_error doesn't return to free it
+    if (!SparseTensor::check_coo(rows, cols, *row_indices, *col_indices, *values)) {
+      return nullptr;
+    }
+    TENSOR_PROFILE_OP("sparse_from_coo", values->rows * values->cols);
+    return new SparseTensor(rows, cols, *row_indices, *col_indices, *values);
+  }
+
+  void sparse_delete(SparseTensor* sparse) {
+    delete sparse;
+  }
+
+  size_t sparse_rows(SparseTensor* sparse) {
+    return sparse->rows();
+  }
+
+  size_t sparse_cols(SparseTensor* sparse) {
+    return sparse->cols();
+  }
+
+  size_t sparse_nnz(SparseTensor* sparse) {
+    return sparse->nnz();
+  }
+
+  TensorHandle sparse_to_dense(SparseTensor* sparse, int* shape_wire) {
+    TENSOR_PROFILE_OP("sparse_to_dense", sparse->rows() * sparse->cols());
+    TensorHandle new_tensor = TensorHandle::emplace(sparse->to_dense());
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  TensorHandle sparse_spmv(SparseTensor* sparse, TensorHandle vec, int* shape_wire) {
+    TENSOR_PROFILE_OP("spmv", sparse->nnz());
+    TensorHandle new_tensor = TensorHandle::emplace(sparse->spmv(*vec));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  TensorHandle sparse_spmm(SparseTensor* sparse, TensorHandle dense, int* shape_wire) {
+    TENSOR_PROFILE_OP("spmm", sparse->nnz() * dense->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(sparse->spmm(*dense));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  SparseTensor* sparse_transpose(SparseTensor* sparse) {
+    TENSOR_PROFILE_OP("sparse_transpose", sparse->nnz());
+    return new SparseTensor(sparse->transpose());
+  }
+
+  SparseTensor* sparse_scale(SparseTensor* sparse, Real factor) {
+    TENSOR_PROFILE_OP("sparse_scale", sparse->nnz());
+    return new SparseTensor(sparse->scale(factor));
+  }
+
+  SparseTensor* sparse_scale_rows(SparseTensor* sparse, TensorHandle factors) {
+    if (!sparse->check_row_factors(*factors)) {
+      return nullptr;
+    }
+    TENSOR_PROFILE_OP("sparse_scale_rows", sparse->nnz());
+    return new SparseTensor(sparse->scale_rows(*factors));
+  }
+
+  SparseTensor* sparse_scale_cols(SparseTensor* sparse, TensorHandle factors) {
+    if (!sparse->check_col_factors(*factors)) {
+      return nullptr;
+    }
+    TENSOR_PROFILE_OP("sparse_scale_cols", sparse->nnz());
+    return new SparseTensor(sparse->scale_cols(*factors));
+  }
+}
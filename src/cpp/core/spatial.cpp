@@ -0,0 +1,346 @@
+#include "../SpatialIndex.h"
+#include <numeric>
+
+KDTree::KDTree(const Tensor& points, size_t leaf_size) : leaf_size(std::max<size_t>(leaf_size, 1)) {
+  memory::object_created(0);
+  build(points);
+}
+
+KDTree::~KDTree() {
+  memory::object_destroyed(state_bytes());
+}
+
+size_t KDTree::state_bytes() const {
+  return points.capacity() * sizeof(Real) \
+    + order.capacity() * sizeof(uint32_t) \
+    + nodes.capacity() * sizeof(Node);
+}
+
+size_t KDTree::size() const {
+  return count;
+}
+
+size_t KDTree::dims() const {
+  return ndims;
+}
+
+bool KDTree::check_points(const Tensor& input, bool same_size) const {/*{{{*/
+  if (input.cols != 2 && input.cols != 3) {
+    report_error("KDTree: points must be an Nx2 or Nx3 tensor");
+    return false;
+  }
+  if (same_size && (input.rows != count || input.cols != ndims)) {
+    report_error("KDTree: refit expects the same points the tree was built with");
+    return false;
+  }
+  return true;
+}/*}}}*/
+
+void KDTree::build(const Tensor& input) {/*{{{*/
+  if (!check_points(input, false)) {
+    return;
+  }
+  size_t old_bytes = state_bytes();
+  count = input.rows;
+  ndims = input.cols;
+  points.assign(input.data_ref().begin(), input.data_ref().end());
+  order.resize(count);
+  std::iota(order.begin(), order.end(), 0);
+  nodes.clear();
+  nodes.reserve(2 * (count / leaf_size + 1));
+
+  if (count) {
+    // the root box drives the first splits, children are fit tightly afterwards
+    Bounds bounds = input.get_bounds();
+    Real lo[3] = { bounds.xmin, bounds.ymin, 0.0f };
+    Real hi[3] = { bounds.xmax, bounds.ymax, 0.0f };
+    if (ndims == 3) {
+      lo[2] = hi[2] = points[2];
+      for (size_t i = 0; i < count; ++i) {
+        lo[2] = std::min(lo[2], points[i * 3 + 2]);
+        hi[2] = std::max(hi[2], points[i * 3 + 2]);
+      }
+    }
+    build_node(0, count, lo, hi);
+    fit_node(0);
+  }
+  // leaves of a single point, or of coincident points, have no extent, the
+  // root box keeps the reference above 0 unless every point coincides
+  built_extent = count ? std::max(leaf_extent(), box_extent(nodes[0])) : 0.0f;
+  memory::object_resized(old_bytes, state_bytes());
+}/*}}}*/
+
+uint32_t KDTree::build_node(uint32_t begin, uint32_t end, const Real* lo, const Real* hi) {/*{{{*/
+  uint32_t index = nodes.size();
+  nodes.push_back({ {}, {}, begin, end, 0, 0 });
+  if (end - begin <= leaf_size) {
+    return index;
+  }
+
+  // split the widest side at the median
+  size_t axis = 0;
+  for (size_t d = 1; d < ndims; ++d) {
+    if (hi[d] - lo[d] > hi[axis] - lo[axis]) {
+      axis = d;
+    }
+  }
+  uint32_t mid = begin + (end - begin) / 2;
+  std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+      [&](uint32_t a, uint32_t b) { return points[a * ndims + axis] < points[b * ndims + axis]; });
+  Real split = points[order[mid] * ndims + axis];
+
+  Real left_hi[3] = { hi[0], hi[1], hi[2] };
+  Real right_lo[3] = { lo[0], lo[1], lo[2] };
+  left_hi[axis] = split;
+  right_lo[axis] = split;
+  // nodes may reallocate while recursing, only hold on to the index
+  uint32_t left = build_node(begin, mid, lo, left_hi);
+  uint32_t right = build_node(mid, end, right_lo, hi);
+  nodes[index].left = left;
+  nodes[index].right = right;
+  return index;
+}/*}}}*/
+
+void KDTree::fit_node(uint32_t index) {/*{{{*/
+  Node& node = nodes[index];
+  if (!node.left) {
+    for (size_t d = 0; d < ndims; ++d) {
+      node.lo[d] = std::numeric_limits<Real>::infinity();
+      node.hi[d] = -std::numeric_limits<Real>::infinity();
+    }
+    for (uint32_t i = node.begin; i < node.end; ++i) {
+      const Real* point = points.data() + order[i] * ndims;
+      for (size_t d = 0; d < ndims; ++d) {
+        node.lo[d] = std::min(node.lo[d], point[d]);
+        node.hi[d] = std::max(node.hi[d], point[d]);
+      }
+    }
+    return;
+  }
+  fit_node(node.left);
+  fit_node(node.right);
+  const Node& left = nodes[node.left];
+  const Node& right = nodes[node.right];
+  for (size_t d = 0; d < ndims; ++d) {
+    node.lo[d] = std::min(left.lo[d], right.lo[d]);
+    node.hi[d] = std::max(left.hi[d], right.hi[d]);
+  }
+}/*}}}*/
+
+// Summed side lengths of a box
+Real KDTree::box_extent(const Node& node) const {
+  Real extent = 0.0f;
+  for (size_t d = 0; d < ndims; ++d) {
+    extent += node.hi[d] - node.lo[d];
+  }
+  return extent;
+}
+
+// Summed side lengths of the leaf boxes, grows as refits make leaves overlap
+Real KDTree::leaf_extent() const {
+  Real extent = 0.0f;
+  for (const Node& node : nodes) {
+    if (!node.left) {
+      extent += box_extent(node);
+    }
+  }
+  return extent;
+}
+
+bool KDTree::refit(const Tensor& input) {/*{{{*/
+  if (!check_points(input, true)) {
+    return false;
+  }
+  points.assign(input.data_ref().begin(), input.data_ref().end());
+  if (!count) {
+    return false;
+  }
+  fit_node(0);
+  // built on coincident points there is nothing to compare against, rebuild
+  // once they spread out
+  bool drifted = built_extent > 0 ? leaf_extent() > built_extent * REBUILD_RATIO : box_extent(nodes[0]) > 0;
+  if (drifted) {
+    build(input);
+    return true;
+  }
+  return false;
+}/*}}}*/
+
+// Squared distance from `point` to the node's box, 0 when inside
+Real KDTree::box_distance(const Node& node, const Real* point) const {
+  Real dist = 0.0f;
+  for (size_t d = 0; d < ndims; ++d) {
+    Real diff = std::max(node.lo[d] - point[d], Real(0.0f)) + std::max(point[d] - node.hi[d], Real(0.0f));
+    dist += diff * diff;
+  }
+  return dist;
+}
+
+// `heap` is a max-heap on distance holding the best candidates so far
+void KDTree::search_knn(uint32_t index, const Real* point, size_t k, std::vector<Candidate>& heap) const {/*{{{*/
+  const Node& node = nodes[index];
+  if (heap.size() == k && box_distance(node, point) >= heap.front().first) {
+    return;
+  }
+  if (!node.left) {
+    for (uint32_t i = node.begin; i < node.end; ++i) {
+      const Real* other = points.data() + order[i] * ndims;
+      Real dist = 0.0f;
+      for (size_t d = 0; d < ndims; ++d) {
+        dist += (other[d] - point[d]) * (other[d] - point[d]);
+      }
+      if (heap.size() < k) {
+        heap.emplace_back(dist, order[i]);
+        std::push_heap(heap.begin(), heap.end());
+      } else if (dist < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = { dist, order[i] };
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+    return;
+  }
+  // nearer child first, so the far one is more likely to be pruned
+  uint32_t near = node.left;
+  uint32_t far = node.right;
+  if (box_distance(nodes[far], point) < box_distance(nodes[near], point)) {
+    std::swap(near, far);
+  }
+  search_knn(near, point, k, heap);
+  search_knn(far, point, k, heap);
+}/*}}}*/
+
+void KDTree::search_radius(uint32_t index, const Real* point, Real radius_sq, std::vector<Candidate>& found) const {/*{{{*/
+  const Node& node = nodes[index];
+  if (box_distance(node, point) > radius_sq) {
+    return;
+  }
+  if (!node.left) {
+    for (uint32_t i = node.begin; i < node.end; ++i) {
+      const Real* other = points.data() + order[i] * ndims;
+      Real dist = 0.0f;
+      for (size_t d = 0; d < ndims; ++d) {
+        dist += (other[d] - point[d]) * (other[d] - point[d]);
+      }
+      if (dist <= radius_sq) {
+        found.emplace_back(dist, order[i]);
+      }
+    }
+    return;
+  }
+  search_radius(node.left, point, radius_sq, found);
+  search_radius(node.right, point, radius_sq, found);
+}/*}}}*/
+
+Tensor KDTree::knn(const Tensor& queries, size_t k, Tensor* distances) const {/*{{{*/
+  Tensor result(queries.rows, k, false);
+  if (queries.cols != ndims) {
+    report_error("KDTree: queries must have the same columns as the points");
+    return result;
+  }
+  if (distances->rows != queries.rows || distances->cols != k) {
+    report_error("KDTree: distances must be a (queries x k) tensor");
+    return result;
+  }
+  auto& indices = (*result.data);
+  auto& dists = (*distances->data);
+  std::fill(indices.begin(), indices.end(), -1.0f);
+  std::fill(dists.begin(), dists.end(), -1.0f);
+  if (!k || !count) {
+    return result;
+  }
+
+  std::vector<Candidate> heap;
+  heap.reserve(k);
+  const auto& query_data = queries.data_ref();
+  for (size_t q = 0; q < queries.rows; ++q) {
+    heap.clear();
+    search_knn(0, query_data.data() + q * ndims, k, heap);
+    std::sort_heap(heap.begin(), heap.end());
+    for (size_t i = 0; i < heap.size(); ++i) {
+      indices[q * k + i] = heap[i].second;
+      dists[q * k + i] = std::sqrt(heap[i].first);
+    }
+  }
+  return result;
+}/*}}}*/
+
+Tensor KDTree::radius(const Tensor& queries, Real radius, size_t max_results, Tensor* distances) const {/*{{{*/
+  Tensor result(queries.rows, max_results, false);
+  if (queries.cols != ndims) {
+    report_error("KDTree: queries must have the same columns as the points");
+    return result;
+  }
+  if (distances->rows != queries.rows || distances->cols != max_results) {
+    report_error("KDTree: distances must be a (queries x max_results) tensor");
+    return result;
+  }
+  auto& indices = (*result.data);
+  auto& dists = (*distances->data);
+  std::fill(indices.begin(), indices.end(), -1.0f);
+  std::fill(dists.begin(), dists.end(), -1.0f);
+  if (!max_results || !count) {
+    return result;
+  }
+
+  std::vector<Candidate> found;
+  const auto& query_data = queries.data_ref();
+  for (size_t q = 0; q < queries.rows; ++q) {
+    found.clear();
+    search_radius(0, query_data.data() + q * ndims, radius * radius, found);
+    size_t n = std::min(max_results, found.size());
+    std::partial_sort(found.begin(), found.begin() + n, found.end());
+    for (size_t i = 0; i < n; ++i) {
+      indices[q * max_results + i] = found[i].second;
+      dists[q * max_results + i] = std::sqrt(found[i].first);
+    }
+  }
+  return result;
+}/*}}}*/
+
+extern "C" {
+  KDTree* kdtree_create(TensorHandle points, size_t leaf_size) {
+    TENSOR_PROFILE_OP("kdtree_create", points->rows);
+    return new KDTree(*points, leaf_size);
+  }
+
+  void kdtree_delete(KDTree* tree) {
+    delete tree;
+  }
+
+  void kdtree_build(KDTree* tree, TensorHandle points) {
+    TENSOR_PROFILE_OP("kdtree_build", points->rows);
+    tree->build(*points);
+  }
+
+  // Returns true when the points moved too far and the tree was rebuilt
+  bool kdtree_refit(KDTree* tree, TensorHandle points) {
+    TENSOR_PROFILE_OP("kdtree_refit", points->rows);
+    return tree->refit(*points);
+  }
+
+  size_t kdtree_size(KDTree* tree) {
+    return tree->size();
+  }
+
+  TensorHandle kdtree_knn(KDTree* tree, TensorHandle queries, size_t k, TensorHandle distances, int* shape_wire) {
+    TENSOR_PROFILE_OP("kdtree_knn", queries->rows);
+    TensorHandle new_tensor = TensorHandle::emplace(tree->knn(*queries, k, distances));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  TensorHandle kdtree_radius(
+      KDTree* tree,
+      TensorHandle queries,
+      Real radius,
+      size_t max_results,
+      TensorHandle distances,
+      int* shape_wire
+      ) {
+    TENSOR_PROFILE_OP("kdtree_radius", queries->rows);
+    TensorHandle new_tensor = TensorHandle::emplace(tree->radius(*queries, radius, max_results, distances));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+}
@@ -0,0 +1,232 @@
+#include <iterator>
+#include "../Tensor.h"
+
+// Bin of `value`, `scale` is bins / (high - low), `high` itself goes in the
+// last bin. Returns `bins` for values outside the range and NaN. The offset
+// is taken in double, high - low may not fit in a float.
+static inline size_t bin_of(Real value, Real low, Real high, double scale, size_t bins) {
+  if (!(value >= low && value <= high)) {
+    return bins;
+  }
+  size_t bin = static_cast<size_t>((static_cast<double>(value) - low) * scale);
+  return bin < bins ? bin : bins - 1;
+}
+
+Tensor Tensor::histogram(size_t bins, Real low, Real high, int axis) const {/*{{{*/
+  if (bins == 0) {
+    report_error("Tensor.histogram(): expects at least one bin");
+    return Tensor(1, 1, true);
+  }
+  if (axis < -1 || axis > 1) {
+    report_error("Axis must be -1 (flat), 0 (column-wise) or 1 (row-wise)");
+    return Tensor(1, 1, true);
+  }
+  const Real* src = data_ref().data();
+  size_t size = rows * cols;
+  bool auto_range = low != low && high != high;
+  if (!auto_range && !(low < high && std::isfinite(low) && std::isfinite(high))) {
+    report_error("Tensor.histogram(): range must be [low, high] with finite low < high");
+    return Tensor(1, 1, true);
+  }
+  if (auto_range) {
+    low = INF;
+    high = -INF;
+    for (size_t i = 0; i < size; ++i) {
+      // ±inf would stretch the range over every finite value, NaN fails
+      // the comparison as well
+      bool finite = std::abs(src[i]) < INF;
+      low = finite & (src[i] < low) ? src[i] : low;
+      high = finite & (src[i] > high) ? src[i] : high;
+    }
+    if (!(low < high)) {
+      // a single value (or none), center it in the range like numpy
+      low = low == INF ? 0 : low - Real(0.5);
+      high = low + 1;
+    }
+  }
+  double scale = bins / (static_cast<double>(high) - low);
+
+  if (axis == 0) {
+    // row sweep, every row adds to one count per column
+    Tensor result(bins, cols, false);
+    Real* out = result.data->data();
+    for (size_t i = 0; i < rows; ++i) {
+      const Real* row = src + i * cols;
+      for (size_t j = 0; j < cols; ++j) {
+        size_t bin = bin_of(row[j], low, high, scale, bins);
+        if (bin < bins) {
+          out[bin * cols + j] += 1;
+        }
+      }
+    }
+    return result;
+  }
+  size_t count = axis == 1 ? rows : 1;
+  size_t length = axis == 1 ? cols : size;
+  Tensor result(count, bins, axis != 1);
+  Real* out = result.data->data();
+  for (size_t i = 0; i < count; ++i) {
+    const Real* x = src + i * length;
+    Real* o = out + i * bins;
+    for (size_t j = 0; j < length; ++j) {
+      size_t bin = bin_of(x[j], low, high, scale, bins);
+      if (bin < bins) {
+        o[bin] += 1;
+      }
+    }
+  }
+  return result;
+}/*}}}*/
+
+Tensor Tensor::bincount(size_t min_length, const Real* weights, size_t weights_size) const {/*{{{*/
+  const Real* src = data_ref().data();
+  size_t size = rows * cols;
+  if (weights_size && weights_size != size) {
+    report_error("Tensor.bincount(): weights must have a value per element");
+    return Tensor(1, min_length, true);
+  }
+  size_t length = min_length;
+  for (size_t i = 0; i < size; ++i) {
+    if (!(src[i] >= 0) || src[i] != std::floor(src[i])) {
+      report_error("Tensor.bincount(): expects non-negative integer values");
+      return Tensor(1, min_length, true);
+    }
+    length = std::max(length, static_cast<size_t>(src[i]) + 1);
+  }
+  Tensor result(1, length, true);
+  Real* out = result.data->data();
+  for (size_t i = 0; i < size; ++i) {
+    out[static_cast<size_t>(src[i])] += weights_size ? weights[i] : 1;
+  }
+  return result;
+}/*}}}*/
+
+// Quantiles of `values` (reordered in place) into `out`, `order` lists the
+// quantiles ascending so each selection only partitions what is left
+static void select_quantiles(
+    std::vector<Real>& values,
+    const Real* qs,
+    const std::vector<size_t>& order,
+    Real* out,
+    size_t out_step
+    ) {/*{{{*/
+  size_t n = values.size();
+  if (n == 0) {
+    for (size_t q : order) {
+      out[q * out_step] = std::numeric_limits<Real>::quiet_NaN();
+    }
+    return;
+  }
+  auto begin = values.begin();
+  size_t done = 0;
+  for (size_t q : order) {
+    double position = qs[q] * (n - 1);
+    size_t k = static_cast<size_t>(position);
+    Real fraction = static_cast<Real>(position - k);
+    // nothing before `done` is larger than what follows it, so the next
+    // selection only partitions the rest
+    std::nth_element(begin + done, begin + k, values.end());
+    done = k;
+    Real lower = values[k];
+    Real upper = k + 1 < n ? *std::min_element(begin + k + 1, values.end()) : lower;
+    out[q * out_step] = lower + (upper - lower) * fraction;
+  }
+}/*}}}*/
+
+Tensor Tensor::quantile(const Real* qs, size_t q_count, int axis, bool keepdims) const {/*{{{*/
+  if (axis < -1 || axis > 1) {
+    report_error("Axis must be -1 (flat), 0 (column-wise) or 1 (row-wise)");
+    return Tensor(1, 1, true);
+  }
+  for (size_t q = 0; q < q_count; ++q) {
+    if (!(qs[q] >= 0 && qs[q] <= 1)) {
+      report_error("Tensor.quantile(): quantiles must be between 0 and 1");
+      return Tensor(1, 1, true);
+    }
+  }
+  std::vector<size_t> order(q_count);
+  for (size_t q = 0; q < q_count; ++q) {
+    order[q] = q;
+  }
+  std::sort(order.begin(), order.end(), [qs](size_t a, size_t b) { return qs[a] < qs[b]; });
+
+  Tensor result = q_count == 1 ? reduction_result(axis, keepdims)
+    : axis == 0 ? Tensor(q_count, cols, false)
+    : axis == 1 ? Tensor(rows, q_count, false)
+    : Tensor(1, q_count, true);
+  const Real* src = data_ref().data();
+  Real* out = result.data->data();
+  std::vector<Real> values;
+
+  if (axis == 0) {
+    values.reserve(rows);
+    for (size_t j = 0; j < cols; ++j) {
+      values.clear();
+      for (size_t i = 0; i < rows; ++i) {
+        Real value = src[i * cols + j];
+        if (!std::isnan(value)) {
+          values.push_back(value);
+        }
+      }
+      select_quantiles(values, qs, order, out + j, cols);
+    }
+    return result;
+  }
+  size_t count = axis == 1 ? rows : 1;
+  size_t length = axis == 1 ? cols : rows * cols;
+  values.reserve(length);
+  for (size_t i = 0; i < count; ++i) {
+    values.clear();
+    std::copy_if(src + i * length, src + (i + 1) * length, std::back_inserter(values),
+        [](Real value) { return !std::isnan(value); });
+    select_quantiles(values, qs, order, out + i * q_count, 1);
+  }
+  return result;
+}/*}}}*/
+
+extern "C" {
+  TensorHandle tensor_histogram(
+      TensorHandle tensor,
+      size_t bins,
+      Real low,
+      Real high,
+      int axis = -1,
+      int* shape_wire = nullptr
+      ) {
+
+    TENSOR_PROFILE_OP("histogram", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->histogram(bins, low, high, axis));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  // `weights` is optional (size 0)
+  TensorHandle tensor_bincount(
+      TensorHandle tensor,
+      size_t min_length,
+      const Real* weights,
+      size_t weights_size,
+      int* shape_wire = nullptr
+      ) {
+
+    TENSOR_PROFILE_OP("bincount", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->bincount(min_length, weights, weights_size));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+
+  TensorHandle tensor_quantile(
+      TensorHandle tensor,
+      const Real* qs,
+      size_t q_count,
+      int axis = -1,
+      bool keepdims = false,
+      int* shape_wire = nullptr
+      ) {
+
+    TENSOR_PROFILE_OP("quantile", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->quantile(qs, q_count, axis, keepdims));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+}
@@ -0,0 +1,283 @@
+#include "../Stream.h"
+
+#ifndef __EMSCRIPTEN__
+#include <cstdio>
+#include <cstring>
+#include "../Serialize.h"
+#endif
+
+TensorStream::TensorStream(size_t cols, const Tensor* resident_matrix) : cols(cols) {/*{{{*/
+  size_t out_cols = cols;
+  if (resident_matrix) {
+    if (resident_matrix->rows != cols) {
+      report_error("TensorStream: resident matrix rows must match the stream columns");
+    }
+    // share the data, the caller is free to delete its tensor
+    resident = std::make_shared<Tensor>(resident_matrix->rows, resident_matrix->cols,
+        resident_matrix->is1d, resident_matrix->data);
+    out_cols = resident_matrix->cols;
+    tile.resize(TILE_ROWS * out_cols);
+  }
+  sums.resize(out_cols);
+  abs_sums.resize(out_cols);
+  sq_sums.resize(out_cols);
+  mins.resize(out_cols);
+  maxs.resize(out_cols);
+  reset();
+  memory::object_created(state_bytes());
+}/*}}}*/
+
+TensorStream::~TensorStream() {
+  memory::object_destroyed(state_bytes());
+}
+
+size_t TensorStream::state_bytes() const {
+  return (tile.capacity() + mins.capacity() + maxs.capacity()) * sizeof(Real) \
+    + (sums.capacity() + abs_sums.capacity() + sq_sums.capacity()) * sizeof(double);
+}
+
+void TensorStream::reset() {
+  count = 0;
+  std::fill(sums.begin(), sums.end(), 0.0);
+  std::fill(abs_sums.begin(), abs_sums.end(), 0.0);
+  std::fill(sq_sums.begin(), sq_sums.end(), 0.0);
+  std::fill(mins.begin(), mins.end(), std::numeric_limits<Real>::infinity());
+  std::fill(maxs.begin(), maxs.end(), std::numeric_limits<Real>::lowest());
+}
+
+size_t TensorStream::rows_seen() const {
+  return count;
+}
+
+size_t TensorStream::output_cols() const {
+  return sums.size();
+}
+
+// Row-wise sweep so each accumulator streams contiguously
+void TensorStream::accumulate(const Real* rows_data, size_t rows) {/*{{{*/
+  size_t ncols = sums.size();
+  for (size_t i = 0; i < rows; ++i) {
+    const Real* row = rows_data + i * ncols;
+    for (size_t j = 0; j < ncols; ++j) {
+      Real val = row[j];
+      sums[j] += val;
+      abs_sums[j] += std::abs(val);
+      sq_sums[j] += static_cast<double>(val) * val;
+      mins[j] = std::min(mins[j], val);
+      maxs[j] = std::max(maxs[j], val);
+    }
+  }
+  count += rows;
+}/*}}}*/
+
+void TensorStream::push(const Real* chunk, size_t rows, Real* out) {/*{{{*/
+  if (!resident) {
+    accumulate(chunk, rows);
+    if (out) {
+      std::copy(chunk, chunk + rows * cols, out);
+    }
+    return;
+  }
+
+  // chunk x resident, one tile of rows at a time
+  const auto& m = resident->data_ref();
+  size_t ncols = resident->cols;
+  for (size_t start = 0; start < rows; start += TILE_ROWS) {
+    size_t tile_rows = std::min(TILE_ROWS, rows - start);
+    std::fill(tile.begin(), tile.begin() + tile_rows * ncols, 0.0f);
+    for (size_t i = 0; i < tile_rows; ++i) {
+      const Real* a = chunk + (start + i) * cols;
+      Real* c = tile.data() + i * ncols;
+      for (size_t k = 0; k < cols; ++k) {
+        Real a_ik = a[k];
+        const Real* b = m.data() + k * ncols;
+        for (size_t j = 0; j < ncols; ++j) {
+          c[j] += a_ik * b[j];
+        }
+      }
+    }
+    accumulate(tile.data(), tile_rows);
+    if (out) {
+      std::copy(tile.begin(), tile.begin() + tile_rows * ncols, out + start * ncols);
+    }
+  }
+}/*}}}*/
+
+#ifndef __EMSCRIPTEN__
+void TensorStream::push_file(const char* path, size_t chunk_rows) {/*{{{*/
+  if (chunk_rows == 0) {
+    report_error("TensorStream: chunk_rows must be at least 1");
+    return;
+  }
+  FILE* file = std::fopen(path, "rb");
+  if (!file) {
+    std::string message = std::string("Unable to open ") + path;
+    report_error(message.c_str());
+    return;
+  }
+  std::fseek(file, 0, SEEK_END);
+  size_t size = std::ftell(file);
+  std::fseek(file, 0, SEEK_SET);
+
+  // read_header only needs the header bytes, size bounds the payload check
+  uint8_t header_bytes[sizeof(serialize::TensorHeader)] = {};
+  size_t header_read = std::fread(header_bytes, 1, sizeof(header_bytes), file);
+  serialize::TensorHeader header;
+  if (!serialize::read_header(header_bytes, header_read < sizeof(header_bytes) ? header_read : size, header)) {
+    std::fclose(file);
+    return;
+  }
+  if (header.cols != cols) {
+    std::fclose(file);
+    report_error("TensorStream: file columns do not match the stream");
+    return;
+  }
+
+  size_t item_size = header.dtype == serialize::FLOAT64 ? sizeof(double) : sizeof(float);
+  std::vector<uint8_t> raw(chunk_rows * cols * item_size);
+  std::vector<Real> chunk(chunk_rows * cols);
+  std::fseek(file, header.data_offset, SEEK_SET);
+  for (size_t row = 0; row < header.rows; row += chunk_rows) {
+    size_t rows = std::min<size_t>(chunk_rows, header.rows - row);
+    size_t values = rows * cols;
+    if (std::fread(raw.data(), item_size, values, file) != values) {
+      report_error("TensorStream: unexpected end of file");
+      break;
+    }
+    for (size_t i = 0; i < values; ++i) {
+      if (item_size == sizeof(double)) {
+        double value;
+        std::memcpy(&value, raw.data() + i * item_size, item_size);
+        chunk[i] = static_cast<Real>(value);
+      } else {
+        float value;
+        std::memcpy(&value, raw.data() + i * item_size, item_size);
+        chunk[i] = static_cast<Real>(value);
+      }
+    }
+    push(chunk.data(), rows);
+  }
+  std::fclose(file);
+}/*}}}*/
+#endif
+
+Tensor TensorStream::reduce(STREAM_REDUCE op, NORM_ORD ord, int axis, bool keepdims) const {/*{{{*/
+  if (axis != -1 && axis != 0) {
+    report_error("TensorStream: axis must be -1 (flat) or 0 (column-wise)");
+    return Tensor(0, 0, false);
+  }
+  size_t ncols = sums.size();
+  if (ncols == 0) {
+    // min/max of no columns are undefined
+    return Tensor(0, 0, false);
+  }
+  Buffer result(ncols);
+
+  for (size_t j = 0; j < ncols; ++j) {
+    switch (op) {
+      case STREAM_SUM:
+        result[j] = sums[j];
+        break;
+      case STREAM_MEAN:
+        result[j] = count ? sums[j] / count : 0.0f;
+        break;
+      case STREAM_MIN:
+        result[j] = mins[j];
+        break;
+      case STREAM_MAX:
+        result[j] = maxs[j];
+        break;
+      case STREAM_NORM:
+        if (ord == NORM_ORD::L1) {
+          result[j] = abs_sums[j];
+        } else if (ord == NORM_ORD::L2) {
+          result[j] = std::sqrt(sq_sums[j]);
+        } else {
+          result[j] = std::max(std::abs(mins[j]), std::abs(maxs[j]));
+        }
+        break;
+    }
+  }
+
+  if (axis == 0) {
+    return Tensor(1, ncols, false, std::move(result));
+  }
+
+  // fold the columns together
+  double flat = 0.0;
+  switch (op) {
+    case STREAM_SUM:
+      for (double sum : sums) flat += sum;
+      break;
+    case STREAM_MEAN:
+      for (double sum : sums) flat += sum;
+      flat = count ? flat / (count * ncols) : 0.0;
+      break;
+    case STREAM_MIN:
+      flat = *std::min_element(result.begin(), result.end());
+      break;
+    case STREAM_MAX:
+    case STREAM_NORM:
+      if (op == STREAM_NORM && ord == NORM_ORD::L1) {
+        for (double sum : abs_sums) flat += sum;
+      } else if (op == STREAM_NORM && ord == NORM_ORD::L2) {
+        for (double sum : sq_sums) flat += sum;
+        flat = std::sqrt(flat);
+      } else {
+        flat = *std::max_element(result.begin(), result.end());
+      }
+      break;
+  }
+  return Tensor(1, 1, !keepdims, Buffer{ static_cast<Real>(flat) });
+}/*}}}*/
+
+extern "C" {
+  // `resident` is optional (null), when given chunks are multiplied through it
+  TensorStream* stream_create(size_t cols, TensorHandle resident) {
+    // checked before allocating, report_error doesn't return to free it
+    if (cols == 0 || (resident && resident->cols == 0)) {
+      report_error("TensorStream: streams need at least one column");
+      return nullptr;
+    }
+    if (resident && resident->rows != cols) {
+      report_error("TensorStream: resident matrix rows must match the stream columns");
+      return nullptr;
+    }
+    return new TensorStream(cols, resident);
+  }
+
+  void stream_delete(TensorStream* stream) {
+    delete stream;
+  }
+
+  void stream_reset(TensorStream* stream) {
+    stream->reset();
+  }
+
+  void stream_push(TensorStream* stream, const Real* chunk, size_t rows, Real* out) {
+    TENSOR_PROFILE_OP("stream_push", rows);
+    stream->push(chunk, rows, out);
+  }
+
+  size_t stream_rows(TensorStream* stream) {
+    return stream->rows_seen();
+  }
+
+  size_t stream_output_cols(TensorStream* stream) {
+    return stream->output_cols();
+  }
+
+  TensorHandle stream_reduce(
+      TensorStream* stream,
+      int op,
+      int ord = 0,
+      int axis = -1,
+      bool keepdims = false,
+      int* shape_wire = nullptr
+      ) {
+    TensorHandle new_tensor = TensorHandle::emplace(stream->reduce(
+          static_cast<STREAM_REDUCE>(op), static_cast<NORM_ORD>(ord), axis, keepdims));
+    update_shape_wire(new_tensor, shape_wire);
+    return new_tensor;
+  }
+}
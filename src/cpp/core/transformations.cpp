@@ -3,21 +3,20 @@
 // Pad data, row/col, begin to end
 Tensor Tensor::pad(Real constant, size_t rpad_before, /*{{{*/
     size_t rpad_after, size_t cpad_before, size_t cpad_after) const {
-  const auto& vec = data_ref();
-  size_t nrows = rows + rpad_before + rpad_after;
-  size_t ncols = cols + cpad_before + cpad_after;
-  size_t new_size = ncols * nrows;
-  
-  std::vector<Real> padded(new_size, constant);
+  Tensor result(rows + rpad_before + rpad_after, cols + cpad_before + cpad_after, is1d);
+  pad_into(result, constant, rpad_before, cpad_before);
+  return result;
+}/*}}}*/
 
-  for (size_t i = rpad_before; i < nrows - rpad_after; ++i) {
-    size_t rindex = i - rpad_before;
-    for (size_t j = cpad_before; j < ncols - cpad_after; ++j) {
-      size_t cindex = rindex * cols + (j - cpad_before);
-      padded[i * ncols + j] = vec[cindex];
-    }
+// `dst` has the padded shape, the padding after follows from it
+void Tensor::pad_into(Tensor& dst, Real constant, size_t rpad_before, size_t cpad_before) const {/*{{{*/
+  const auto& vec = data_ref();
+  Real* padded = dst.data->data();
+  std::fill(padded, padded + dst.rows * dst.cols, constant);
+  for (size_t i = 0; i < rows; ++i) {
+    std::copy(vec.begin() + i * cols, vec.begin() + (i + 1) * cols,
+        padded + (i + rpad_before) * dst.cols + cpad_before);
   }
-  return Tensor(nrows, ncols, is1d, std::move(padded));
 }/*}}}*/
 
 // Reshape
@@ -82,24 +81,38 @@ Tensor Tensor::reshape(int new_rows, int new_cols) const {/*{{{*/
 }/*}}}*/
 
 extern "C" {
-  Tensor* tensor_pad(Tensor* tensor, int* shape_wire, Real constant,
+  TensorHandle tensor_pad(TensorHandle tensor, int* shape_wire, Real constant,
       size_t rpad_before, size_t rpad_after, size_t cpad_before, size_t cpad_after) {
-    Tensor* new_tensor = new Tensor(tensor->pad(constant, rpad_before, rpad_after, cpad_before, cpad_after));
+    TENSOR_PROFILE_OP("pad", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->pad(constant, rpad_before, rpad_after, cpad_before, cpad_after));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
 
-  Tensor* tensor_flatten(Tensor* tensor) {
-    return new Tensor(tensor->rows, tensor->cols, true, tensor->data);
+  Real* tensor_pad_into(TensorHandle out, TensorHandle tensor, Real constant,
+      size_t rpad_before, size_t rpad_after, size_t cpad_before, size_t cpad_after) {
+    TENSOR_PROFILE_OP("pad", tensor->rows * tensor->cols);
+    size_t rows = tensor->rows + rpad_before + rpad_after;
+    size_t cols = tensor->cols + cpad_before + cpad_after;
+    if (prepare_out(out, rows, cols, { tensor })) {
+      tensor->pad_into(*out, constant, rpad_before, cpad_before);
+    }
+    return out->data->data();
+  }
+
+  TensorHandle tensor_flatten(TensorHandle tensor) {
+    TENSOR_PROFILE_OP("flatten", tensor->rows * tensor->cols);
+    return TensorHandle::emplace(tensor->rows, tensor->cols, true, tensor->data);
   }
 
-  Tensor* tensor_reshape(
-      Tensor* tensor,
+  TensorHandle tensor_reshape(
+      TensorHandle tensor,
       int new_rows,
       int new_cols,
       int* shape_wire = nullptr
       ) {
-    Tensor* new_tensor = new Tensor(tensor->reshape(new_rows, new_cols));
+    TENSOR_PROFILE_OP("reshape", tensor->rows * tensor->cols);
+    TensorHandle new_tensor = TensorHandle::emplace(tensor->reshape(new_rows, new_cols));
     update_shape_wire(new_tensor, shape_wire);
     return new_tensor;
   }
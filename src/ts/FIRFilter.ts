@@ -0,0 +1,73 @@
+import Interface from './Interface.js';
+import { Tensor } from './Tensor.js';
+
+/**
+ * Causal FIR filter keeping its history between calls, so a signal can be
+ * filtered chunk by chunk with the same result as filtering it at once.
+ * Frames are time-major, `channels` interleaved values per sample.
+ * @example
+ * const fir = new ft.FIRFilter(ft.Tensor.movingAverageKernel(5), 2);
+ * fir.process(frame); // filtered in place
+ * fir.delete();
+ */
+export class FIRFilter extends Interface {
+  readonly channels: number;
+  private bufferSize = 0;
+
+  constructor(kernel: number[] | Float32Array | Tensor, channels = 1) {
+    super();
+    if (!Number.isInteger(channels) || channels < 1) {
+      throw new Error('FIRFilter expects at least one channel');
+    }
+    this.channels = channels;
+    if (kernel instanceof Tensor) {
+      this.ptr = this.Module._fir_create(kernel.dataPtr, kernel.rows * kernel.cols, channels);
+      return;
+    }
+    const taps = new Float32Array(kernel);
+    const kernelPtr = this.Module._malloc(taps.length * Float32Array.BYTES_PER_ELEMENT);
+    this.Module.HEAPF32.set(taps, kernelPtr / Float32Array.BYTES_PER_ELEMENT);
+    this.ptr = this.Module._fir_create(kernelPtr, taps.length, channels);
+    this._free(kernelPtr);
+  }
+
+  /**
+   * Filter the next frame in place, its length must be a multiple of the channels
+   */
+  process(data: Float32Array) {
+    if (!(data instanceof Float32Array)) {
+      throw new Error('Input must be a Float32Array');
+    }
+    if (data.length % this.channels !== 0) {
+      throw new Error(`Frame length (${data.length}) is not a multiple of the channels (${this.channels})`);
+    }
+    const size = data.length * Float32Array.BYTES_PER_ELEMENT;
+    // the staging buffer only grows, so steady frame sizes never reallocate
+    if (size > this.bufferSize) {
+      if (this.bufferSize) {
+        this._free(this._dataPtr);
+      }
+      this._dataPtr = this.Module._malloc(size);
+      this.bufferSize = size;
+    }
+    const offset = this._dataPtr / Float32Array.BYTES_PER_ELEMENT;
+    this.Module.HEAPF32.set(data, offset);
+    this.Module._fir_process(this.ptr, this._dataPtr, data.length / this.channels);
+    data.set(this.Module.HEAPF32.subarray(offset, offset + data.length));
+  }
+
+  /** Clear the history, the next frame starts from silence */
+  reset() {
+    this.Module._fir_reset(this.ptr);
+  }
+
+  delete() {
+    if (!this.deleted) {
+      this.deleted = true;
+      if (this.bufferSize) {
+        this._free(this._dataPtr);
+      }
+      this.Module._fir_delete(this.ptr);
+    }
+  }
+}
@@ -9,29 +9,42 @@ export default abstract class Interface {
   protected deleted = false;
   protected ptr = 0;
   protected _dataPtr = 0;
-  private static WasmInterfacePromise: Promise<WasmModule> = WasmInterfaceLoader();
+  // started by the first ready(), so a wasm path set before it is the only one fetched
+  private static WasmInterfacePromise?: Promise<WasmModule>;
 
   static async setWasmPath(path: string) {
     if (!isNode) {
-      const loader = await Interface.WasmInterfacePromise;
-      Interface.WasmInterfacePromise = loader.default({
-        locateFile: () => path
-      });
+      Interface.WasmInterfacePromise = WasmInterfaceLoader({ wasmPath: path });
       // immediately load
       void Interface.ready();
     }
   }
 
   static async ready(): Promise<void> {
+    Interface.WasmInterfacePromise ??= WasmInterfaceLoader();
     const loadedModule: WasmModule = await Interface.WasmInterfacePromise;
     Interface.Module = loadedModule;
   }
 
+  /**
+   * Instantiate a module compiled elsewhere, e.g. the main thread's in a worker
+   * @hidden
+   */
+  static async readyFrom(module: WebAssembly.Module): Promise<void> {
+    Interface.WasmInterfacePromise = WasmInterfaceLoader({ module });
+    await Interface.ready();
+  }
+
   /** @hidden */
   get Module(): WasmModule {
     return Interface.Module;
   }
 
+  /** @hidden */
+  get pointer(): number {
+    return this.ptr;
+  }
+
   /** @hidden */
   get dataPtr(): number {
     return this._dataPtr;
@@ -0,0 +1,86 @@
+import Interface from './Interface.js';
+import { Tensor } from './Tensor.js';
+
+/**
+ * Spatial index over the rows of an Nx2 or Nx3 point tensor, for nearest
+ * neighbor and radius queries without brute force.
+ * @example
+ * const tree = new ft.KDTree(points);
+ * const [ indices, distances ] = tree.knn(queries, 4);
+ * // next frame, points moved a little
+ * tree.refit(movedPoints);
+ * tree.delete();
+ */
+export class KDTree extends Interface {
+  constructor(points: Tensor, leafSize = 16) {
+    super();
+    KDTree.checkPoints(points);
+    this.ptr = this.Module._kdtree_create(points.pointer, leafSize);
+  }
+
+  /** Number of indexed points */
+  get size(): number {
+    return this.Module._kdtree_size(this.ptr);
+  }
+
+  /** Rebuild the index from a new set of points */
+  build(points: Tensor) {
+    KDTree.checkPoints(points);
+    this.Module._kdtree_build(this.ptr, points.pointer);
+  }
+
+  /**
+   * Update the positions of the indexed points, cheaper than a rebuild when
+   * they only moved slightly. Returns true if the points moved far enough
+   * that the index was rebuilt anyway.
+   */
+  refit(points: Tensor): boolean {
+    KDTree.checkPoints(points);
+    return Boolean(this.Module._kdtree_refit(this.ptr, points.pointer));
+  }
+
+  /**
+   * The `k` nearest points for each query row, nearest first. Returns
+   * [indices, distances], both (queries x k) and padded with -1 when fewer
+   * than `k` points are indexed.
+   */
+  knn(queries: Tensor, k: number): [Tensor, Tensor] {
+    const distances = Tensor.zeros([queries.rows, k]);
+    const indices = Tensor.fromShapeWire(
+      shapeWirePtr => this.Module._kdtree_knn(this.ptr, queries.pointer, k, distances.pointer, shapeWirePtr)
+    );
+    return [indices, distances];
+  }
+
+  /**
+   * Points within `radius` of each query row, nearest first and at most
+   * `maxResults` per query. Returns [indices, distances], both
+   * (queries x maxResults) and padded with -1.
+   */
+  radius(queries: Tensor, radius: number, maxResults = 16): [Tensor, Tensor] {
+    const distances = Tensor.zeros([queries.rows, maxResults]);
+    const indices = Tensor.fromShapeWire(
+      shapeWirePtr => this.Module._kdtree_radius(
+        this.ptr, queries.pointer, radius, maxResults, distances.pointer, shapeWirePtr
+      )
+    );
+    return [indices, distances];
+  }
+
+  delete() {
+    if (!this.deleted) {
+      this.deleted = true;
+      this.Module._kdtree_delete(this.ptr);
+    }
+  }
+
+  private static checkPoints(points: Tensor) {
+    if (!(points instanceof Tensor)) {
+      throw new TypeError('Expected points to be of type Tensor');
+    }
+    // checked natively too, but failing here doesn't leave a half built tree
+    if (points.cols !== 2 && points.cols !== 3) {
+      throw new Error('KDTree: points must be an Nx2 or Nx3 tensor');
+    }
+  }
+}
@@ -48,6 +48,10 @@ export class Kalman extends Interface {
   }
 
   delete() {
+    if (this.initialized) {
+      this.initialized = false;
+      this._free(this.dataPtr);
+    }
     this.Module._kalman_delete(this.ptr);
   }
 }
@@ -0,0 +1,262 @@
+import Interface from './Interface.js';
+import { Tensor } from './Tensor.js';
+import type { InputData, MathModeKey, OptionalBool, OptionalNumber, Shape } from './Tensor.js';
+
+// matches PIPELINE_OP in src/cpp/Pipeline.h
+const PIPELINE_OP = {
+  add: 0,
+  sub: 1,
+  mul: 2,
+  div: 3,
+  maximum: 4,
+  minimum: 5,
+  abs: 6,
+  square: 7,
+  clip: 8,
+  exp: 9,
+  log: 10,
+  sigmoid: 11,
+  tanh: 12,
+  matMul: 13,
+  transformPoints: 14,
+  transpose: 15,
+  sum: 16,
+  mean: 17,
+  min: 18,
+  max: 19,
+} as const;
+
+/**
+ * A fixed op chain over frames of one shape, for loops running the same ops
+ * every frame. Adding the steps preallocates every intermediate, `run` then
+ * copies a frame in, runs the chain and returns a view of the result
+ * without allocating.
+ *
+ * Input and output slots are double-buffered, the view returned for a frame
+ * stays valid while the next frame is written and run.
+ * @example
+ * const pipeline = new ft.Pipeline([ 480, 2 ])
+ *   .sub(center)
+ *   .transformPoints(view)
+ *   .clip(-1, 1);
+ * const projected = pipeline.run(points); // Float32Array of 480 * 2 values
+ * pipeline.delete();
+ */
+export class Pipeline extends Interface {
+  readonly inputShape: Shape;
+  private _outputShape: Shape;
+  private inputSize: number;
+  private outputSize: number;
+  private slot = 0;
+  private lastSlot = 0;
+  // input slots then output slots, rebuilt when the wasm memory grows
+  private views: Float32Array[] = [];
+  private viewsBuffer: ArrayBufferLike | null = null;
+
+  constructor(shape: Shape) {
+    super();
+    if (!shape.length || shape.length > 2 || !shape.every(size => Number.isInteger(size) && size > 0)) {
+      throw new Error(`Invalid pipeline frame shape [${shape.join(',')}]`);
+    }
+    const is1d = shape.length === 1;
+    const [rows, cols] = is1d ? [1, shape[0]] : shape;
+    this.inputShape = [...shape];
+    this._outputShape = [...shape];
+    this.inputSize = rows * cols;
+    this.outputSize = rows * cols;
+    this.ptr = this.Module._pipeline_create(rows, cols, is1d);
+  }
+
+  /** Shape of the frames `run` returns */
+  get outputShape(): Shape {
+    return [...this._outputShape];
+  }
+
+  /**
+   * The next frame's input slot, filling it in place and calling `run()`
+   * without arguments skips a copy
+   */
+  get input(): Float32Array {
+    return this.view(this.slot);
+  }
+
+  /** Result of the last run */
+  get output(): Float32Array {
+    return this.view(2 + this.lastSlot);
+  }
+
+  /**
+   * Run a frame, `frame` (optional) is copied into the input slot first.
+   * The returned view is reused two runs later.
+   */
+  run(frame?: ArrayLike<number>): Float32Array {
+    if (frame) {
+      if (frame.length !== this.inputSize) {
+        throw new Error(`Frame length (${frame.length}) must match the pipeline input size (${this.inputSize})`);
+      }
+      this.input.set(frame);
+    }
+    this.lastSlot = this.Module._pipeline_run(this.ptr);
+    this.slot = this.lastSlot ^ 1;
+    return this.output;
+  }
+
+  /** @category Arithmetic */
+  add(input: InputData): this {
+    return this.constantStep(PIPELINE_OP.add, input);
+  }
+
+  /** @category Arithmetic */
+  sub(input: InputData): this {
+    return this.constantStep(PIPELINE_OP.sub, input);
+  }
+
+  /** @category Arithmetic */
+  mul(input: InputData): this {
+    return this.constantStep(PIPELINE_OP.mul, input);
+  }
+
+  /** @category Arithmetic */
+  div(input: InputData, noNan = false): this {
+    return this.constantStep(PIPELINE_OP.div, input, noNan ? 1 : 0);
+  }
+
+  /** @category Arithmetic */
+  maximum(input: InputData): this {
+    return this.constantStep(PIPELINE_OP.maximum, input);
+  }
+
+  /** @category Arithmetic */
+  minimum(input: InputData): this {
+    return this.constantStep(PIPELINE_OP.minimum, input);
+  }
+
+  /** @category Basic Math */
+  abs(): this {
+    return this.step(PIPELINE_OP.abs);
+  }
+
+  /** @category Basic Math */
+  square(): this {
+    return this.step(PIPELINE_OP.square);
+  }
+
+  /** @category Basic Math */
+  clip(lower: number, upper: number): this {
+    return this.step(PIPELINE_OP.clip, null, lower, upper);
+  }
+
+  /** @category Basic Math */
+  exp(mode?: MathModeKey): this {
+    return this.step(PIPELINE_OP.exp, null, Tensor._mathMode(mode));
+  }
+
+  /** @category Basic Math */
+  log(mode?: MathModeKey): this {
+    return this.step(PIPELINE_OP.log, null, Tensor._mathMode(mode));
+  }
+
+  /** @category Basic Math */
+  sigmoid(mode?: MathModeKey): this {
+    return this.step(PIPELINE_OP.sigmoid, null, Tensor._mathMode(mode));
+  }
+
+  /** @category Basic Math */
+  tanh(mode?: MathModeKey): this {
+    return this.step(PIPELINE_OP.tanh, null, Tensor._mathMode(mode));
+  }
+
+  /** @category Matrices */
+  matMul(matrix: Tensor): this {
+    return this.step(PIPELINE_OP.matMul, Pipeline.checkTensor(matrix));
+  }
+
+  /**
+   * See {@link Tensor.transformPoints}
+   * @category Matrices
+   */
+  transformPoints(matrix: Tensor, divide = true): this {
+    return this.step(PIPELINE_OP.transformPoints, Pipeline.checkTensor(matrix), divide ? 1 : 0);
+  }
+
+  /** @category Transformations */
+  transpose(): this {
+    return this.step(PIPELINE_OP.transpose);
+  }
+
+  /** @category Reduction */
+  sum(axis: OptionalNumber = -1, keepdims: OptionalBool = false): this {
+    return this.step(PIPELINE_OP.sum, null, axis ?? -1, keepdims ? 1 : 0);
+  }
+
+  /** @category Reduction */
+  mean(axis: OptionalNumber = -1, keepdims: OptionalBool = false): this {
+    return this.step(PIPELINE_OP.mean, null, axis ?? -1, keepdims ? 1 : 0);
+  }
+
+  /** @category Reduction */
+  min(axis: OptionalNumber = -1, keepdims: OptionalBool = false): this {
+    return this.step(PIPELINE_OP.min, null, axis ?? -1, keepdims ? 1 : 0);
+  }
+
+  /** @category Reduction */
+  max(axis: OptionalNumber = -1, keepdims: OptionalBool = false): this {
+    return this.step(PIPELINE_OP.max, null, axis ?? -1, keepdims ? 1 : 0);
+  }
+
+  delete() {
+    if (!this.deleted) {
+      this.deleted = true;
+      this.views = [];
+      this.Module._pipeline_delete(this.ptr);
+    }
+  }
+
+  // scalars and arrays are staged in a temporary tensor, the step keeps
+  // its own reference to the data
+  private constantStep(op: number, input: InputData, param0 = 0): this {
+    if (input instanceof Tensor) {
+      return this.step(op, input, param0);
+    }
+    const staging = new Tensor(typeof input === 'number' ? [input] : input);
+    try {
+      return this.step(op, staging, param0);
+    } finally {
+      staging.delete();
+    }
+  }
+
+  private step(op: number, operand: Tensor | null = null, param0 = 0, param1 = 0): this {
+    const shapeWire = this.Module._malloc(3 * Int32Array.BYTES_PER_ELEMENT);
+    try {
+      this.Module._pipeline_add(this.ptr, op, operand ? operand.pointer : 0, param0, param1, shapeWire);
+      const [rows, cols, is1d] = this.Module.HEAP32.subarray(shapeWire >> 2, (shapeWire >> 2) + 3);
+      this._outputShape = is1d ? [cols] : [rows, cols];
+      this.outputSize = rows * cols;
+    } finally {
+      this._free(shapeWire);
+    }
+    // the output slots were reallocated
+    this.views = [];
+    return this;
+  }
+
+  private view(index: number): Float32Array {
+    const buffer = this.Module.HEAPF32.buffer;
+    if (this.viewsBuffer !== buffer || !this.views.length) {
+      this.viewsBuffer = buffer;
+      this.views = [0, 1, 0, 1].map((slot, i) => {
+        const ptr = i < 2 ? this.Module._pipeline_input(this.ptr, slot) : this.Module._pipeline_output(this.ptr, slot);
+        return new Float32Array(buffer, ptr, i < 2 ? this.inputSize : this.outputSize);
+      });
+    }
+    return this.views[index];
+  }
+
+  private static checkTensor(tensor: Tensor): Tensor {
+    if (!(tensor instanceof Tensor)) {
+      throw new TypeError('Expected 1st argument to be of type Tensor');
+    }
+    return tensor;
+  }
+}
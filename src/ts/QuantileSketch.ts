@@ -0,0 +1,106 @@
+import Interface from './Interface.js';
+import { Tensor } from './Tensor.js';
+
+/**
+ * Approximate quantiles of a stream in bounded memory (a KLL sketch). Push
+ * tensors frame after frame, memory stays around 3 * k values however many
+ * are pushed. Sketches with the same `k` can be merged, e.g. one per worker.
+ * The default k = 200 keeps rank errors around 1%.
+ * @example
+ * const sketch = new ft.QuantileSketch();
+ * sketch.push(frameLatencies);
+ * sketch.quantile([0.5, 0.99]);
+ * sketch.delete();
+ */
+export class QuantileSketch extends Interface {
+  readonly k: number;
+  private bufferSize = 0;
+
+  constructor(k = 200) {
+    super();
+    if (!Number.isInteger(k) || k < 8) {
+      throw new RangeError('QuantileSketch: k must be an integer of at least 8');
+    }
+    this.k = k;
+    this.ptr = this.Module._sketch_create(k);
+  }
+
+  /** Absorb every value of a tensor or array, NaN values are skipped */
+  push(values: Float32Array | Tensor) {
+    if (values instanceof Tensor) {
+      // read straight from the tensor's buffer
+      this.Module._sketch_push(this.ptr, values.dataPtr, values.rows * values.cols);
+      return;
+    }
+    this.reserve(values.length);
+    this.Module.HEAPF32.set(values, this._dataPtr / Float32Array.BYTES_PER_ELEMENT);
+    this.Module._sketch_push(this.ptr, this._dataPtr, values.length);
+  }
+
+  /** Fold another sketch into this one, `other` is left unchanged */
+  merge(other: QuantileSketch) {
+    if (other.k !== this.k) {
+      throw new Error(`QuantileSketch: can't merge a sketch of k=${other.k} into k=${this.k}`);
+    }
+    this.Module._sketch_merge(this.ptr, other.ptr);
+  }
+
+  /** Values pushed since creation or the last reset, merged ones included */
+  get count(): number {
+    return this.Module._sketch_count(this.ptr);
+  }
+
+  /** Values currently held */
+  get retained(): number {
+    return this.Module._sketch_retained(this.ptr);
+  }
+
+  /** Approximate quantiles, 0 and 1 give the exact min and max */
+  quantile(q: number): number;
+  quantile(q: number[]): number[];
+  quantile(q: number | number[]): number | number[] {
+    const qs = typeof q === 'number' ? [q] : q;
+    // quantiles and results share one allocation
+    const ptr = this.Module._malloc(qs.length * 2 * Float32Array.BYTES_PER_ELEMENT);
+    const offset = ptr / Float32Array.BYTES_PER_ELEMENT;
+    this.Module.HEAPF32.set(qs, offset);
+    try {
+      this.Module._sketch_quantiles(this.ptr, ptr, qs.length, ptr + qs.length * Float32Array.BYTES_PER_ELEMENT);
+      const result = Array.from(this.Module.HEAPF32.subarray(offset + qs.length, offset + qs.length * 2));
+      return typeof q === 'number' ? result[0] : result;
+    } finally {
+      this._free(ptr);
+    }
+  }
+
+  /** Approximate fraction of the values <= `value` */
+  rank(value: number): number {
+    return this.Module._sketch_rank(this.ptr, value);
+  }
+
+  reset() {
+    this.Module._sketch_reset(this.ptr);
+  }
+
+  delete() {
+    if (!this.deleted) {
+      this.deleted = true;
+      if (this.bufferSize) {
+        this._free(this._dataPtr);
+      }
+      this.Module._sketch_delete(this.ptr);
+    }
+  }
+
+  // the staging buffer only grows, so steady frame sizes never reallocate
+  private reserve(length: number) {
+    const size = length * Float32Array.BYTES_PER_ELEMENT;
+    if (size > this.bufferSize) {
+      if (this.bufferSize) {
+        this._free(this._dataPtr);
+      }
+      this._dataPtr = this.Module._malloc(size);
+      this.bufferSize = size;
+    }
+  }
+}
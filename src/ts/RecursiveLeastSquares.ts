@@ -0,0 +1,136 @@
+import Interface from './Interface.js';
+import { Tensor } from './Tensor.js';
+
+type Rows = number[] | number[][] | Float32Array | Tensor;
+
+/**
+ * Linear least squares fitted one observation at a time (recursive least
+ * squares), each update costs O(features²) however many rows were seen.
+ * With `forgetting` below 1 older rows fade out, e.g. 0.99 follows a drifting
+ * relation over roughly the last 100 rows. For a hard window keep the
+ * default of 1 and `downdate` the rows leaving it.
+ * @example
+ * const rls = new ft.RecursiveLeastSquares(2);
+ * rls.update([[1, 1], [2, 1], [3, 1]], [3, 5, 7]);
+ * rls.weights; // ≈ [2, 1]
+ * rls.predict([4, 1]); // ≈ 9
+ * rls.downdate([1, 1], 3); // drop the oldest row
+ * rls.delete();
+ */
+export class RecursiveLeastSquares extends Interface {
+  readonly features: number;
+  private bufferSize = 0;
+
+  /**
+   * @param features values per observation, add a constant 1 for an intercept
+   * @param forgetting weight kept by older rows at every update, 0 to 1
+   * @param regularization ridge prior, keeps the first updates well posed
+   */
+  constructor(features: number, forgetting = 1, regularization = 1e-4) {
+    super();
+    if (!Number.isInteger(features) || features < 1) {
+      throw new RangeError('RecursiveLeastSquares: features must be a positive integer');
+    }
+    if (!(forgetting > 0 && forgetting <= 1)) {
+      throw new RangeError('RecursiveLeastSquares: forgetting must be in (0, 1]');
+    }
+    this.features = features;
+    this.ptr = this.Module._rls_create(features, forgetting, regularization);
+  }
+
+  /** Fold in one observation, or a row of `x` per value of `y` */
+  update(x: Rows, y: number | number[] | Float32Array) {
+    const rows = this.stage(x, y);
+    this.Module._rls_update(this.ptr, this._dataPtr, this.yPtr(rows), rows);
+  }
+
+  /**
+   * Remove observations added before, at the weight they were added with.
+   * Throws with a `forgetting` below 1, where older rows have decayed, and,
+   * leaving the fit unchanged, when they can't have been added.
+   */
+  downdate(x: Rows, y: number | number[] | Float32Array) {
+    const rows = this.stage(x, y);
+    if (!this.Module._rls_downdate(this.ptr, this._dataPtr, this.yPtr(rows), rows)) {
+      throw new Error('RecursiveLeastSquares: downdate removes observations that were never added');
+    }
+  }
+
+  /** Current weight of every feature */
+  get weights(): number[] {
+    const ptr = this.Module._malloc(this.features * Float32Array.BYTES_PER_ELEMENT);
+    try {
+      this.Module._rls_weights(this.ptr, ptr);
+      const offset = ptr / Float32Array.BYTES_PER_ELEMENT;
+      return Array.from(this.Module.HEAPF32.subarray(offset, offset + this.features));
+    } finally {
+      this._free(ptr);
+    }
+  }
+
+  /** Fitted value of one observation */
+  predict(x: number[] | Float32Array): number {
+    if (x.length !== this.features) {
+      throw new Error(`RecursiveLeastSquares: expected ${this.features} features, got ${x.length}`);
+    }
+    this.reserve(this.features);
+    this.Module.HEAPF32.set(x, this._dataPtr / Float32Array.BYTES_PER_ELEMENT);
+    return this.Module._rls_predict(this.ptr, this._dataPtr);
+  }
+
+  /** Forget every observation */
+  reset() {
+    this.Module._rls_reset(this.ptr);
+  }
+
+  delete() {
+    if (!this.deleted) {
+      this.deleted = true;
+      if (this.bufferSize) {
+        this._free(this._dataPtr);
+      }
+      this.Module._rls_delete(this.ptr);
+    }
+  }
+
+  // y follows the rows of x in the staging buffer
+  private yPtr(rows: number): number {
+    return this._dataPtr + rows * this.features * Float32Array.BYTES_PER_ELEMENT;
+  }
+
+  /** Copy x and y into the staging buffer, returns the number of rows */
+  private stage(x: Rows, y: number | number[] | Float32Array): number {
+    const values = typeof y === 'number' ? [y] : y;
+    const rows = values.length;
+    const size = rows * this.features;
+    let flat: number[] | Float32Array;
+    if (x instanceof Tensor) {
+      const start = x.dataPtr / Float32Array.BYTES_PER_ELEMENT;
+      flat = this.Module.HEAPF32.subarray(start, start + x.rows * x.cols);
+    } else if (Array.isArray(x) && Array.isArray(x[0])) {
+      flat = (x as number[][]).flat();
+    } else {
+      flat = x as number[] | Float32Array;
+    }
+    if (flat.length !== size) {
+      throw new Error(`RecursiveLeastSquares: expected ${rows} x ${this.features} features, got ${flat.length} values`);
+    }
+    this.reserve(size + rows);
+    const offset = this._dataPtr / Float32Array.BYTES_PER_ELEMENT;
+    this.Module.HEAPF32.set(flat, offset);
+    this.Module.HEAPF32.set(values, offset + size);
+    return rows;
+  }
+
+  // the staging buffer only grows, so steady batch sizes never reallocate
+  private reserve(length: number) {
+    const size = length * Float32Array.BYTES_PER_ELEMENT;
+    if (size > this.bufferSize) {
+      if (this.bufferSize) {
+        this._free(this._dataPtr);
+      }
+      this._dataPtr = this.Module._malloc(size);
+      this.bufferSize = size;
+    }
+  }
+}
@@ -0,0 +1,119 @@
+import Interface from './Interface.js';
+
+/**
+ * Streams of a smoothing bank are the values of a frame, e.g. x and y of
+ * every keypoint of every person. Frames are smoothed in place, one call
+ * per frame.
+ */
+abstract class SmoothingBank extends Interface {
+  private bufferSize = 0;
+
+  /**
+   * Restart `count` streams from `start`, every stream by default. A restarted
+   * stream takes its next observation as is, e.g. when a tracked person is
+   * replaced.
+   */
+  reset(start = 0, count?: number) {
+    // size_t max, clamped natively to the frame
+    this.resetStreams(start, count ?? 0xffffffff);
+  }
+
+  delete() {
+    if (!this.deleted) {
+      this.deleted = true;
+      if (this.bufferSize) {
+        this._free(this._dataPtr);
+      }
+      this.destroy();
+    }
+  }
+
+  protected abstract resetStreams(start: number, count: number): void;
+  protected abstract destroy(): void;
+
+  /** Copy the frame in, run `smooth` on it and copy the result back */
+  protected smoothFrame(data: Float32Array, smooth: (dataPtr: number) => void) {
+    if (!(data instanceof Float32Array)) {
+      throw new Error("Input must be a Float32Array");
+    }
+    // the staging buffer only grows, so steady frame sizes never reallocate
+    const size = data.length * Float32Array.BYTES_PER_ELEMENT;
+    if (size > this.bufferSize) {
+      if (this.bufferSize) {
+        this._free(this._dataPtr);
+      }
+      this._dataPtr = this.Module._malloc(size);
+      this.bufferSize = size;
+    }
+    const offset = this._dataPtr / Float32Array.BYTES_PER_ELEMENT;
+    this.Module.HEAPF32.set(data, offset);
+    smooth(this._dataPtr);
+    data.set(this.Module.HEAPF32.subarray(offset, offset + data.length));
+  }
+}
+
+/**
+ * One Euro filter bank, a low pass whose cutoff rises with the speed of each
+ * stream: jitter is removed at rest without lagging fast motion.
+ * @example
+ * // 30 people x 33 keypoints x (x, y)
+ * const filter = new ft.OneEuroFilter(1, 0.01);
+ * const frame = new Float32Array(30 * 33 * 2);
+ * filter.update(frame, 1 / 30); // smoothed in place
+ * filter.reset(5 * 66, 66); // person 5 was replaced
+ */
+export class OneEuroFilter extends SmoothingBank {
+  /**
+   * @param minCutoff Hz, lower is smoother at rest
+   * @param beta cutoff gained per unit of speed, higher lags less
+   * @param dCutoff Hz, cutoff of the speed estimate
+   */
+  constructor(minCutoff = 1, beta = 0, dCutoff = 1) {
+    super();
+    this.ptr = this.Module._one_euro_create(minCutoff, beta, dCutoff);
+  }
+
+  /** Smooth a frame in place, `dt` is the time since the previous one in seconds */
+  update(data: Float32Array, dt: number) {
+    this.smoothFrame(data, dataPtr => this.Module._one_euro_update(this.ptr, dataPtr, data.length, dt));
+  }
+
+  protected resetStreams(start: number, count: number) {
+    this.Module._one_euro_reset(this.ptr, start, count);
+  }
+
+  protected destroy() {
+    this.Module._one_euro_delete(this.ptr);
+  }
+}
+
+/**
+ * Exponential smoothing bank, single or, with a `beta`, double (Holt) which
+ * follows a trend without the lag of single smoothing.
+ * @example
+ * const smoothing = new ft.ExponentialSmoothing(0.5, 0.3);
+ * smoothing.update(frame); // smoothed in place
+ */
+export class ExponentialSmoothing extends SmoothingBank {
+  /**
+   * @param alpha weight of the observation, 0 to 1
+   * @param beta weight of trend changes, 0 to 1, double smoothing when given
+   */
+  constructor(alpha = 0.5, beta?: number) {
+    super();
+    this.ptr = this.Module._exp_smoothing_create(alpha, beta ?? -1);
+  }
+
+  /** Smooth a frame in place */
+  update(data: Float32Array) {
+    this.smoothFrame(data, dataPtr => this.Module._exp_smoothing_update(this.ptr, dataPtr, data.length));
+  }
+
+  protected resetStreams(start: number, count: number) {
+    this.Module._exp_smoothing_reset(this.ptr, start, count);
+  }
+
+  protected destroy() {
+    this.Module._exp_smoothing_delete(this.ptr);
+  }
+}
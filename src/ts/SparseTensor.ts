@@ -0,0 +1,129 @@
+import Interface from './Interface.js';
+import { Tensor } from './Tensor.js';
+
+/**
+ * Sparse matrix in compressed sparse row (CSR) form, memory and products
+ * scale with the number of nonzeros rather than rows x cols.
+ * @example
+ * const adjacency = ft.SparseTensor.fromCOO([ 3, 3 ], [ 0, 1, 2 ], [ 1, 2, 0 ], [ 1, 1, 1 ]);
+ * adjacency.spmv(ft.tensor([ 1, 2, 3 ])).array(); // [ 2, 3, 1 ]
+ * adjacency.delete();
+ */
+export class SparseTensor extends Interface {
+  /**
+   * Keep the entries of `dense` with an absolute value above `tolerance`
+   * @param ptr - wrap an existing native sparse tensor instead
+   */
+  constructor(dense: Tensor | null, tolerance = 0, ptr?: number) {
+    super();
+    if (ptr !== undefined) {
+      this.ptr = ptr;
+      return;
+    }
+    if (!(dense instanceof Tensor)) {
+      throw new TypeError('Expected 1st argument to be of type Tensor');
+    }
+    this.ptr = this.Module._sparse_from_dense(dense.pointer, tolerance);
+  }
+
+  /**
+   * Build from coordinate (COO) triplets in any order, duplicate
+   * coordinates are summed
+   */
+  static fromCOO(
+    shape: [number, number],
+    rows: number[] | Tensor,
+    cols: number[] | Tensor,
+    values: number[] | Tensor
+  ): SparseTensor {
+    // arrays are staged in temporary tensors
+    const staged: Tensor[] = [];
+    const toTensor = (input: number[] | Tensor) => {
+      if (input instanceof Tensor) {
+        return input;
+      }
+      const staging = new Tensor(input);
+      staged.push(staging);
+      return staging;
+    };
+    try {
+      const ptr = Interface.Module._sparse_from_coo(
+        shape[0], shape[1], toTensor(rows).pointer, toTensor(cols).pointer, toTensor(values).pointer
+      );
+      return new SparseTensor(null, 0, ptr);
+    } finally {
+      staged.forEach(staging => staging.delete());
+    }
+  }
+
+  get rows(): number {
+    return this.Module._sparse_rows(this.ptr);
+  }
+
+  get cols(): number {
+    return this.Module._sparse_cols(this.ptr);
+  }
+
+  get shape(): [number, number] {
+    return [this.rows, this.cols];
+  }
+
+  /** Number of stored nonzeros */
+  get nnz(): number {
+    return this.Module._sparse_nnz(this.ptr);
+  }
+
+  toDense(): Tensor {
+    return Tensor.fromShapeWire(shapeWirePtr => this.Module._sparse_to_dense(this.ptr, shapeWirePtr));
+  }
+
+  /**
+   * Multiply by a vector with one value per column, a 1d tensor or a column
+   */
+  spmv(vec: Tensor): Tensor {
+    SparseTensor.checkTensor(vec);
+    return Tensor.fromShapeWire(shapeWirePtr => this.Module._sparse_spmv(this.ptr, vec.pointer, shapeWirePtr));
+  }
+
+  /**
+   * Multiply by a dense (cols x k) tensor, returns a dense (rows x k) tensor
+   */
+  spmm(dense: Tensor): Tensor {
+    SparseTensor.checkTensor(dense);
+    return Tensor.fromShapeWire(shapeWirePtr => this.Module._sparse_spmm(this.ptr, dense.pointer, shapeWirePtr));
+  }
+
+  transpose(): SparseTensor {
+    return new SparseTensor(null, 0, this.Module._sparse_transpose(this.ptr));
+  }
+
+  /** Multiply every nonzero by `factor` */
+  scale(factor: number): SparseTensor {
+    return new SparseTensor(null, 0, this.Module._sparse_scale(this.ptr, factor));
+  }
+
+  /** Multiply each row by the matching value of `factors` */
+  scaleRows(factors: Tensor): SparseTensor {
+    SparseTensor.checkTensor(factors);
+    return new SparseTensor(null, 0, this.Module._sparse_scale_rows(this.ptr, factors.pointer));
+  }
+
+  /** Multiply each column by the matching value of `factors` */
+  scaleCols(factors: Tensor): SparseTensor {
+    SparseTensor.checkTensor(factors);
+    return new SparseTensor(null, 0, this.Module._sparse_scale_cols(this.ptr, factors.pointer));
+  }
+
+  delete() {
+    if (!this.deleted) {
+      this.deleted = true;
+      this.Module._sparse_delete(this.ptr);
+    }
+  }
+
+  private static checkTensor(tensor: Tensor) {
+    if (!(tensor instanceof Tensor)) {
+      throw new TypeError('Expected 1st argument to be of type Tensor');
+    }
+  }
+}
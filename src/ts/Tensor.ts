@@ -5,10 +5,57 @@ export const NORM_ORD = {
   L1: 1,
   max: 2,
 } as const;
+export const DIST_METRIC = {
+  euclidean: 0,
+  sqeuclidean: 1,
+  cityblock: 2,
+  cosine: 3,
+} as const;
+export const CONV_MODE = {
+  full: 0,
+  same: 1,
+  valid: 2,
+} as const;
+export const FFT_FORMAT = {
+  complex: 0,
+  polar: 1,
+  magnitude: 2,
+} as const;
+export const MATH_MODE = {
+  precise: 0,
+  fast: 1,
+} as const;
+export const RANDOM_DIST = {
+  uniform: 0,
+  normal: 1,
+  truncatedNormal: 2,
+} as const;
+export const COMPARE_OP = {
+  equal: 0,
+  notEqual: 1,
+  greater: 2,
+  greaterEqual: 3,
+  less: 4,
+  lessEqual: 5,
+} as const;
+export const SCAN_OP = {
+  sum: 0,
+  prod: 1,
+  max: 2,
+  min: 3,
+} as const;
 export const NULL = Symbol('null');
 
 export type NormOrdKey = keyof typeof NORM_ORD; // 'L2' | 'L1' | 'max'
 type NormOrdValue = typeof NORM_ORD[NormOrdKey]; // 0 | 1 | 2
+export type DistMetricKey = keyof typeof DIST_METRIC;
+export type ConvModeKey = keyof typeof CONV_MODE;
+export type FFTFormatKey = keyof typeof FFT_FORMAT;
+/** 'fast' uses polynomial approximations (a few ulp) instead of libm */
+export type MathModeKey = keyof typeof MATH_MODE;
+export type RandomDistKey = keyof typeof RANDOM_DIST;
+export type CompareOpKey = keyof typeof COMPARE_OP;
+export type ScanOpKey = keyof typeof SCAN_OP;
 export type BufferData = Float32Array | Float64Array;
 /** @example [1, 2, 3, 4] */
 export type Array1d = number[];
@@ -20,6 +67,57 @@ type ShapeWireResult = [rows: number, cols: number, is1d: boolean];
 export type InputData = number | Array1d | Array2d | Tensor;
 export type OptionalNumber = number | null | undefined;
 export type OptionalBool = boolean | undefined;
+export interface OpProfile {
+  calls: number;
+  totalMs: number;
+  maxMs: number;
+  elements: number;
+  bytes: number;
+}
+// fields written per op by tensor_profile_snapshot
+const PROFILE_FIELDS = 5;
+// serialize::TensorHeader and serialize::BundleHeader (src/cpp/Serialize.h)
+const TENSOR_HEADER_BYTES = 32;
+const BUNDLE_HEADER_BYTES = 16;
+export interface MemoryInfo {
+  /** tensor handles held by JS */
+  pointers: number;
+  /** live native tensors */
+  tensors: number;
+  /** live data buffers, tensors sharing data (reshape, clone) count once */
+  buffers: number;
+  bytes: number;
+  peakBytes: number;
+  /** other native objects such as filters */
+  objects: number;
+  objectBytes: number;
+  heapSize: number;
+  heapUsed: number;
+  heapFree: number;
+  /** freed tensor storage kept for reuse, see `ft.trimMemory()` */
+  poolBytes: number;
+  /** allocations served from the pool */
+  poolHits: number;
+  /** allocations that went to the system allocator */
+  poolMisses: number;
+}
+export interface AllocationInfo {
+  bytes: number;
+  shape: Shape;
+  /** op that created the buffer */
+  site: string;
+}
+/** bounds of transformed points, z only for Nx3 points */
+export interface PointBounds {
+  xmin: number;
+  ymin: number;
+  zmin?: number;
+  xmax: number;
+  ymax: number;
+  zmax?: number;
+}
+// fields written by tensor_memory_stats
+const MEMORY_FIELDS = 12;
 
 
 interface InferedShape {
@@ -40,7 +138,8 @@ export class Tensor extends Interface {
   private is1d = false;
   private keepdims: boolean | null = null;
   protected static scopedInstances: Tensor[] = [];
-  protected static inScope = false;
+  // where each open scope starts in scopedInstances, innermost last
+  protected static scopeStarts: number[] = [];
   protected static activePointers = 0;
 
   constructor(data?: Data | typeof NULL, shape?: Shape, ptr?: OptionalNumber) {
@@ -58,7 +157,7 @@ export class Tensor extends Interface {
     if (data !== NULL) {
       this.setData(data);
     }
-    if (Tensor.inScope) {
+    if (Tensor.scopeStarts.length) {
       Tensor.scopedInstances.push(this);
     }
     Tensor.activePointers++;
@@ -129,13 +228,142 @@ export class Tensor extends Interface {
   }
 
   /**
-   * Returns the count of active pointers, useful for debugging memory management.
+   * Returns the count of active pointers along with the native accounting of
+   * live tensors, unique data buffers, their bytes and high-water mark, and the wasm heap.
    * @category Performance / Memory
    * @example
    * ft.memory();
+   * // { pointers: 2, tensors: 2, buffers: 1, bytes: 64, peakBytes: 128, ... }
+   */
+  static memory(): MemoryInfo {
+    const { Module } = Tensor;
+    const statsPtr = Module._malloc(MEMORY_FIELDS * Float64Array.BYTES_PER_ELEMENT);
+    Module._tensor_memory_stats(statsPtr);
+    const offset = statsPtr / Float64Array.BYTES_PER_ELEMENT;
+    const stats = Module.HEAPF64.slice(offset, offset + MEMORY_FIELDS);
+    Module._free(statsPtr);
+    return {
+      pointers: Tensor.activePointers,
+      tensors: stats[0],
+      buffers: stats[1],
+      bytes: stats[2],
+      peakBytes: stats[3],
+      objects: stats[4],
+      objectBytes: stats[5],
+      heapSize: stats[6],
+      heapUsed: stats[7],
+      heapFree: stats[8],
+      poolBytes: stats[9],
+      poolHits: stats[10],
+      poolMisses: stats[11],
+    };
+  }
+
+  /**
+   * Hand the freed tensor storage cached by the buffer pool back to the
+   * system allocator, e.g. after a one-off burst of large tensors.
+   * @category Performance / Memory
+   * @example
+   * ft.trimMemory();
+   * ft.memory().poolBytes; // 0
+   */
+  static trimMemory() {
+    Tensor.Module._tensor_memory_trim();
+  }
+
+  /**
+   * Reset the high-water mark reported by `ft.memory()` to the current usage.
+   * @category Performance / Memory
+   * @example
+   * ft.resetPeakMemory();
+   */
+  static resetPeakMemory() {
+    Tensor.Module._tensor_memory_reset_peak();
+  }
+
+  /**
+   * Lists the largest live buffers and the op that created them, only available
+   * in debug builds, otherwise an empty array is returned.
+   * @category Performance / Memory
+   * @example
+   * ft.memoryReport(5);
+   * // [ { bytes: 4000000, shape: [ 1000, 1000 ], site: 'matmul' }, ... ]
+   */
+  static memoryReport(limit = 10): AllocationInfo[] {
+    const { Module } = Tensor;
+    const size = Module._tensor_memory_report(0, 0, limit);
+    if (!size) {
+      return [];
+    }
+    const reportPtr = Module._malloc(size);
+    Module._tensor_memory_report(reportPtr, size, limit);
+    const report = new TextDecoder().decode(Module.HEAPU8.slice(reportPtr, reportPtr + size));
+    Module._free(reportPtr);
+    return report.split('\n').map((line) => {
+      const [bytes, shape, site] = line.split('\t');
+      return {
+        bytes: Number(bytes),
+        shape: shape.split('x').map(Number),
+        site,
+      };
+    });
+  }
+
+  /**
+   * Returns per-op call counts, timings, elements processed and bytes allocated,
+   * keyed by op name. Only populated by profiling builds (`make PROFILE=1` or the dev build),
+   * otherwise an empty object is returned.
+   * @category Performance / Memory
+   * @example
+   * ft.resetProfile();
+   * // run a frame ...
+   * const { matmul } = ft.profile();
+   * // matmul => { calls: 2, totalMs: 0.04, maxMs: 0.03, elements: 32, bytes: 64 }
+   */
+  static profile(): Record<string, OpProfile> {
+    const { Module } = Tensor;
+    const result: Record<string, OpProfile> = {};
+    const count = Module._tensor_profile_count();
+    if (!count) {
+      return result;
+    }
+    // op names are newline separated
+    const namesSize = Module._tensor_profile_names(0, 0);
+    const namesPtr = Module._malloc(namesSize);
+    Module._tensor_profile_names(namesPtr, namesSize);
+    const names = new TextDecoder()
+      .decode(Module.HEAPU8.slice(namesPtr, namesPtr + namesSize))
+      .split('\n');
+    Module._free(namesPtr);
+
+    const statsSize = count * PROFILE_FIELDS;
+    const statsPtr = Module._malloc(statsSize * Float64Array.BYTES_PER_ELEMENT);
+    Module._tensor_profile_snapshot(statsPtr);
+    const offset = statsPtr / Float64Array.BYTES_PER_ELEMENT;
+    const stats = Module.HEAPF64.slice(offset, offset + statsSize);
+    Module._free(statsPtr);
+
+    for (let i = 0; i < count; i++) {
+      const row = i * PROFILE_FIELDS;
+      result[names[i]] = {
+        calls: stats[row],
+        totalMs: stats[row + 1] / 1e6,
+        maxMs: stats[row + 2] / 1e6,
+        elements: stats[row + 3],
+        bytes: stats[row + 4],
+      };
+    }
+    return result;
+  }
+
+  /**
+   * Zero all counters recorded by a profiling build.
+   * @category Performance / Memory
+   * @example
+   * ft.resetProfile();
    */
-  static memory() {
-    return {pointers: Tensor.activePointers};
+  static resetProfile() {
+    Tensor.Module._tensor_profile_reset();
   }
 
   /**
@@ -160,9 +388,27 @@ export class Tensor extends Interface {
     return new Tensor(NULL, is1d ? shape.slice(1) : shape, newPtr);
   }
 
+  // `out` arguments must be live tensors, the op checks their shape natively
+  private static _outPointer(out: Tensor): number {
+    if (!(out instanceof Tensor)) {
+      throw new TypeError('Expected out to be of type Tensor');
+    }
+    if (out.deleted) {
+      throw new RangeError('Attempting to write into a deleted Tensor');
+    }
+    return out.ptr;
+  }
+
+  // An op wrote into this tensor, its buffer moves when it was shared with a clone
+  private _wrote(dataPtr: number, keepdims: OptionalBool = this.keepdims): this {
+    this._dataPtr = dataPtr;
+    this.keepdims = keepdims;
+    return this;
+  }
+
   /**
    * Start a scope to track any instances created. Should be used with `ft.endScope()`.
-   * See ft.scope() for a simpler approach.
+   * Scopes nest, see ft.scope() for a simpler approach.
    * @category Performance / Memory
    * @example
    * ft.beginScope();
@@ -173,12 +419,14 @@ export class Tensor extends Interface {
    * // a and b will have been freed from memory
    */
   static beginScope() {
-    Tensor.inScope = true;
+    Tensor.scopeStarts.push(Tensor.scopedInstances.length);
+    Tensor.Module._tensor_scope_begin();
   }
 
   /**
-   * End a scope of tracked instances. Should be used with `ft.beginScope()`.
+   * End the innermost scope of tracked instances. Should be used with `ft.beginScope()`.
    * See ft.scope() for a simpler approach.
+   * @param keep instance that survives the scope, it moves to the enclosing scope if any
    * @category Performance / Memory
    * @example
    * ft.beginScope();
@@ -188,8 +436,27 @@ export class Tensor extends Interface {
    * ft.endScope();
    * // a and b will have been freed from memory
    */
-  static endScope() {
-    Tensor.scope();
+  static endScope(keep?: Tensor) {
+    const start = Tensor.scopeStarts.pop();
+    if (start === undefined) {
+      throw new Error('endScope() called without a matching beginScope()');
+    }
+    const instances = Tensor.scopedInstances.splice(start);
+    // tombstone every instance found in scope
+    for (const mat of instances) {
+      if (mat !== keep && !mat.deleted) {
+        // reset pointer and mark as deleted
+        mat.ptr = 0;
+        mat.deleted = true;
+        Tensor.activePointers--;
+      }
+    }
+    // a kept tensor now belongs to the enclosing scope
+    if (keep && Tensor.scopeStarts.length && instances.includes(keep)) {
+      Tensor.scopedInstances.push(keep);
+    }
+    // the handle table recorded the same tensors, it clears them in one call
+    Tensor.Module._tensor_scope_end(keep ? keep.ptr : 0);
   }
 
   /**
@@ -228,6 +495,19 @@ export class Tensor extends Interface {
     return this._cols;
   }
 
+  /**
+   * Wrap a tensor created natively by `create`, which receives the shape wire pointer
+   * @hidden
+   */
+  static fromShapeWire(create: (shapeWirePtr: number) => number, keepdims: OptionalBool = false): Tensor {
+    const shapeWire = new ShapeWire();
+    const newPtr = create(shapeWire.ptr);
+    const mat = Tensor.fromPointer([1, 1], false, newPtr);
+    mat._syncShapeWire(shapeWire);
+    mat.keepdims = keepdims;
+    return mat;
+  }
+
   private _syncShapeWire(shapeWire: ShapeWire) {
     const result: ShapeWireResult = shapeWire.sync();
     this._rows = result[0];
@@ -237,7 +517,8 @@ export class Tensor extends Interface {
 
   /**
    * Start a scope to track any instances created, will automatically
-   * clear out any references not returned.
+   * clear out any references not returned. Scopes nest, a returned
+   * instance is tracked by the enclosing scope.
    * @category Performance / Memory
    * @example
    * ft.scope(() => {
@@ -258,8 +539,7 @@ export class Tensor extends Interface {
    * result.delete();
    */
   static scope(callback?: () => unknown): unknown {
-    const { Module } = Tensor;
-    Tensor.inScope = true;
+    Tensor.beginScope();
     let err;
     let result: unknown;
     try {
@@ -269,33 +549,11 @@ export class Tensor extends Interface {
     } catch (_err) {
       err = _err;
     }
-    Tensor.inScope = false;
-    // capture all pointers found in scope and tombstone them
-    const captured = [];
-    for (const mat of Tensor.scopedInstances) {
-      if (mat !== result && !mat.deleted) {
-        captured.push(mat.ptr);
-        // reset pointer and mark as deleted
-        mat.ptr = 0;
-        mat.deleted = true;
-        Tensor.activePointers--;
-      }
-    }
-    // Allocate space for the tombstones and build input
-    const count = captured.length;
-    const tombstones = new Uint32Array(captured);
-    const tombPtr = Module._malloc(count * tombstones.BYTES_PER_ELEMENT);
-    Tensor.Module.HEAPU32.set(tombstones, tombPtr / Uint32Array.BYTES_PER_ELEMENT);
     let internalError;
     try {
-      // clear them out
-      Module._tensor_batch_delete(tombPtr, count);
-      Module._free(tombPtr);
+      Tensor.endScope(result instanceof Tensor ? result : undefined);
     } catch (e) {
       internalError = e;
-    } finally {
-      // reset scope
-      Tensor.scopedInstances = [];
     }
     // handle errors
     if (internalError) {
@@ -359,8 +617,13 @@ export class Tensor extends Interface {
    * // tensor
    * ft.tensor([1, 2, 3, 4]).add(mat);
    */
-  add(input: InputData): Tensor {
+  add(input: InputData, out?: Tensor): Tensor {
     const args = this.wireArgs(input);
+    if (out) {
+      const dataPtr = this.Module._tensor_add_into(Tensor._outPointer(out), this.ptr, args.ptr, args.size);
+      args.free();
+      return out._wrote(dataPtr);
+    }
     const newPtr = this.Module._tensor_add(this.ptr, args.ptr, args.size);
     args.free();
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
@@ -376,8 +639,13 @@ export class Tensor extends Interface {
    * // tensor
    * ft.tensor([1, 2, 3, 4]).sub(mat);
    */
-  sub(input: InputData): Tensor {
+  sub(input: InputData, out?: Tensor): Tensor {
     const args = this.wireArgs(input);
+    if (out) {
+      const dataPtr = this.Module._tensor_sub_into(Tensor._outPointer(out), this.ptr, args.ptr, args.size);
+      args.free();
+      return out._wrote(dataPtr);
+    }
     const newPtr = this.Module._tensor_sub(this.ptr, args.ptr, args.size);
     args.free();
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
@@ -393,8 +661,13 @@ export class Tensor extends Interface {
    * // tensor
    * ft.tensor([1, 2, 3, 4]).mul(mat);
    */
-  mul(input: InputData): Tensor {
+  mul(input: InputData, out?: Tensor): Tensor {
     const args = this.wireArgs(input);
+    if (out) {
+      const dataPtr = this.Module._tensor_mul_into(Tensor._outPointer(out), this.ptr, args.ptr, args.size);
+      args.free();
+      return out._wrote(dataPtr);
+    }
     const newPtr = this.Module._tensor_mul(this.ptr, args.ptr, args.size);
     args.free();
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
@@ -410,8 +683,13 @@ export class Tensor extends Interface {
    * // tensor
    * ft.tensor([1, 2, 3, 4]).div(mat);
    */
-  div(input: InputData, noNan = false): Tensor {
+  div(input: InputData, noNan = false, out?: Tensor): Tensor {
     const args = this.wireArgs(input);
+    if (out) {
+      const dataPtr = this.Module._tensor_div_into(Tensor._outPointer(out), this.ptr, !!noNan, args.ptr, args.size);
+      args.free();
+      return out._wrote(dataPtr);
+    }
     const newPtr = this.Module._tensor_div(this.ptr, !!noNan, args.ptr, args.size);
     args.free();
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
@@ -427,8 +705,8 @@ export class Tensor extends Interface {
    * // tensor
    * ft.tensor([1, 2, 3, 4]).divNoNan(mat);
    */
-  divNoNan(input: InputData): Tensor {
-    return this.div(input, true);
+  divNoNan(input: InputData, out?: Tensor): Tensor {
+    return this.div(input, true, out);
   }
 
   /**
@@ -441,8 +719,13 @@ export class Tensor extends Interface {
    * // tensor
    * ft.tensor([1, 3, 4, 5]).maximum(mat);
    */
-  maximum(input: InputData): Tensor {
+  maximum(input: InputData, out?: Tensor): Tensor {
     const args = this.wireArgs(input);
+    if (out) {
+      const dataPtr = this.Module._tensor_maximum_into(Tensor._outPointer(out), this.ptr, args.ptr, args.size);
+      args.free();
+      return out._wrote(dataPtr);
+    }
     const newPtr = this.Module._tensor_maximum(this.ptr, args.ptr, args.size);
     args.free();
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
@@ -458,8 +741,13 @@ export class Tensor extends Interface {
    * // tensor
    * ft.tensor([0, 1, 2, 3]).minimum(mat);
    */
-  minimum(input: InputData): Tensor {
+  minimum(input: InputData, out?: Tensor): Tensor {
     const args = this.wireArgs(input);
+    if (out) {
+      const dataPtr = this.Module._tensor_minimum_into(Tensor._outPointer(out), this.ptr, args.ptr, args.size);
+      args.free();
+      return out._wrote(dataPtr);
+    }
     const newPtr = this.Module._tensor_minimum(this.ptr, args.ptr, args.size);
     args.free();
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
@@ -475,8 +763,13 @@ export class Tensor extends Interface {
    * // tensor
    * ft.tensor([2, 4, 6, 8]).mod(mat);
    */
-  mod(input: InputData): Tensor {
+  mod(input: InputData, out?: Tensor): Tensor {
     const args = this.wireArgs(input);
+    if (out) {
+      const dataPtr = this.Module._tensor_mod_into(Tensor._outPointer(out), this.ptr, args.ptr, args.size);
+      args.free();
+      return out._wrote(dataPtr);
+    }
     const newPtr = this.Module._tensor_mod(this.ptr, args.ptr, args.size);
     args.free();
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
@@ -492,8 +785,13 @@ export class Tensor extends Interface {
    * // tensor
    * ft.tensor([0, 1, 2, 3]).pow(mat);
    */
-  pow(input: InputData): Tensor {
+  pow(input: InputData, out?: Tensor): Tensor {
     const args = this.wireArgs(input);
+    if (out) {
+      const dataPtr = this.Module._tensor_pow_into(Tensor._outPointer(out), this.ptr, args.ptr, args.size);
+      args.free();
+      return out._wrote(dataPtr);
+    }
     const newPtr = this.Module._tensor_pow(this.ptr, args.ptr, args.size);
     args.free();
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
@@ -509,112 +807,392 @@ export class Tensor extends Interface {
    * // tensor
    * ft.tensor([0, 1, 2, 3]).squaredDifference(mat);
    */
-  squaredDifference(input: InputData): Tensor {
+  squaredDifference(input: InputData, out?: Tensor): Tensor {
     const args = this.wireArgs(input);
+    if (out) {
+      const dataPtr = this.Module._tensor_squared_diff_into(Tensor._outPointer(out), this.ptr, args.ptr, args.size);
+      args.free();
+      return out._wrote(dataPtr);
+    }
     const newPtr = this.Module._tensor_squared_diff(this.ptr, args.ptr, args.size);
     args.free();
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  abs(): Tensor {
+  abs(out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_abs_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_abs(this.ptr);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  acos(): Tensor {
+  acos(out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_acos_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_acos(this.ptr);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  acosh(): Tensor {
+  acosh(out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_acosh_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_acosh(this.ptr);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  asin(): Tensor {
+  asin(out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_asin_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_asin(this.ptr);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  asinh(): Tensor {
+  asinh(out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_asinh_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_asinh(this.ptr);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  atan(): Tensor {
-    const newPtr = this.Module._tensor_atan(this.ptr);
+  atan(mode?: MathModeKey, out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_atan_into(Tensor._outPointer(out), this.ptr, Tensor._mathMode(mode)));
+    }
+    const newPtr = this.Module._tensor_atan(this.ptr, Tensor._mathMode(mode));
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  atan2(input: InputData): Tensor {
+  atan2(input: InputData, mode?: MathModeKey, out?: Tensor): Tensor {
     const args = this.wireArgs(input);
-    const newPtr = this.Module._tensor_atan2(this.ptr, args.ptr, args.size);
+    if (out) {
+      const dataPtr = this.Module._tensor_atan2_into(Tensor._outPointer(out), this.ptr, args.ptr, args.size, Tensor._mathMode(mode));
+      args.free();
+      return out._wrote(dataPtr);
+    }
+    const newPtr = this.Module._tensor_atan2(this.ptr, args.ptr, args.size, Tensor._mathMode(mode));
     args.free();
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  atanh(): Tensor {
+  atanh(out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_atanh_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_atanh(this.ptr);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  ceil(): Tensor {
+  ceil(out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_ceil_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_ceil(this.ptr);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  clipByValue(lower: number, upper: number): Tensor {
+  clipByValue(lower: number, upper: number, out?: Tensor): Tensor {
     if (typeof lower !== 'number' || typeof upper !== 'number') {
       throw new TypeError('clipByValue expects args (lower<number>, upper<number>)');
     }
+    if (out) {
+      return out._wrote(this.Module._tensor_clip_into(Tensor._outPointer(out), this.ptr, lower, upper));
+    }
     const newPtr = this.Module._tensor_clip(this.ptr, lower, upper);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  cos(): Tensor {
-    const newPtr = this.Module._tensor_cos(this.ptr);
+  cos(mode?: MathModeKey, out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_cos_into(Tensor._outPointer(out), this.ptr, Tensor._mathMode(mode)));
+    }
+    const newPtr = this.Module._tensor_cos(this.ptr, Tensor._mathMode(mode));
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  cosh(): Tensor {
+  cosh(out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_cosh_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_cosh(this.ptr);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  floor(): Tensor {
+  exp(mode?: MathModeKey, out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_exp_into(Tensor._outPointer(out), this.ptr, Tensor._mathMode(mode)));
+    }
+    const newPtr = this.Module._tensor_exp(this.ptr, Tensor._mathMode(mode));
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /** @category Basic Math */
+  floor(out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_floor_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_floor(this.ptr);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
   /** @category Basic Math */
-  square(): Tensor {
+  log(mode?: MathModeKey, out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_log_into(Tensor._outPointer(out), this.ptr, Tensor._mathMode(mode)));
+    }
+    const newPtr = this.Module._tensor_log(this.ptr, Tensor._mathMode(mode));
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /**
+   * Computes 1 / (1 + e^-x)
+   * @category Basic Math
+   */
+  sigmoid(mode?: MathModeKey, out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_sigmoid_into(Tensor._outPointer(out), this.ptr, Tensor._mathMode(mode)));
+    }
+    const newPtr = this.Module._tensor_sigmoid(this.ptr, Tensor._mathMode(mode));
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /** @category Basic Math */
+  sin(mode?: MathModeKey, out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_sin_into(Tensor._outPointer(out), this.ptr, Tensor._mathMode(mode)));
+    }
+    const newPtr = this.Module._tensor_sin(this.ptr, Tensor._mathMode(mode));
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /** @category Basic Math */
+  square(out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_square_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_square(this.ptr);
     return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
   }
 
+  /** @category Basic Math */
+  tanh(mode?: MathModeKey, out?: Tensor): Tensor {
+    if (out) {
+      return out._wrote(this.Module._tensor_tanh_into(Tensor._outPointer(out), this.ptr, Tensor._mathMode(mode)));
+    }
+    const newPtr = this.Module._tensor_tanh(this.ptr, Tensor._mathMode(mode));
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /**
+   * Sets how sin, cos, atan, atan2, exp, log, tanh and sigmoid are computed when
+   * called without a mode. 'fast' uses vectorizable polynomial approximations
+   * within a few ulp (sin and cos to 2e-7 absolute for |x| <= 8192), several
+   * times faster than the default 'precise'.
+   * @category Basic Math
+   * @example
+   * ft.setMathMode('fast');
+   * mat.exp(); // approximated
+   * mat.exp('precise'); // libm for this call
+   */
+  static setMathMode(mode: MathModeKey) {
+    if (!(mode in MATH_MODE)) {
+      throw new Error(`Unknown math mode "${mode}"`);
+    }
+    Tensor.Module._tensor_set_math_mode(MATH_MODE[mode]);
+  }
+
+  /** @category Basic Math */
+  static getMathMode(): MathModeKey {
+    return Tensor.Module._tensor_get_math_mode() === MATH_MODE.fast ? 'fast' : 'precise';
+  }
+
+  /**
+   * -1 defers to the global mode
+   * @hidden
+   */
+  static _mathMode(mode?: MathModeKey): number {
+    if (mode === undefined) {
+      return -1;
+    }
+    if (!(mode in MATH_MODE)) {
+      throw new Error(`Unknown math mode "${mode}"`);
+    }
+    return MATH_MODE[mode];
+  }
+
+  private _compare(op: CompareOpKey, input: InputData, out?: Tensor): Tensor {
+    const args = this.wireArgs(input);
+    if (out) {
+      const dataPtr = this.Module._tensor_compare_into(Tensor._outPointer(out), this.ptr, COMPARE_OP[op], args.ptr, args.size);
+      args.free();
+      return out._wrote(dataPtr);
+    }
+    const newPtr = this.Module._tensor_compare(this.ptr, COMPARE_OP[op], args.ptr, args.size);
+    args.free();
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /**
+   * Mask of a == b element-wise, 1 where true and 0 elsewhere.
+   * @broadcast
+   * @category Logical
+   * @example
+   * ft.tensor([1, 2, 3]).equal(2); // [0, 1, 0]
+   */
+  equal(input: InputData, out?: Tensor): Tensor {
+    return this._compare('equal', input, out);
+  }
+
+  /**
+   * Mask of a != b element-wise.
+   * @broadcast
+   * @category Logical
+   */
+  notEqual(input: InputData, out?: Tensor): Tensor {
+    return this._compare('notEqual', input, out);
+  }
+
+  /**
+   * Mask of a > b element-wise.
+   * @broadcast
+   * @category Logical
+   * @example
+   * const scores = ft.tensor([0.2, 0.9, 0.6]);
+   * scores.greater(0.5); // [0, 1, 1]
+   */
+  greater(input: InputData, out?: Tensor): Tensor {
+    return this._compare('greater', input, out);
+  }
+
+  /**
+   * Mask of a >= b element-wise.
+   * @broadcast
+   * @category Logical
+   */
+  greaterEqual(input: InputData, out?: Tensor): Tensor {
+    return this._compare('greaterEqual', input, out);
+  }
+
+  /**
+   * Mask of a < b element-wise.
+   * @broadcast
+   * @category Logical
+   */
+  less(input: InputData, out?: Tensor): Tensor {
+    return this._compare('less', input, out);
+  }
+
+  /**
+   * Mask of a <= b element-wise.
+   * @broadcast
+   * @category Logical
+   */
+  lessEqual(input: InputData, out?: Tensor): Tensor {
+    return this._compare('lessEqual', input, out);
+  }
+
+  /**
+   * Values of `a` where `condition` is nonzero and of `b` elsewhere, both
+   * broadcast against the condition.
+   * @broadcast
+   * @category Logical
+   * @example
+   * const x = ft.tensor([-1, 2, -3]);
+   * ft.where(x.greater(0), x, 0); // [0, 2, 0]
+   */
+  static where(condition: Tensor, a: InputData, b: InputData, out?: Tensor): Tensor {
+    const aArgs = condition.wireArgs(a);
+    const bArgs = condition.wireArgs(b);
+    if (out) {
+      const dataPtr = Tensor.Module._tensor_where_into(
+        Tensor._outPointer(out), condition.ptr, aArgs.ptr, aArgs.size, bArgs.ptr, bArgs.size
+      );
+      aArgs.free();
+      bArgs.free();
+      return out._wrote(dataPtr);
+    }
+    const newPtr = Tensor.Module._tensor_where(condition.ptr, aArgs.ptr, aArgs.size, bArgs.ptr, bArgs.size);
+    aArgs.free();
+    bArgs.free();
+    return Tensor.fromPointer([condition._rows, condition._cols], condition.is1d, newPtr);
+  }
+
+  /**
+   * Replace values with `value` where the mask is nonzero.
+   * @broadcast
+   * @category Logical
+   * @example
+   * const mat = ft.tensor([1, NaN, 3]);
+   * mat.maskedFill(mat.notEqual(mat), 0); // [1, 0, 3]
+   */
+  maskedFill(mask: InputData, value: number, out?: Tensor): Tensor {
+    const args = this.wireArgs(mask);
+    if (out) {
+      const dataPtr = this.Module._tensor_masked_fill_into(Tensor._outPointer(out), this.ptr, args.ptr, args.size, value);
+      args.free();
+      return out._wrote(dataPtr);
+    }
+    const newPtr = this.Module._tensor_masked_fill(this.ptr, args.ptr, args.size, value);
+    args.free();
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /**
+   * Keep the rows (axis 0) or columns (axis 1) where the mask is nonzero,
+   * densely packed. Without an axis the mask has a value per element and the
+   * kept values are returned flat.
+   * @category Logical
+   * @example
+   * // drop low confidence detections, [x, y, w, h] rows
+   * const boxes = ft.tensor([ [ 0, 0, 4, 4 ], [ 1, 1, 2, 2 ] ]);
+   * const scores = ft.tensor([0.9, 0.1]);
+   * const kept = boxes.booleanMask(scores.greater(0.5), 0); // first row
+   */
+  booleanMask(mask: InputData, axis: OptionalNumber = -1): Tensor {
+    // if null change to -1
+    axis ??= -1;
+    if (this.is1d && axis > -1) {
+      throw new Error('Attempting to perform op on a 1d array with axis, remove axis');
+    }
+    const args = this.wireArgs(mask);
+    const shapeWire = new ShapeWire();
+    const newPtr = this.Module._tensor_boolean_mask(this.ptr, args.ptr, args.size, axis, shapeWire.ptr);
+    args.free();
+    const mat = Tensor.fromPointer([this._rows, this._cols], false, newPtr);
+    mat._syncShapeWire(shapeWire);
+    return mat;
+  }
+
   /**
    * Returns the logical "and" of values along an axis.
    * @category Reduction
    */
-  all(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+  all(axis: OptionalNumber = -1, keepdims: OptionalBool = false, out?: Tensor): Tensor {
     // if null change to -1
     axis ??= -1;
     if (this.is1d && axis > -1) {
       throw new Error('Attempting to perform op on a 1d array with axis, remove axis');
     }
+    if (out) {
+      return out._wrote(this.Module._tensor_all_into(Tensor._outPointer(out), this.ptr, axis), keepdims);
+    }
     const shapeWire = new ShapeWire();
     const newPtr = this.Module._tensor_all(this.ptr, axis, keepdims, shapeWire.ptr);
     const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
@@ -627,12 +1205,15 @@ export class Tensor extends Interface {
    * Returns the logical "or" of values along an axis.
    * @category Reduction
    */
-  any(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+  any(axis: OptionalNumber = -1, keepdims: OptionalBool = false, out?: Tensor): Tensor {
     // if null change to -1
     axis ??= -1;
     if (this.is1d && axis > -1) {
       throw new Error('Attempting to perform op on a 1d array with axis, remove axis');
     }
+    if (out) {
+      return out._wrote(this.Module._tensor_any_into(Tensor._outPointer(out), this.ptr, axis), keepdims);
+    }
     const shapeWire = new ShapeWire();
     const newPtr = this.Module._tensor_any(this.ptr, axis, keepdims, shapeWire.ptr);
     const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
@@ -645,7 +1226,7 @@ export class Tensor extends Interface {
    * Returns the indices of the maximum values along an axis.
    * @category Reduction
    */
-  argMax(axis: OptionalNumber = 0): Tensor {
+  argMax(axis: OptionalNumber = 0, out?: Tensor): Tensor {
     // if null change to 0
     axis ??= 0;
     if (this.is1d && axis !== 0) {
@@ -653,6 +1234,9 @@ export class Tensor extends Interface {
     } else if (!this.is1d && (axis < 0 || axis > 1)) {
       throw new Error(`argMax expects axis to be 0 or 1`);
     }
+    if (out) {
+      return out._wrote(this.Module._tensor_arg_max_into(Tensor._outPointer(out), this.ptr, axis), false);
+    }
     const shapeWire = new ShapeWire();
     const newPtr = this.Module._tensor_arg_max(this.ptr, axis, shapeWire.ptr);
     const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
@@ -665,7 +1249,7 @@ export class Tensor extends Interface {
    * Returns the indices of the minimum values along an axis.
    * @category Reduction
    */
-  argMin(axis: OptionalNumber = 0): Tensor {
+  argMin(axis: OptionalNumber = 0, out?: Tensor): Tensor {
     // if null change to 0
     axis ??= 0;
     if (this.is1d && axis !== 0) {
@@ -673,6 +1257,9 @@ export class Tensor extends Interface {
     } else if (!this.is1d && (axis < 0 || axis > 1)) {
       throw new Error(`argMin expects axis to be 0 or 1`);
     }
+    if (out) {
+      return out._wrote(this.Module._tensor_arg_min_into(Tensor._outPointer(out), this.ptr, axis), false);
+    }
     const shapeWire = new ShapeWire();
     const newPtr = this.Module._tensor_arg_min(this.ptr, axis, shapeWire.ptr);
     const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
@@ -682,51 +1269,326 @@ export class Tensor extends Interface {
   }
 
   /**
-   * Computes the maximum of all elements across the axis
-   * @category Reduction 
+   * Convolves every row (axis 1, the default) or column (axis 0) with `kernel`, zero padding
+   * the edges. `mode` returns the full convolution, the input length centered (same),
+   * or only where the kernel fully overlaps (valid). Kernels of 64 taps or more use FFT overlap-add.
+   * @category Filtering
+   * @example
+   * const smoothed = signal.conv1d(ft.Tensor.movingAverageKernel(5), 'same');
    */
-  max(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
-    // if null change to -1
-    axis ??= -1;
-    if (this.is1d && axis > -1) {
-      throw new Error('Attempting to perform max on a 1d array with axis, remove axis');
+  conv1d(kernel: InputData, mode: ConvModeKey = 'full', axis: OptionalNumber = null): Tensor {
+    if (!(mode in CONV_MODE)) {
+      throw new Error(`Unknown convolution mode "${mode}"`);
     }
+    axis = this._laneAxis('conv1d', axis);
+    const args = this.wireArgs(kernel);
     const shapeWire = new ShapeWire();
-    const newPtr = this.Module._tensor_max(this.ptr, axis, keepdims, shapeWire.ptr);
-    const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
+    const newPtr = this.Module._tensor_conv1d(this.ptr, args.ptr, args.size, axis, CONV_MODE[mode], shapeWire.ptr);
+    args.free();
+    const mat = Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
     mat._syncShapeWire(shapeWire);
-    mat.keepdims = keepdims;
     return mat;
   }
 
   /**
-   * Computes the mean of all elements across the axis
-   * @category Reduction 
+   * A `window` tap kernel averaging its inputs, for use with `conv1d`.
+   * @category Filtering
    */
-  mean(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
-    // if null change to -1
-    axis ??= -1;
-    if (this.is1d && axis > -1) {
-      throw new Error('Attempting to mean a 1d array with axis, remove axis');
+  static movingAverageKernel(window: number): Tensor {
+    const newPtr = Tensor.Module._tensor_moving_average_kernel(window);
+    return Tensor.fromPointer([1, window], true, newPtr);
+  }
+
+  /**
+   * Savitzky-Golay kernel fitting a polynomial of `order` over an odd `window`,
+   * `deriv` > 0 returns the derivative (per sample) instead, for use with `conv1d`.
+   * @category Filtering
+   * @example
+   * const smoothed = signal.conv1d(ft.Tensor.savgolKernel(7, 2), 'same');
+   */
+  static savgolKernel(window: number, order: number, deriv = 0): Tensor {
+    const newPtr = Tensor.Module._tensor_savgol_kernel(window, order, deriv);
+    return Tensor.fromPointer([1, window], true, newPtr);
+  }
+
+  /**
+   * Real FFT of every row (axis 1, the default) or column (axis 0). The n / 2 + 1
+   * non-negative frequency bins are written along the same axis as interleaved
+   * (re, im) pairs, (magnitude, phase) pairs with 'polar', or just magnitudes.
+   * Plans are cached by size, so repeating a size only pays for the transform.
+   * @category Spectral
+   * @example
+   * ft.tensor([ 1, 2, 3, 4 ]).rfft().array(); // [ 10, 0, -2, 2, -2, 0 ]
+   */
+  rfft(axis: OptionalNumber = null, format: FFTFormatKey = 'complex'): Tensor {
+    if (!(format in FFT_FORMAT)) {
+      throw new Error(`Unknown FFT format "${format}"`);
     }
+    axis = this._laneAxis('rfft', axis);
     const shapeWire = new ShapeWire();
-    const newPtr = this.Module._tensor_mean(this.ptr, axis, keepdims, shapeWire.ptr);
-    const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
+    const newPtr = this.Module._tensor_rfft(this.ptr, axis, FFT_FORMAT[format], shapeWire.ptr);
+    const mat = Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
     mat._syncShapeWire(shapeWire);
-    mat.keepdims = keepdims;
     return mat;
   }
 
   /**
-   * Computes the minimum of all elements across the axis
-   * @category Reduction 
+   * Inverse of `rfft` for interleaved (re, im) bins, `n` is the signal length
+   * and defaults to the even length the bins came from.
+   * @category Spectral
+   * @example
+   * signal.rfft().irfft(); // signal
    */
-  min(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
-    // if null change to -1
+  irfft(n = 0, axis: OptionalNumber = null): Tensor {
+    axis = this._laneAxis('irfft', axis);
+    const shapeWire = new ShapeWire();
+    const newPtr = this.Module._tensor_irfft(this.ptr, n, axis, shapeWire.ptr);
+    const mat = Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+    mat._syncShapeWire(shapeWire);
+    return mat;
+  }
+
+  /**
+   * Complex FFT of interleaved (re, im) pairs along rows (axis 1, the default)
+   * or columns (axis 0), any length is supported.
+   * @category Spectral
+   * @example
+   * ft.tensor([ 1, 0, 0, 1 ]).fft().array(); // [ 1, 1, 1, -1 ]
+   */
+  fft(axis: OptionalNumber = null, format: FFTFormatKey = 'complex'): Tensor {
+    return this._fft('fft', axis, false, format);
+  }
+
+  /**
+   * Inverse of `fft`, scaled by 1 / n.
+   * @category Spectral
+   */
+  ifft(axis: OptionalNumber = null, format: FFTFormatKey = 'complex'): Tensor {
+    return this._fft('ifft', axis, true, format);
+  }
+
+  /**
+   * Release the cached FFT plans, they are rebuilt on the next transform.
+   * @category Spectral
+   */
+  static clearFFTPlans() {
+    Tensor.Module._tensor_fft_clear_plans();
+  }
+
+  private _fft(op: string, axis: OptionalNumber, inverse: boolean, format: FFTFormatKey): Tensor {
+    if (!(format in FFT_FORMAT)) {
+      throw new Error(`Unknown FFT format "${format}"`);
+    }
+    axis = this._laneAxis(op, axis);
+    const shapeWire = new ShapeWire();
+    const newPtr = this.Module._tensor_fft(this.ptr, axis, inverse, FFT_FORMAT[format], shapeWire.ptr);
+    const mat = Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+    mat._syncShapeWire(shapeWire);
+    return mat;
+  }
+
+  /**
+   * Counts of values in `bins` equal bins over `range`, values outside it are
+   * left out and the upper edge belongs to the last bin. The range defaults to
+   * the min and max of the finite values. Along an axis the reduced axis is
+   * replaced by the bins. Bin edges are `ft.linspace(low, high, bins + 1)`.
+   * @category Statistics
+   * @example
+   * ft.tensor([1, 2, 2, 3, 9]).histogram(4, [0, 8]); // [1, 3, 0, 0]
+   * // a histogram per column, shaped [bins, cols]
+   * ft.tensor([ [ 1, 5 ], [ 3, 2 ] ]).histogram(2, [0, 6], 0);
+   */
+  histogram(bins = 10, range?: [number, number], axis: OptionalNumber = -1): Tensor {
+    // if null change to -1
+    axis ??= -1;
+    if (this.is1d && axis > -1) {
+      throw new Error('Attempting to perform histogram on a 1d array with axis, remove axis');
+    }
+    if (!Number.isInteger(bins) || bins < 1) {
+      throw new RangeError('Tensor.histogram(): bins must be a positive integer');
+    }
+    // NaN bounds ask for the range of the finite values
+    const [low, high] = range ?? [NaN, NaN];
+    if (range && !(low < high && Number.isFinite(low) && Number.isFinite(high))) {
+      throw new RangeError('Tensor.histogram(): range must be [low, high] with finite low < high');
+    }
+    const shapeWire = new ShapeWire();
+    const newPtr = this.Module._tensor_histogram(this.ptr, bins, low, high, axis, shapeWire.ptr);
+    const mat = Tensor.fromPointer([1, 1], false, newPtr);
+    mat._syncShapeWire(shapeWire);
+    return mat;
+  }
+
+  /**
+   * Occurrences of each non-negative integer value, or the sum of their
+   * `weights`. The result has max(values) + 1 entries, at least `minLength`.
+   * @category Statistics
+   * @example
+   * ft.tensor([0, 1, 1, 3]).bincount(); // [1, 2, 0, 1]
+   */
+  bincount(weights?: InputData, minLength = 0): Tensor {
+    const args = weights === undefined ? null : this.wireArgs(weights);
+    const shapeWire = new ShapeWire();
+    const newPtr = this.Module._tensor_bincount(this.ptr, minLength, args ? args.ptr : 0, args ? args.size : 0, shapeWire.ptr);
+    args?.free();
+    const mat = Tensor.fromPointer([1, 1], false, newPtr);
+    mat._syncShapeWire(shapeWire);
+    return mat;
+  }
+
+  /**
+   * Quantiles by selection (no full sort) with linear interpolation between
+   * the closest values, NaN values are skipped. A single quantile is shaped
+   * like a reduction, several replace the reduced axis.
+   * @category Statistics
+   * @example
+   * const latency = ft.tensor([12, 15, 11, 40, 13]);
+   * latency.quantile(0.5); // 13
+   * latency.quantile([0.5, 0.9, 0.99]);
+   */
+  quantile(q: number | Array1d, axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+    // if null change to -1
+    axis ??= -1;
+    if (this.is1d && axis > -1) {
+      throw new Error('Attempting to perform quantile on a 1d array with axis, remove axis');
+    }
+    const qs = typeof q === 'number' ? [q] : q;
+    if (qs.length === 0) {
+      throw new RangeError('Tensor.quantile(): expects at least one quantile');
+    }
+    const args = this.wireArgs(qs);
+    const shapeWire = new ShapeWire();
+    const newPtr = this.Module._tensor_quantile(this.ptr, args.ptr, args.size, axis, keepdims, shapeWire.ptr);
+    args.free();
+    const mat = Tensor.fromPointer([1, 1], false, newPtr);
+    mat._syncShapeWire(shapeWire);
+    if (qs.length === 1) {
+      mat.keepdims = keepdims;
+    }
+    return mat;
+  }
+
+  /**
+   * Median along an axis, the 0.5 quantile
+   * @category Statistics
+   */
+  median(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+    return this.quantile(0.5, axis, keepdims);
+  }
+
+  /**
+   * Sorts values along an axis, rows (axis 1) by default.
+   * @category Sorting
+   * @example
+   * ft.tensor([ [ 3, 1, 2 ], [ 0, 5, 4 ] ]).sort().array(); // [ [ 1, 2, 3 ], [ 0, 4, 5 ] ]
+   */
+  sort(axis: OptionalNumber = null, descending = false): Tensor {
+    axis = this._laneAxis('sort', axis);
+    const newPtr = this.Module._tensor_sort(this.ptr, axis, descending);
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /**
+   * Returns the indices that would sort values along an axis, rows (axis 1) by default.
+   * Equal values keep their original order.
+   * @category Sorting
+   * @example
+   * ft.tensor([ 3, 1, 2 ]).argsort().array(); // [ 1, 2, 0 ]
+   */
+  argsort(axis: OptionalNumber = null, descending = false): Tensor {
+    axis = this._laneAxis('argsort', axis);
+    const newPtr = this.Module._tensor_argsort(this.ptr, axis, descending);
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /**
+   * Finds the `k` largest (or smallest) values along an axis, rows (axis 1) by default,
+   * in linear time. Returns [values, indices], best first.
+   * @category Sorting
+   * @example
+   * const [ values, indices ] = ft.tensor([ 1, 9, 3, 7 ]).topk(2);
+   * // values => [ 9, 7 ], indices => [ 1, 3 ]
+   */
+  topk(k: number, axis: OptionalNumber = null, largest = true): [Tensor, Tensor] {
+    axis = this._laneAxis('topk', axis);
+    const alongRows = this.is1d || axis === 1;
+    const indices = Tensor.zeros(this.is1d ? [k] : alongRows ? [this._rows, k] : [k, this._cols]);
+    const shapeWire = new ShapeWire();
+    const newPtr = this.Module._tensor_topk(this.ptr, k, axis, largest, indices.ptr, shapeWire.ptr);
+    const values = Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+    values._syncShapeWire(shapeWire);
+    return [values, indices];
+  }
+
+  private _laneAxis(op: string, axis: OptionalNumber): number {
+    if (this.is1d) {
+      if (axis !== null && axis !== undefined && axis !== 0) {
+        throw new Error(`${op} received axis=${axis} on 1d array, remove axis`);
+      }
+      return 0;
+    }
+    axis ??= 1;
+    if (axis !== 0 && axis !== 1) {
+      throw new Error(`${op} expects axis to be 0 or 1`);
+    }
+    return axis;
+  }
+
+  /**
+   * Computes the maximum of all elements across the axis
+   * @category Reduction 
+   */
+  max(axis: OptionalNumber = -1, keepdims: OptionalBool = false, out?: Tensor): Tensor {
+    // if null change to -1
+    axis ??= -1;
+    if (this.is1d && axis > -1) {
+      throw new Error('Attempting to perform max on a 1d array with axis, remove axis');
+    }
+    if (out) {
+      return out._wrote(this.Module._tensor_max_into(Tensor._outPointer(out), this.ptr, axis), keepdims);
+    }
+    const shapeWire = new ShapeWire();
+    const newPtr = this.Module._tensor_max(this.ptr, axis, keepdims, shapeWire.ptr);
+    const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
+    mat._syncShapeWire(shapeWire);
+    mat.keepdims = keepdims;
+    return mat;
+  }
+
+  /**
+   * Computes the mean of all elements across the axis
+   * @category Reduction 
+   */
+  mean(axis: OptionalNumber = -1, keepdims: OptionalBool = false, out?: Tensor): Tensor {
+    // if null change to -1
+    axis ??= -1;
+    if (this.is1d && axis > -1) {
+      throw new Error('Attempting to mean a 1d array with axis, remove axis');
+    }
+    if (out) {
+      return out._wrote(this.Module._tensor_mean_into(Tensor._outPointer(out), this.ptr, axis), keepdims);
+    }
+    const shapeWire = new ShapeWire();
+    const newPtr = this.Module._tensor_mean(this.ptr, axis, keepdims, shapeWire.ptr);
+    const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
+    mat._syncShapeWire(shapeWire);
+    mat.keepdims = keepdims;
+    return mat;
+  }
+
+  /**
+   * Computes the minimum of all elements across the axis
+   * @category Reduction 
+   */
+  min(axis: OptionalNumber = -1, keepdims: OptionalBool = false, out?: Tensor): Tensor {
+    // if null change to -1
     axis ??= -1;
     if (this.is1d && axis > -1) {
       throw new Error('Attempting to perform min on a 1d array with axis, remove axis');
     }
+    if (out) {
+      return out._wrote(this.Module._tensor_min_into(Tensor._outPointer(out), this.ptr, axis), keepdims);
+    }
     const shapeWire = new ShapeWire();
     const newPtr = this.Module._tensor_min(this.ptr, axis, keepdims, shapeWire.ptr);
     const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
@@ -739,12 +1601,15 @@ export class Tensor extends Interface {
    * Computes the product of all elements across the axis
    * @category Reduction 
    */
-  prod(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+  prod(axis: OptionalNumber = -1, keepdims: OptionalBool = false, out?: Tensor): Tensor {
     // if null change to -1
     axis ??= -1;
     if (this.is1d && axis > -1) {
       throw new Error('Attempting to perform prod on a 1d array with axis, remove axis');
     }
+    if (out) {
+      return out._wrote(this.Module._tensor_prod_into(Tensor._outPointer(out), this.ptr, axis), keepdims);
+    }
     const shapeWire = new ShapeWire();
     const newPtr = this.Module._tensor_prod(this.ptr, axis, keepdims, shapeWire.ptr);
     const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
@@ -757,12 +1622,15 @@ export class Tensor extends Interface {
    * Computes the sum of all elements across the axis
    * @category Reduction 
    */
-  sum(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+  sum(axis: OptionalNumber = -1, keepdims: OptionalBool = false, out?: Tensor): Tensor {
     // if null change to -1
     axis ??= -1;
     if (this.is1d && axis > -1) {
       throw new Error('Attempting to perform sum on a 1d array with axis, remove axis');
     }
+    if (out) {
+      return out._wrote(this.Module._tensor_sum_into(Tensor._outPointer(out), this.ptr, axis), keepdims);
+    }
     const shapeWire = new ShapeWire();
     const newPtr = this.Module._tensor_sum(this.ptr, axis, keepdims, shapeWire.ptr);
     const mat = Tensor.fromPointer([this._rows, this._cols], axis < 0, newPtr);
@@ -771,6 +1639,58 @@ export class Tensor extends Interface {
     return mat;
   }
 
+  private _scan(op: ScanOpKey, axis: OptionalNumber, exclusive: OptionalBool, out?: Tensor): Tensor {
+    // if null change to -1
+    axis ??= -1;
+    if (this.is1d && axis > -1) {
+      throw new Error(`Attempting to perform cum${op} on a 1d array with axis, remove axis`);
+    }
+    if (out) {
+      return out._wrote(this.Module._tensor_scan_into(Tensor._outPointer(out), this.ptr, SCAN_OP[op], axis, !!exclusive));
+    }
+    const newPtr = this.Module._tensor_scan(this.ptr, SCAN_OP[op], axis, !!exclusive);
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /**
+   * Running sum along an axis, the result keeps the shape. Without an axis
+   * the values are summed in order. `exclusive` leaves out the current value.
+   * @category Reduction
+   * @example
+   * ft.tensor([1, 2, 3]).cumsum(); // [1, 3, 6]
+   * ft.tensor([1, 2, 3]).cumsum(null, true); // [0, 1, 3]
+   * // summed area table
+   * const image = ft.tensor([ [ 1, 2 ], [ 3, 4 ] ]);
+   * image.cumsum(0).cumsum(1); // [ [ 1, 3 ], [ 4, 10 ] ]
+   */
+  cumsum(axis: OptionalNumber = -1, exclusive: OptionalBool = false, out?: Tensor): Tensor {
+    return this._scan('sum', axis, exclusive, out);
+  }
+
+  /**
+   * Running product along an axis, exclusive scans start from 1.
+   * @category Reduction
+   */
+  cumprod(axis: OptionalNumber = -1, exclusive: OptionalBool = false, out?: Tensor): Tensor {
+    return this._scan('prod', axis, exclusive, out);
+  }
+
+  /**
+   * Running maximum along an axis, exclusive scans start from -Infinity.
+   * @category Reduction
+   */
+  cummax(axis: OptionalNumber = -1, exclusive: OptionalBool = false, out?: Tensor): Tensor {
+    return this._scan('max', axis, exclusive, out);
+  }
+
+  /**
+   * Running minimum along an axis, exclusive scans start from Infinity.
+   * @category Reduction
+   */
+  cummin(axis: OptionalNumber = -1, exclusive: OptionalBool = false, out?: Tensor): Tensor {
+    return this._scan('min', axis, exclusive, out);
+  }
+
   /**
    * @category Matrices
    */
@@ -802,14 +1722,72 @@ export class Tensor extends Interface {
     return [Q, R];
   }
 
+  /**
+   * QR of A + u vᵀ from the QR of A in O(m²) rotations instead of a new
+   * decomposition, e.g. when one entry or row of A changes.
+   * `q` and `r` are left as they are.
+   * @category Linear Algebra
+   * @example
+   * const [q, r] = a.qr();
+   * const [q2, r2] = ft.Tensor.qrUpdate(q, r, u, v); // q2.matMul(r2) ≈ a + u vᵀ
+   */
+  static qrUpdate(q: Tensor, r: Tensor, u: InputData, v: InputData): [Tensor, Tensor] {
+    const Q = q.clone();
+    const uArgs = r.wireArgs(u);
+    const vArgs = r.wireArgs(v);
+    let newPtr;
+    try {
+      newPtr = r.Module._tensor_qr_update(r.ptr, Q.ptr, uArgs.ptr, uArgs.size, vArgs.ptr, vArgs.size);
+    } catch (error) {
+      Q.delete();
+      throw error;
+    } finally {
+      uArgs.free();
+      vArgs.free();
+    }
+    // the rotations moved Q off the buffer it shared with q
+    Q._wrote(r.Module._tensor_get_data_ptr(Q.ptr));
+    const R = Tensor.fromPointer([r._rows, r._cols], false, newPtr);
+    return [Q, R];
+  }
+
+  /**
+   * Lower triangular L with L Lᵀ equal to this symmetric positive definite
+   * matrix
+   * @category Linear Algebra
+   */
+  cholesky(): Tensor {
+    const newPtr = this.Module._tensor_cholesky(this.ptr);
+    return Tensor.fromPointer([this._rows, this._cols], false, newPtr);
+  }
+
+  /**
+   * Cholesky factor of L Lᵀ + x xᵀ, or L Lᵀ - x xᵀ with `downdate`, from
+   * this factor L in O(n²). Throws when a downdate leaves the matrix
+   * indefinite.
+   * @category Linear Algebra
+   * @example
+   * const l = cov.cholesky();
+   * const l2 = l.choleskyUpdate(sample); // factor of cov + sample sampleᵀ
+   */
+  choleskyUpdate(x: InputData, downdate = false): Tensor {
+    const args = this.wireArgs(x);
+    const newPtr = this.Module._tensor_cholesky_update(this.ptr, args.ptr, args.size, downdate);
+    args.free();
+    return Tensor.fromPointer([this._rows, this._cols], false, newPtr);
+  }
+
   // TODO move shapewire ptr to 2nd arg (standardize)
   /**
    * @category Matrices
    */
-  matMul(tensor: Tensor): Tensor {
+  matMul(tensor: Tensor, out?: Tensor): Tensor {
     if (!(tensor instanceof Tensor)) {
       throw new TypeError('Expected 1st argument to be of type Tensor');
     }
+    if (out) {
+      return out._wrote(this.Module._tensor_matmul_into(Tensor._outPointer(out), this.ptr, tensor.ptr));
+    }
     const shapeWire = new ShapeWire();
     const newPtr = this.Module._tensor_matmul(this.ptr, tensor.ptr, shapeWire.ptr);
     const mat = Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
@@ -817,6 +1795,78 @@ export class Tensor extends Interface {
     return mat;
   }
 
+  /**
+   * Pairwise distances between the rows (points) of this tensor and `tensor`,
+   * returns an N x M matrix. A 1d tensor is treated as a single point.
+   * @category Matrices
+   * @example
+   * const detections = ft.tensor([ [ 0, 0 ], [ 3, 4 ] ]);
+   * const tracks = ft.tensor([ [ 0, 0 ], [ 6, 8 ] ]);
+   * detections.cdist(tracks).array(); // [ [ 0, 10 ], [ 5, 5 ] ]
+   */
+  cdist(tensor: Tensor, metric: DistMetricKey = 'euclidean'): Tensor {
+    if (!(tensor instanceof Tensor)) {
+      throw new TypeError('Expected 1st argument to be of type Tensor');
+    }
+    if (!(metric in DIST_METRIC)) {
+      throw new Error(`Unknown distance metric "${metric}"`);
+    }
+    const shapeWire = new ShapeWire();
+    const newPtr = this.Module._tensor_cdist(this.ptr, tensor.ptr, DIST_METRIC[metric], shapeWire.ptr);
+    const mat = Tensor.fromPointer([this._rows, this._cols], false, newPtr);
+    mat._syncShapeWire(shapeWire);
+    return mat;
+  }
+
+  /**
+   * Transform the rows (points) of an Nx2 or Nx3 tensor in one pass. Nx2
+   * points take a 2x3 affine or 3x3 homogeneous matrix, Nx3 points a 3x3
+   * linear, 3x4 affine or 4x4 homogeneous one. Homogeneous results are
+   * divided by w unless `divide` is false.
+   * @category Matrices
+   * @example
+   * const points = ft.tensor([ [ 1, 0 ], [ 0, 1 ] ]);
+   * // rotate 90 degrees then move by (10, 20)
+   * const m = ft.tensor([ [ 0, -1, 10 ], [ 1, 0, 20 ] ]);
+   * points.transformPoints(m).array(); // [ [ 10, 21 ], [ 9, 20 ] ]
+   */
+  transformPoints(matrix: Tensor, divide = true): Tensor {
+    return this._transformPoints(matrix, divide, 0);
+  }
+
+  /**
+   * Same as {@link transformPoints}, also returning the bounds of the
+   * transformed points computed in the same pass
+   * @category Matrices
+   * @example
+   * const [ moved, bounds ] = points.transformPointsWithBounds(m);
+   * bounds; // { xmin: 9, ymin: 20, xmax: 10, ymax: 21 }
+   */
+  transformPointsWithBounds(matrix: Tensor, divide = true): [Tensor, PointBounds] {
+    // a 1d tensor is a single point
+    const dims = this.is1d ? this._rows * this._cols : this._cols;
+    const boundsPtr = this.Module._malloc(2 * dims * Float32Array.BYTES_PER_ELEMENT);
+    try {
+      const points = this._transformPoints(matrix, divide, boundsPtr);
+      const offset = boundsPtr / Float32Array.BYTES_PER_ELEMENT;
+      const values = this.Module.HEAPF32.slice(offset, offset + 2 * dims);
+      const bounds: PointBounds = dims === 3
+        ? { xmin: values[0], ymin: values[1], zmin: values[2], xmax: values[3], ymax: values[4], zmax: values[5] }
+        : { xmin: values[0], ymin: values[1], xmax: values[2], ymax: values[3] };
+      return [points, bounds];
+    } finally {
+      this._free(boundsPtr);
+    }
+  }
+
+  private _transformPoints(matrix: Tensor, divide: boolean, boundsPtr: number): Tensor {
+    if (!(matrix instanceof Tensor)) {
+      throw new TypeError('Expected 1st argument to be of type Tensor');
+    }
+    const newPtr = this.Module._tensor_transform_points(this.ptr, matrix.ptr, divide, boundsPtr);
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
   /**
    * @category Slicing And Joining
    */
@@ -833,10 +1883,13 @@ export class Tensor extends Interface {
   /**
    * @category Matrices
    */
-  transpose(): Tensor {
+  transpose(out?: Tensor): Tensor {
     if (this.is1d) {
       throw new Error('Attempting to transpose a 1d array, reshape to [1,n] first');
     }
+    if (out) {
+      return out._wrote(this.Module._tensor_transpose_into(Tensor._outPointer(out), this.ptr));
+    }
     const newPtr = this.Module._tensor_transpose(this.ptr);
     // swap order of columns and rows
     return Tensor.fromPointer([this._cols, this._rows], false, newPtr);
@@ -845,13 +1898,19 @@ export class Tensor extends Interface {
   /**
    * @category Slicing And Joining
    */
-  static stack(matrices: Tensor[]): Tensor {
+  static stack(matrices: Tensor[], out?: Tensor): Tensor {
+    const outPtr = out ? Tensor._outPointer(out) : 0;
     const ptrs = matrices.map(m => m.ptr);
     // create a reference of data pointers that we can access on C side
     const count = ptrs.length;
     const instancePtrs = new Uint32Array(ptrs);
     const refPtr = Tensor.Module._malloc(count * instancePtrs.BYTES_PER_ELEMENT);
     Tensor.Module.HEAPU32.set(instancePtrs, refPtr / Uint32Array.BYTES_PER_ELEMENT);
+    if (out) {
+      const dataPtr = Tensor.Module._tensor_stack_into(outPtr, refPtr, count);
+      Tensor.Module._free(refPtr);
+      return out._wrote(dataPtr);
+    }
     const newPtr = Tensor.Module._tensor_stack(refPtr, count);
     Tensor.Module._free(refPtr);
     const { rows, cols } = matrices[0];
@@ -898,11 +1957,7 @@ export class Tensor extends Interface {
 
   /** @hidden */
   static ones(shape: Shape): Tensor {
-    const s = {} as InferedShape;
-    Tensor.prototype._inferShape.call(s, null, shape);
-    shape = [s._rows, s._cols] as Shape;
-    const data = Array(s._rows * s._cols).fill(1);
-    return new Tensor(data, s.is1d ? shape.slice(1) : shape);
+    return Tensor.fill(shape, 1);
   }
 
   /**
@@ -914,9 +1969,7 @@ export class Tensor extends Interface {
    * const matOnes = mat.ones();
    */
   ones(): Tensor {
-    const data = Array(this._rows * this._cols).fill(1);
-    const shape = [this._rows, this._cols];
-    return new Tensor(new Float32Array(data), this.is1d ? shape.slice(1) : shape);
+    return this.fill(1);
   }
 
   /** @hidden */
@@ -950,10 +2003,140 @@ export class Tensor extends Interface {
     return Tensor.fromPointer([this._cols, this._rows], false, newPtr);
   }
 
+  /** @hidden */
+  static fill(shape: Shape, value: number): Tensor {
+    const s = {} as InferedShape;
+    Tensor.prototype._inferShape.call(s, null, shape);
+    const newPtr = Tensor.Module._tensor_fill(s._rows, s._cols, s.is1d, value);
+    return Tensor.fromPointer([s._rows, s._cols], s.is1d, newPtr);
+  }
+
+  /**
+   * Tensor of the same shape with every value set to `value`
+   * @category Creation
+   * @example
+   * const sevens = ft.fill([2, 2], 7);
+   * // also can be used on an instance
+   * const mat = ft.tensor([1, 2, 3, 4]);
+   * const matSevens = mat.fill(7);
+   */
+  fill(value: number): Tensor {
+    const newPtr = this.Module._tensor_fill(this._rows, this._cols, this.is1d, value);
+    return Tensor.fromPointer([this._rows, this._cols], this.is1d, newPtr);
+  }
+
+  /**
+   * 1d values from `start` by `step` up to, not including, `stop`. With a
+   * single argument the range is [0, start).
+   * @category Creation
+   * @example
+   * ft.arange(4); // [0, 1, 2, 3]
+   * ft.arange(1, 2, 0.25); // [1, 1.25, 1.5, 1.75]
+   * ft.arange(3, 0, -1); // [3, 2, 1]
+   */
+  static arange(start: number, stop?: number, step = 1): Tensor {
+    if (stop === undefined) {
+      stop = start;
+      start = 0;
+    }
+    const shapeWire = new ShapeWire();
+    const newPtr = Tensor.Module._tensor_arange(start, stop, step, shapeWire.ptr);
+    const result = Tensor.fromPointer([1, 1], true, newPtr);
+    result._syncShapeWire(shapeWire);
+    return result;
+  }
+
+  /**
+   * 1d `num` evenly spaced values from `start` to `stop`, both included
+   * @category Creation
+   * @example
+   * ft.linspace(0, 1, 5); // [0, 0.25, 0.5, 0.75, 1]
+   */
+  static linspace(start: number, stop: number, num: number): Tensor {
+    if (!Number.isInteger(num) || num < 1) {
+      throw new RangeError('Tensor.linspace(): num must be a positive integer');
+    }
+    const newPtr = Tensor.Module._tensor_linspace(start, stop, num);
+    return Tensor.fromPointer([1, num], true, newPtr);
+  }
+
+  /** whether the global random stream was seeded, by randomSeed() or lazily */
+  private static _randomSeeded = false;
+
+  /** split a seed into the two 32-bit words of the generator key */
+  private static _seedWords(seed: number): [number, number] {
+    if (!Number.isSafeInteger(seed) || seed < 0) {
+      throw new RangeError('Tensor: seed must be a non-negative safe integer');
+    }
+    return [seed >>> 0, Math.floor(seed / 2 ** 32) >>> 0];
+  }
+
+  private static _random(shape: Shape, dist: RandomDistKey, a: number, b: number, seed?: number): Tensor {
+    const s = {} as InferedShape;
+    Tensor.prototype._inferShape.call(s, null, shape);
+    let lo = 0, hi = 0;
+    if (seed !== undefined) {
+      [lo, hi] = Tensor._seedWords(seed);
+    } else if (!Tensor._randomSeeded) {
+      Tensor.randomSeed(Math.floor(Math.random() * Number.MAX_SAFE_INTEGER));
+    }
+    const newPtr = Tensor.Module._tensor_random(
+      s._rows, s._cols, s.is1d, RANDOM_DIST[dist], a, b, seed !== undefined, lo, hi
+    );
+    return Tensor.fromPointer([s._rows, s._cols], s.is1d, newPtr);
+  }
+
+  /**
+   * Seed the stream used by the random creators when no `seed` is given, the
+   * same seed replays the same sequence of tensors. Unseeded, the stream is
+   * seeded from Math.random() on first use.
+   * @category Creation
+   * @example
+   * ft.randomSeed(42);
+   * const a = ft.randomUniform([2, 2]);
+   */
+  static randomSeed(seed: number) {
+    const [lo, hi] = Tensor._seedWords(seed);
+    Tensor.Module._tensor_random_seed(lo, hi);
+    Tensor._randomSeeded = true;
+  }
+
+  /**
+   * Samples uniform in [min, max), generated in wasm. With a `seed` the
+   * result only depends on the seed and the shape.
+   * @category Creation
+   * @example
+   * const noise = ft.randomUniform([2, 3], -1, 1);
+   * const same = ft.randomUniform([2, 3], -1, 1, 7); // reproducible
+   */
+  static randomUniform(shape: Shape, min = 0, max = 1, seed?: number): Tensor {
+    return Tensor._random(shape, 'uniform', min, max, seed);
+  }
+
+  /**
+   * Normally distributed samples, generated in wasm
+   * @category Creation
+   * @example
+   * const weights = ft.randomNormal([64, 32], 0, 0.1);
+   */
+  static randomNormal(shape: Shape, mean = 0, stddev = 1, seed?: number): Tensor {
+    return Tensor._random(shape, 'normal', mean, stddev, seed);
+  }
+
+  /**
+   * Normal samples redrawn until within 2 standard deviations of the mean
+   * @category Creation
+   * @example
+   * const weights = ft.truncatedNormal([64, 32], 0, 0.1);
+   */
+  static truncatedNormal(shape: Shape, mean = 0, stddev = 1, seed?: number): Tensor {
+    return Tensor._random(shape, 'truncatedNormal', mean, stddev, seed);
+  }
+
   /**
    * @category Transformations
    */
-  pad(paddings: Array1d | Array2d, constant?: number): Tensor {
+  pad(paddings: Array1d | Array2d, constant?: number, out?: Tensor): Tensor {
     if (this.is1d && Array.isArray(paddings[0])) {
       throw new Error('Attempting to pad rows with 1d shape');
     }
@@ -971,6 +2154,17 @@ export class Tensor extends Interface {
       }
     }
 
+    if (out) {
+      return out._wrote(this.Module._tensor_pad_into(
+        Tensor._outPointer(out),
+        this.ptr,
+        constant ?? 0,
+        rbefore ?? 0,
+        rafter ?? 0,
+        cbefore ?? 0,
+        cafter ?? 0
+      ));
+    }
     const shapeWire = new ShapeWire();
     const newPtr = this.Module._tensor_pad(
       this.ptr, 
@@ -1025,6 +2219,129 @@ export class Tensor extends Interface {
     );
   }
 
+  /**
+   * Serialize the tensor into a compact binary buffer (shape, dtype and raw data).
+   * @category Serialization
+   * @example
+   * const bytes = ft.tensor([ [ 1, 2 ], [ 3, 4 ] ]).serialize();
+   * fs.writeFileSync('weights.ftns', bytes);
+   */
+  serialize(): Uint8Array {
+    if (this.deleted) {
+      throw new RangeError('Accessing deleted Tensor');
+    }
+    const size = this.Module._tensor_serialized_size(this.ptr);
+    const outPtr = this.Module._malloc(size);
+    this.Module._tensor_serialize(this.ptr, outPtr);
+    const bytes = this.Module.HEAPU8.slice(outPtr, outPtr + size);
+    this._free(outPtr);
+    return bytes;
+  }
+
+  /**
+   * Load a tensor written by `serialize()`.
+   * @category Serialization
+   * @example
+   * const mat = ft.Tensor.deserialize(fs.readFileSync('weights.ftns'));
+   */
+  static deserialize(bytes: Uint8Array): Tensor {
+    return Tensor.deserializeEntry(bytes);
+  }
+
+  /**
+   * Serialize several tensors into a single buffer.
+   * @category Serialization
+   * @example
+   * const bytes = ft.Tensor.serializeBundle([ weights, bias ]);
+   */
+  static serializeBundle(tensors: Tensor[]): Uint8Array {
+    const { Module } = Tensor;
+    const count = tensors.length;
+    const instancePtrs = new Uint32Array(tensors.map(m => m.ptr));
+    const refPtr = Module._malloc(count * instancePtrs.BYTES_PER_ELEMENT);
+    Module.HEAPU32.set(instancePtrs, refPtr / Uint32Array.BYTES_PER_ELEMENT);
+    const size = Module._tensor_bundle_size(refPtr, count);
+    const outPtr = Module._malloc(size);
+    Module._tensor_bundle_serialize(refPtr, count, outPtr);
+    const bytes = Module.HEAPU8.slice(outPtr, outPtr + size);
+    Module._free(outPtr);
+    Module._free(refPtr);
+    return bytes;
+  }
+
+  /**
+   * Load every tensor from a buffer written by `serializeBundle()`.
+   * @category Serialization
+   * @example
+   * const [ weights, bias ] = ft.Tensor.deserializeBundle(bytes);
+   */
+  static deserializeBundle(bytes: Uint8Array): Tensor[] {
+    const { Module } = Tensor;
+    const tableSize = Tensor.withSerialized(bytes, BUNDLE_HEADER_BYTES,
+      headerPtr => Module._tensor_bundle_table_size(headerPtr, bytes.length));
+    return Tensor.withSerialized(bytes, tableSize, (tablePtr, entrySizePtr) => {
+      const count = Module._tensor_bundle_count(tablePtr, bytes.length);
+      const tensors = [];
+      for (let i = 0; i < count; i++) {
+        const start = Module._tensor_bundle_entry(tablePtr, bytes.length, i, entrySizePtr);
+        const entrySize = Module.HEAPU32[entrySizePtr / Uint32Array.BYTES_PER_ELEMENT];
+        tensors.push(Tensor.deserializeEntry(bytes.subarray(start, start + entrySize)));
+      }
+      return tensors;
+    });
+  }
+
+  // The header is parsed natively (src/cpp/core/serialize.cpp) from a small
+  // copy, then the payload is copied once, straight into the new buffer.
+  // Payloads of another dtype are converted natively from a full copy.
+  private static deserializeEntry(bytes: Uint8Array): Tensor {
+    const { Module } = Tensor;
+    const offset = Tensor.withSerialized(bytes, TENSOR_HEADER_BYTES,
+      headerPtr => Module._tensor_serialized_offset(headerPtr, bytes.length));
+    if (offset === 0) {
+      return Tensor.withSerialized(bytes, bytes.length, bufferPtr => Tensor.fromSerialized(
+        shapeWirePtr => Module._tensor_deserialize(bufferPtr, bytes.length, shapeWirePtr)
+      ));
+    }
+    const mat = Tensor.withSerialized(bytes, TENSOR_HEADER_BYTES, headerPtr => Tensor.fromSerialized(
+      shapeWirePtr => Module._tensor_deserialize_header(headerPtr, bytes.length, shapeWirePtr)
+    ));
+    const dataBytes = mat._rows * mat._cols * Float32Array.BYTES_PER_ELEMENT;
+    Module.HEAPU8.set(bytes.subarray(offset, offset + dataBytes), mat._dataPtr);
+    return mat;
+  }
+
+  // Copy the first `length` bytes into wasm memory for the native parser,
+  // followed by a word for an out parameter
+  private static withSerialized<T>(bytes: Uint8Array, length: number,
+    read: (bufferPtr: number, outPtr: number) => T): T {
+    const { Module } = Tensor;
+    const copied = Math.min(length, bytes.length);
+    const outOffset = Math.ceil(length / Uint32Array.BYTES_PER_ELEMENT) * Uint32Array.BYTES_PER_ELEMENT;
+    const bufferPtr = Module._malloc(outOffset + Uint32Array.BYTES_PER_ELEMENT);
+    Module.HEAPU8.set(bytes.subarray(0, copied), bufferPtr);
+    try {
+      return read(bufferPtr, bufferPtr + outOffset);
+    } finally {
+      Module._free(bufferPtr);
+    }
+  }
+
+  private static fromSerialized(load: (shapeWirePtr: number) => number): Tensor {
+    const shapeWire = new ShapeWire();
+    let newPtr;
+    try {
+      newPtr = load(shapeWire.ptr);
+    } catch (error) {
+      // frees the wire
+      shapeWire.sync();
+      throw error;
+    }
+    const mat = Tensor.fromPointer([1, 1], false, newPtr);
+    mat._syncShapeWire(shapeWire);
+    return mat;
+  }
+
   /**
    * Retrieve a copy of the data into a new Array with same shape
    * @category Accessing Data
@@ -0,0 +1,153 @@
+import Interface from './Interface.js';
+import { Tensor, NORM_ORD } from './Tensor.js';
+import type { NormOrdKey, OptionalNumber, OptionalBool } from './Tensor.js';
+
+// matches STREAM_REDUCE in src/cpp/Stream.h
+const STREAM_REDUCE = {
+  sum: 0,
+  mean: 1,
+  min: 2,
+  max: 3,
+  norm: 4,
+} as const;
+
+/**
+ * Reduce a tensor too large to hold in memory by pushing it in row-chunks.
+ * Only per-column accumulators are kept natively, optionally every chunk is
+ * first multiplied through a resident matrix.
+ * @example
+ * const stream = new ft.TensorStream(3);
+ * stream.push(chunkA);
+ * stream.push(chunkB);
+ * const mean = stream.mean(0);
+ * stream.delete();
+ */
+export class TensorStream extends Interface {
+  readonly cols: number;
+  readonly outputCols: number;
+  private projecting: boolean;
+  private bufferSize = 0;
+  private outPtr = 0;
+  private outSize = 0;
+
+  constructor(cols: number, resident?: Tensor) {
+    super();
+    if (resident && resident.rows !== cols) {
+      throw new Error(`Resident matrix rows (${resident.rows}) must match the stream columns (${cols})`);
+    }
+    this.cols = cols;
+    this.outputCols = resident ? resident.cols : cols;
+    this.projecting = Boolean(resident);
+    this.ptr = this.Module._stream_create(cols, resident ? resident.pointer : 0);
+  }
+
+  /**
+   * Push a chunk of rows, a Float32Array is read as rows of `cols` values.
+   * When streaming through a resident matrix the projected chunk is returned.
+   */
+  push(chunk: Float32Array | Tensor): Float32Array | undefined {
+    let chunkPtr;
+    let rows;
+    if (chunk instanceof Tensor) {
+      if (chunk.cols !== this.cols) {
+        throw new Error(`Chunk columns (${chunk.cols}) must match the stream columns (${this.cols})`);
+      }
+      // read straight from the tensor's buffer
+      chunkPtr = chunk.dataPtr;
+      rows = chunk.rows;
+    } else {
+      if (chunk.length % this.cols !== 0) {
+        throw new Error(`Chunk length (${chunk.length}) is not a multiple of the stream columns (${this.cols})`);
+      }
+      rows = chunk.length / this.cols;
+      this.reserve(chunk.length);
+      chunkPtr = this._dataPtr;
+      this.Module.HEAPF32.set(chunk, chunkPtr / Float32Array.BYTES_PER_ELEMENT);
+    }
+
+    if (!this.projecting) {
+      this.Module._stream_push(this.ptr, chunkPtr, rows, 0);
+      return undefined;
+    }
+    this.reserveOut(rows * this.outputCols);
+    this.Module._stream_push(this.ptr, chunkPtr, rows, this.outPtr);
+    const offset = this.outPtr / Float32Array.BYTES_PER_ELEMENT;
+    return this.Module.HEAPF32.slice(offset, offset + rows * this.outputCols);
+  }
+
+  /** Number of rows pushed since creation or the last reset */
+  get rowsSeen(): number {
+    return this.Module._stream_rows(this.ptr);
+  }
+
+  sum(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+    return this.reduce(STREAM_REDUCE.sum, 0, axis, keepdims);
+  }
+
+  mean(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+    return this.reduce(STREAM_REDUCE.mean, 0, axis, keepdims);
+  }
+
+  min(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+    return this.reduce(STREAM_REDUCE.min, 0, axis, keepdims);
+  }
+
+  max(axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+    return this.reduce(STREAM_REDUCE.max, 0, axis, keepdims);
+  }
+
+  norm(ord: NormOrdKey = 'L2', axis: OptionalNumber = -1, keepdims: OptionalBool = false): Tensor {
+    return this.reduce(STREAM_REDUCE.norm, NORM_ORD[ord], axis, keepdims);
+  }
+
+  reset() {
+    this.Module._stream_reset(this.ptr);
+  }
+
+  delete() {
+    if (!this.deleted) {
+      this.deleted = true;
+      if (this.bufferSize) {
+        this._free(this._dataPtr);
+      }
+      if (this.outPtr) {
+        this._free(this.outPtr);
+      }
+      this.Module._stream_delete(this.ptr);
+    }
+  }
+
+  private reduce(op: number, ord: number, axis: OptionalNumber, keepdims: OptionalBool): Tensor {
+    axis ??= -1;
+    if (axis !== -1 && axis !== 0) {
+      throw new Error('Streams reduce over all values (-1) or along axis 0');
+    }
+    return Tensor.fromShapeWire(
+      shapeWirePtr => this.Module._stream_reduce(this.ptr, op, ord, axis, keepdims, shapeWirePtr),
+      keepdims
+    );
+  }
+
+  // staging buffers only grow, so steady chunk sizes never reallocate
+  private reserve(length: number) {
+    const size = length * Float32Array.BYTES_PER_ELEMENT;
+    if (size > this.bufferSize) {
+      if (this.bufferSize) {
+        this._free(this._dataPtr);
+      }
+      this._dataPtr = this.Module._malloc(size);
+      this.bufferSize = size;
+    }
+  }
+
+  private reserveOut(length: number) {
+    const size = length * Float32Array.BYTES_PER_ELEMENT;
+    if (size > this.outSize) {
+      if (this.outPtr) {
+        this._free(this.outPtr);
+      }
+      this.outPtr = this.Module._malloc(size);
+      this.outSize = size;
+    }
+  }
+}
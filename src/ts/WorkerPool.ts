@@ -0,0 +1,365 @@
+import { compileWasm, defaultWorkerUrl, spawnWorker } from '@loader';
+import type { WorkerPort } from './types/WorkerPort.d.ts';
+import { Tensor } from './Tensor.js';
+import type { Array1d, Array2d, Data, InputData, Shape } from './Tensor.js';
+
+/** Reference to a tensor held by a worker */
+export interface WireHandle {
+  $handle: number;
+}
+export type WireArg = WireHandle | number | string | boolean | null | undefined | Data | Shape;
+/** @hidden */
+export type WorkerRequest =
+  | { type: 'init'; wasmPath?: string; module?: WebAssembly.Module }
+  | { type: 'create'; id: number; out: number; data: Data; shape?: Shape }
+  | { type: 'op'; id: number; op: string; self: number; args: WireArg[]; out: number[] }
+  | { type: 'read'; id: number; handle: number; format: 'data' | 'array' | 'shape' | 'copy' }
+  | { type: 'delete'; handles: number[] };
+/** @hidden */
+export interface WorkerResponse {
+  id: number;
+  error?: string;
+  value?: unknown;
+}
+
+/** Tensor methods that return a single tensor */
+export type TensorOp = {
+  [K in keyof Tensor]: Tensor[K] extends (...args: never[]) => Tensor ? K : never
+}[keyof Tensor];
+/** Arguments of `op`, with tensors replaced by async tensors of the same pool */
+export type AsyncArgs<K extends TensorOp> = Tensor[K] extends (...args: infer P) => Tensor
+  ? { [I in keyof P]: Exclude<P[I], Tensor> | (Tensor extends P[I] ? AsyncTensor : never) }
+  : never;
+
+export interface WorkerPoolOptions {
+  /** number of workers, defaults to 1 */
+  size?: number;
+  /** worker script, defaults to the worker bundle next to this library */
+  workerUrl?: string | URL;
+  /** wasm location for the workers (browser), see `Interface.setWasmPath` */
+  wasmPath?: string;
+}
+
+/** @hidden */
+export class PoolWorker {
+  readonly port: WorkerPort;
+  inFlight = 0;
+  private pending = new Map<number, { resolve: (value: unknown) => void; reject: (error: Error) => void }>();
+  // posts wait here when they depend on a tensor copied from another worker,
+  // so every worker still sees its messages in program order
+  private tail: Promise<void> = Promise.resolve();
+
+  constructor(url: string | URL, wasmPath: string | undefined, compiled: Promise<WebAssembly.Module>) {
+    this.port = spawnWorker(url);
+    this.port.onMessage(message => this.receive(message as WorkerResponse));
+    this.port.onError(error => this.failAll(error));
+    // workers instantiate the module compiled here, or compile their own
+    // when that failed, requests queue behind the init either way
+    this.tail = compiled.then(
+      module => this.port.postMessage({ type: 'init', wasmPath, module } satisfies WorkerRequest),
+      () => this.port.postMessage({ type: 'init', wasmPath } satisfies WorkerRequest)
+    );
+  }
+
+  /**
+   * Post once `dependencies` settle (or right away when `immediate`),
+   * resolves with the reply value. Requests are not acknowledged before the
+   * next one is posted, so consecutive ops on the same worker pipeline
+   * without round trips.
+   */
+  request(id: number, build: () => WorkerRequest, dependencies: Promise<unknown>[] = [], immediate = false): Promise<unknown> {
+    const reply = new Promise<unknown>((resolve, reject) => {
+      this.pending.set(id, { resolve, reject });
+    });
+    this.inFlight++;
+    const post = () => {
+      try {
+        const message = build();
+        const transfer = message.type === 'create' && ArrayBuffer.isView(message.data) ? [message.data.buffer] : [];
+        this.port.postMessage(message, transfer);
+      } catch (error) {
+        this.settle({ id, error: (error as Error).message });
+      }
+    };
+    if (immediate) {
+      post();
+    } else if (!dependencies.length) {
+      this.tail = this.tail.then(post);
+    } else {
+      this.tail = this.tail
+        .then(() => Promise.all(dependencies))
+        .then(post, (error: Error) => this.settle({ id, error: error.message }));
+    }
+    return reply;
+  }
+
+  // Fire and forget, in order with the requests
+  post(message: WorkerRequest) {
+    this.tail = this.tail.then(() => this.port.postMessage(message)).catch(() => undefined);
+  }
+
+  failAll(error: Error) {
+    for (const { reject } of this.pending.values()) {
+      reject(error);
+    }
+    this.pending.clear();
+    this.inFlight = 0;
+  }
+
+  private receive(response: WorkerResponse) {
+    this.settle(response);
+  }
+
+  private settle(response: WorkerResponse) {
+    const entry = this.pending.get(response.id);
+    if (!entry) {
+      return;
+    }
+    this.pending.delete(response.id);
+    this.inFlight--;
+    if (response.error !== undefined) {
+      entry.reject(new Error(response.error));
+    } else {
+      entry.resolve(response.value);
+    }
+  }
+}
+
+/**
+ * Runs tensor ops on wasm instances hosted by workers, so heavy math never
+ * blocks the main thread. Tensors stay inside the worker that created them
+ * and ops on them return {@link AsyncTensor} handles immediately, chained
+ * ops are queued back to back and only reading a result waits.
+ * @example
+ * const pool = new ft.WorkerPool({ size: 2 });
+ * const a = pool.tensor(bigMatrix);
+ * const product = a.matMul(a.transpose()).sum(0);
+ * const result = await product.array();
+ * pool.terminate();
+ */
+export class WorkerPool {
+  private workers: PoolWorker[];
+  private nextHandle = 1;
+  private nextId = 1;
+  private terminated = false;
+
+  constructor(options: WorkerPoolOptions = {}) {
+    const size = options.size ?? 1;
+    if (!Number.isInteger(size) || size < 1) {
+      throw new Error('WorkerPool expects at least one worker');
+    }
+    const url = options.workerUrl ?? defaultWorkerUrl();
+    const compiled = compileWasm(options.wasmPath);
+    this.workers = Array.from({ length: size }, () => new PoolWorker(url, options.wasmPath, compiled));
+  }
+
+  get size(): number {
+    return this.workers.length;
+  }
+
+  /**
+   * Upload data to the least busy worker. Typed arrays are transferred, so
+   * they are no longer usable on this side.
+   */
+  tensor(data: Data, shape?: Shape): AsyncTensor {
+    this.checkAlive();
+    const worker = this.workers.reduce((best, next) => next.inFlight < best.inFlight ? next : best);
+    const handle = this.nextHandle++;
+    const id = this.nextId++;
+    const done = worker.request(id, () => ({ type: 'create', id, out: handle, data, shape }));
+    return new AsyncTensor(this, worker, handle, done);
+  }
+
+  /** Copy a main thread tensor to a worker */
+  from(tensor: Tensor): AsyncTensor {
+    return this.tensor(tensor.data(), tensor.shape);
+  }
+
+  /** Terminate every worker, pending results reject */
+  terminate() {
+    if (!this.terminated) {
+      this.terminated = true;
+      for (const worker of this.workers) {
+        worker.failAll(new Error('WorkerPool terminated'));
+        worker.port.terminate();
+      }
+    }
+  }
+
+  /** @hidden */
+  run(source: AsyncTensor, op: string, args: unknown[], outputs: number): AsyncTensor[] {
+    this.checkAlive();
+    const worker = source.worker;
+    const dependencies: Promise<unknown>[] = [];
+    const copies: number[] = [];
+    const wireArgs = args.map((arg): WireArg => {
+      if (arg instanceof Tensor) {
+        throw new TypeError('Tensors must be uploaded with WorkerPool.from() first');
+      }
+      if (!(arg instanceof AsyncTensor)) {
+        return arg as WireArg;
+      }
+      if (arg.pool !== this) {
+        throw new Error('AsyncTensor belongs to another WorkerPool');
+      }
+      if (arg.worker === worker) {
+        return { $handle: arg.handle };
+      }
+      // operands living on another worker are copied over first, the copy
+      // is posted as soon as it arrives, ahead of the op waiting on it
+      const copy = this.nextHandle++;
+      copies.push(copy);
+      dependencies.push(arg.read('copy').then(value => {
+        const { data, shape } = value as { data: Float32Array; shape: Shape };
+        const id = this.nextId++;
+        void worker.request(id, () => ({ type: 'create', id, out: copy, data, shape }), [], true)
+          .catch(() => undefined);
+      }));
+      return { $handle: copy };
+    });
+    const out = Array.from({ length: outputs }, () => this.nextHandle++);
+    const id = this.nextId++;
+    const done = worker.request(
+      id,
+      () => ({ type: 'op', id, op, self: source.handle, args: wireArgs, out }),
+      dependencies
+    );
+    if (copies.length) {
+      worker.post({ type: 'delete', handles: copies });
+    }
+    return out.map(handle => new AsyncTensor(this, worker, handle, done));
+  }
+
+  /** @hidden */
+  read(tensor: AsyncTensor, format: 'data' | 'array' | 'shape' | 'copy'): Promise<unknown> {
+    this.checkAlive();
+    const id = this.nextId++;
+    return tensor.worker.request(id, () => ({ type: 'read', id, handle: tensor.handle, format }));
+  }
+
+  /** @hidden */
+  release(tensor: AsyncTensor) {
+    if (!this.terminated) {
+      tensor.worker.post({ type: 'delete', handles: [tensor.handle] });
+    }
+  }
+
+  private checkAlive() {
+    if (this.terminated) {
+      throw new Error('WorkerPool terminated');
+    }
+  }
+}
+
+/**
+ * Handle to a tensor held by a {@link WorkerPool} worker. Ops return new
+ * handles right away, reading the data is what waits for the work.
+ */
+export class AsyncTensor {
+  /** @hidden */
+  readonly pool: WorkerPool;
+  /** @hidden */
+  readonly worker: PoolWorker;
+  /** @hidden */
+  readonly handle: number;
+  private done: Promise<unknown>;
+  private deleted = false;
+
+  /** @hidden */
+  constructor(pool: WorkerPool, worker: PoolWorker, handle: number, done: Promise<unknown>) {
+    this.pool = pool;
+    this.worker = worker;
+    this.handle = handle;
+    this.done = done;
+    // failures surface through ready() and the readers, not as unhandled rejections
+    done.catch(() => undefined);
+  }
+
+  /** Resolves once the tensor is computed, rejects if its op failed */
+  async ready(): Promise<this> {
+    await this.done;
+    return this;
+  }
+
+  /** Run any tensor method that returns a tensor, e.g. `run('norm', 'L2', 1)` */
+  run<K extends TensorOp>(op: K, ...args: AsyncArgs<K>): AsyncTensor {
+    this.checkDeleted();
+    return this.pool.run(this, op, args as unknown[], 1)[0];
+  }
+
+  matMul(tensor: AsyncTensor): AsyncTensor {
+    return this.call('matMul', [tensor]);
+  }
+
+  add(input: Exclude<InputData, Tensor> | AsyncTensor): AsyncTensor {
+    return this.call('add', [input]);
+  }
+
+  sub(input: Exclude<InputData, Tensor> | AsyncTensor): AsyncTensor {
+    return this.call('sub', [input]);
+  }
+
+  mul(input: Exclude<InputData, Tensor> | AsyncTensor): AsyncTensor {
+    return this.call('mul', [input]);
+  }
+
+  div(input: Exclude<InputData, Tensor> | AsyncTensor): AsyncTensor {
+    return this.call('div', [input]);
+  }
+
+  transpose(): AsyncTensor {
+    return this.call('transpose', []);
+  }
+
+  sum(axis: number | null = null): AsyncTensor {
+    return this.call('sum', [axis]);
+  }
+
+  mean(axis: number | null = null): AsyncTensor {
+    return this.call('mean', [axis]);
+  }
+
+  /** [Q, R] factors, see `Tensor.qr` */
+  qr(): [AsyncTensor, AsyncTensor] {
+    this.checkDeleted();
+    const [q, r] = this.pool.run(this, 'qr', [], 2);
+    return [q, r];
+  }
+
+  async data(): Promise<Float32Array> {
+    return await this.read('data') as Float32Array;
+  }
+
+  async array(): Promise<number | Array1d | Array2d> {
+    return await this.read('array') as number | Array1d | Array2d;
+  }
+
+  async shape(): Promise<Shape> {
+    return await this.read('shape') as Shape;
+  }
+
+  /** Free the tensor in its worker */
+  delete() {
+    if (!this.deleted) {
+      this.deleted = true;
+      this.pool.release(this);
+    }
+  }
+
+  private call(op: TensorOp, args: unknown[]): AsyncTensor {
+    this.checkDeleted();
+    return this.pool.run(this, op, args, 1)[0];
+  }
+
+  /** @hidden */
+  read(format: 'data' | 'array' | 'shape' | 'copy'): Promise<unknown> {
+    this.checkDeleted();
+    return this.pool.read(this, format);
+  }
+
+  private checkDeleted() {
+    if (this.deleted) {
+      throw new RangeError('Accessing deleted AsyncTensor');
+    }
+  }
+}
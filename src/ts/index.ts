@@ -1,5 +1,14 @@
 import { tensor, Tensor } from './Tensor.js';
 import { Kalman } from './Kalman.js';
+import { OneEuroFilter, ExponentialSmoothing } from './Smoothing.js';
+import { TensorStream } from './TensorStream.js';
+import { QuantileSketch } from './QuantileSketch.js';
+import { RecursiveLeastSquares } from './RecursiveLeastSquares.js';
+import { KDTree } from './KDTree.js';
+import { FIRFilter } from './FIRFilter.js';
+import { SparseTensor } from './SparseTensor.js';
+import { Pipeline } from './Pipeline.js';
+import { WorkerPool, AsyncTensor } from './WorkerPool.js';
 import Interface from './Interface.js';
 // eslint-disable-next-line @typescript-eslint/no-unnecessary-condition
 const isNode = typeof process !== 'undefined' && process.versions?.node !== null;
@@ -11,6 +20,24 @@ if (isNode) {
 const scope = Tensor.scope;
 const beginScope = Tensor.beginScope;
 const endScope = Tensor.endScope;
+const profile = Tensor.profile;
+const resetProfile = Tensor.resetProfile;
+const memory = Tensor.memory;
+const memoryReport = Tensor.memoryReport;
+const resetPeakMemory = Tensor.resetPeakMemory;
+const trimMemory = Tensor.trimMemory;
+const setMathMode = Tensor.setMathMode;
+const where = Tensor.where;
+const zeros = Tensor.zeros;
+const ones = Tensor.ones;
+const eye = Tensor.eye;
+const fill = Tensor.fill;
+const arange = Tensor.arange;
+const linspace = Tensor.linspace;
+const randomSeed = Tensor.randomSeed;
+const randomUniform = Tensor.randomUniform;
+const randomNormal = Tensor.randomNormal;
+const truncatedNormal = Tensor.truncatedNormal;
 const ready = Interface.ready;
 const setWasmPath = Interface.setWasmPath;
 
@@ -19,16 +46,92 @@ const index = {
   tensor,
   Tensor,
   Kalman,
+  OneEuroFilter,
+  ExponentialSmoothing,
+  TensorStream,
+  QuantileSketch,
+  RecursiveLeastSquares,
+  KDTree,
+  FIRFilter,
+  SparseTensor,
+  Pipeline,
+  WorkerPool,
+  AsyncTensor,
   scope,
   beginScope,
   endScope,
+  profile,
+  resetProfile,
+  memory,
+  memoryReport,
+  resetPeakMemory,
+  trimMemory,
+  setMathMode,
+  where,
+  zeros,
+  ones,
+  eye,
+  fill,
+  arange,
+  linspace,
+  randomSeed,
+  randomUniform,
+  randomNormal,
+  truncatedNormal,
   ready,
   setWasmPath,
 };
 
-export { tensor, Tensor, Kalman, scope, beginScope, endScope, ready, setWasmPath };
+export {
+  tensor,
+  Tensor,
+  Kalman,
+  OneEuroFilter,
+  ExponentialSmoothing,
+  TensorStream,
+  QuantileSketch,
+  RecursiveLeastSquares,
+  KDTree,
+  FIRFilter,
+  SparseTensor,
+  Pipeline,
+  WorkerPool,
+  AsyncTensor,
+  scope,
+  beginScope,
+  endScope,
+  profile,
+  resetProfile,
+  memory,
+  memoryReport,
+  resetPeakMemory,
+  trimMemory,
+  setMathMode,
+  where,
+  zeros,
+  ones,
+  eye,
+  fill,
+  arange,
+  linspace,
+  randomSeed,
+  randomUniform,
+  randomNormal,
+  truncatedNormal,
+  ready,
+  setWasmPath,
+};
 export default index;
 
 // Type Exports (ESM and TypeDoc Friendly)
 export type * from './Tensor.js';
 export type * from './Kalman.js';
+export type * from './Smoothing.js';
+export type * from './TensorStream.js';
+export type * from './QuantileSketch.js';
+export type * from './RecursiveLeastSquares.js';
+export type * from './KDTree.js';
+export type * from './FIRFilter.js';
+export type * from './SparseTensor.js';
+export type * from './Pipeline.js';
+export type * from './WorkerPool.js';
@@ -1,6 +1,60 @@
 import type { WasmModule } from '../types/WasmModule.d.ts';
+import type { WorkerPort } from '../types/WorkerPort.d.ts';
+import { instantiate, type LoaderOptions } from './instantiate.js';
 
-export async function WasmInterfaceLoader(): Promise<WasmModule> {
-  const wasmModule = await import('../../wasm/tensor.esm.js') as WasmModule;
-  return wasmModule;
+const compiled = new Map<string, Promise<WebAssembly.Module>>();
+
+// Compiles while the response downloads, browsers also keep a code cache of
+// streamed modules so later page loads skip most of the work
+export function compileWasm(wasmPath?: string): Promise<WebAssembly.Module> {
+  const url = wasmPath ?? new URL('./tensor.wasm', import.meta.url).href;
+  let module = compiled.get(url);
+  if (!module) {
+    module = WebAssembly.compileStreaming(fetch(url)).catch(async () => {
+      // servers without the application/wasm mime type can't be streamed
+      const response = await fetch(url);
+      return WebAssembly.compile(await response.arrayBuffer());
+    });
+    compiled.set(url, module);
+    // a failed attempt is retried by the next call
+    module.catch(() => compiled.delete(url));
+  }
+  return module;
+}
+
+export async function WasmInterfaceLoader(options: LoaderOptions = {}): Promise<WasmModule> {
+  const module = options.module ? Promise.resolve(options.module) : compileWasm(options.wasmPath);
+  const glue = await import('../../wasm/tensor.esm.js') as WasmModule;
+  return instantiate(glue, module);
+}
+
+export function defaultWorkerUrl(): URL {
+  return new URL('./worker.esm.js', import.meta.url);
+}
+
+export function spawnWorker(url: string | URL): WorkerPort {
+  const worker = new Worker(url, { type: 'module' });
+  return {
+    postMessage: (message, transfer = []) => worker.postMessage(message, transfer),
+    onMessage: listener => {
+      worker.onmessage = (event: MessageEvent) => listener(event.data);
+    },
+    onError: listener => {
+      worker.onerror = (event: ErrorEvent) => listener(new Error(event.message));
+    },
+    terminate: () => worker.terminate(),
+  };
+}
+
+export function parentPort(): WorkerPort {
+  return {
+    postMessage: (message, transfer = []) => self.postMessage(message, { transfer }),
+    onMessage: listener => {
+      self.onmessage = (event: MessageEvent) => listener(event.data);
+    },
+    onError: listener => {
+      self.onerror = (event: Event | string) => listener(new Error(String(event)));
+    },
+    terminate: () => undefined,
+  };
 }
@@ -1,6 +1,25 @@
 import type { WasmModule } from '../types/WasmModule.d.ts';
+import type { WorkerPort } from '../types/WorkerPort.d.ts';
+import { spawnWorker as spawnNodeWorker, parentPort, compileWasmFile } from './node.js';
+import { instantiate, type LoaderOptions } from './instantiate.js';
 
-export async function WasmInterfaceLoader(): Promise<WasmModule> {
-  const wasmModule = await import('../../wasm/tensor.dev.js') as WasmModule;
-  return wasmModule.default();
+export { parentPort };
+
+export function compileWasm(wasmPath?: string): Promise<WebAssembly.Module> {
+  return compileWasmFile(wasmPath ?? new URL('../../wasm/tensor.dev.wasm', import.meta.url));
+}
+
+export async function WasmInterfaceLoader(options: LoaderOptions = {}): Promise<WasmModule> {
+  const module = options.module ? Promise.resolve(options.module) : compileWasm(options.wasmPath);
+  const glue = await import('../../wasm/tensor.dev.js') as WasmModule;
+  return instantiate(glue, module);
+}
+
+export function defaultWorkerUrl(): URL {
+  return new URL('../worker.ts', import.meta.url);
+}
+
+// workers run the TypeScript sources through tsx, like the tests
+export function spawnWorker(url: string | URL): WorkerPort {
+  return spawnNodeWorker(url, ['--import', 'tsx']);
 }
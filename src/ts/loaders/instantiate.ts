@@ -0,0 +1,31 @@
+import type { WasmModule } from '../types/WasmModule.d.ts';
+
+export interface LoaderOptions {
+  /** wasm location, defaults to the one next to the bundle */
+  wasmPath?: string;
+  /** already compiled module, e.g. posted by the main thread to a worker */
+  module?: WebAssembly.Module;
+}
+
+type ReceiveInstance = (instance: WebAssembly.Instance, module: WebAssembly.Module) => void;
+
+/**
+ * Instantiate the emscripten glue from a module compiled by the loader, so
+ * compiling overlaps importing the glue and the result can be shared
+ */
+export function instantiate(glue: WasmModule, compiled: Promise<WebAssembly.Module>): Promise<WasmModule> {
+  let fail: (error: unknown) => void = () => undefined;
+  const failed = new Promise<never>((_, reject) => {
+    fail = reject;
+  });
+  const instance = glue.default({
+    instantiateWasm(imports: WebAssembly.Imports, receiveInstance: ReceiveInstance) {
+      compiled
+        .then(module => WebAssembly.instantiate(module, imports).then(result => receiveInstance(result, module)))
+        .catch(fail);
+      return {};
+    },
+  });
+  // the glue never settles when instantiateWasm fails
+  return Promise.race([instance, failed]);
+}
@@ -1,6 +1,58 @@
+import { readFile } from 'node:fs/promises';
+import { Worker, parentPort as nodeParentPort, type TransferListItem } from 'node:worker_threads';
 import type { WasmModule } from '../types/WasmModule.d.ts';
+import type { WorkerPort } from '../types/WorkerPort.d.ts';
+import { instantiate, type LoaderOptions } from './instantiate.js';
 
-export async function WasmInterfaceLoader(): Promise<WasmModule> {
-  const wasmModule = await import('../../wasm/tensor.node.esm.js') as WasmModule;
-  return wasmModule.default();
+const compiled = new Map<string, Promise<WebAssembly.Module>>();
+
+// Compiled once per process, WorkerPool posts the module to its workers
+// instead of having each one read and compile the file again
+export function compileWasmFile(file: string | URL): Promise<WebAssembly.Module> {
+  const key = String(file);
+  let module = compiled.get(key);
+  if (!module) {
+    module = readFile(file).then(bytes => WebAssembly.compile(bytes));
+    compiled.set(key, module);
+    // a failed attempt is retried by the next call
+    module.catch(() => compiled.delete(key));
+  }
+  return module;
+}
+
+export function compileWasm(wasmPath?: string): Promise<WebAssembly.Module> {
+  return compileWasmFile(wasmPath ?? new URL('./tensor.wasm', import.meta.url));
+}
+
+export async function WasmInterfaceLoader(options: LoaderOptions = {}): Promise<WasmModule> {
+  const module = options.module ? Promise.resolve(options.module) : compileWasm(options.wasmPath);
+  const glue = await import('../../wasm/tensor.node.esm.js') as WasmModule;
+  return instantiate(glue, module);
+}
+
+export function defaultWorkerUrl(): URL {
+  return new URL('./worker.node.esm.js', import.meta.url);
+}
+
+export function spawnWorker(url: string | URL, execArgv?: string[]): WorkerPort {
+  const worker = new Worker(url, { execArgv });
+  return {
+    postMessage: (message, transfer = []) => worker.postMessage(message, transfer as TransferListItem[]),
+    onMessage: listener => worker.on('message', listener),
+    onError: listener => worker.on('error', listener),
+    terminate: () => void worker.terminate(),
+  };
+}
+
+export function parentPort(): WorkerPort {
+  if (!nodeParentPort) {
+    throw new Error('parentPort is only available inside a worker');
+  }
+  const port = nodeParentPort;
+  return {
+    postMessage: (message, transfer = []) => port.postMessage(message, transfer as TransferListItem[]),
+    onMessage: listener => port.on('message', listener),
+    onError: () => undefined,
+    terminate: () => undefined,
+  };
 }
@@ -11,61 +11,222 @@ export interface WasmModule {
     default: (...args: unknown[]) => Promise<WasmModule>;
     _malloc: (size: number) => number;
     _free: (ptr: number) => void;
-    _tensor_add: (tensorPtr: number, inputPtr: number, size: number) => number;
-    _tensor_sub: (tensorPtr: number, inputPtr: number, size: number) => number;
-    _tensor_mul: (tensorPtr: number, inputPtr: number, size: number) => number;
-    _tensor_div: (tensorPtr: number, noNan: boolean, inputPtr: number, size: number) => number;
-    _tensor_maximum: (tensorPtr: number, inputPtr: number, inputSize: number) => number;
-    _tensor_minimum: (tensorPtr: number, inputPtr: number, inputSize: number) => number;
-    _tensor_mod: (tensorPtr: number, inputPtr: number, inputSize: number) => number;
-    _tensor_pow: (tensorPtr: number, inputPtr: number, inputSize: number) => number;
-    _tensor_squared_diff: (tensorPtr: number, inputPtr: number, inputSize: number) => number;
-    _tensor_abs: (tensorPtr: number) => number;
-    _tensor_acos: (tensorPtr: number) => number;
-    _tensor_acosh: (tensorPtr: number) => number;
-    _tensor_asin: (tensorPtr: number) => number;
-    _tensor_asinh: (tensorPtr: number) => number;
-    _tensor_atan: (tensorPtr: number) => number;
-    _tensor_atan2: (tensorPtr: number, inputPtr: number, inputSize: number) => number;
-    _tensor_atanh: (tensorPtr: number) => number;
-    _tensor_ceil: (tensorPtr: number) => number;
-    _tensor_clip: (tensorPtr: number, lower: number, upper: number) => number;
-    _tensor_cos: (tensorPtr: number) => number;
-    _tensor_cosh: (tensorPtr: number) => number;
-    _tensor_floor: (tensorPtr: number) => number;
-    _tensor_square: (tensorPtr: number) => number;
+    _tensor_add: (tensor: number, inputPtr: number, size: number) => number;
+    _tensor_sub: (tensor: number, inputPtr: number, size: number) => number;
+    _tensor_mul: (tensor: number, inputPtr: number, size: number) => number;
+    _tensor_div: (tensor: number, noNan: boolean, inputPtr: number, size: number) => number;
+    _tensor_maximum: (tensor: number, inputPtr: number, inputSize: number) => number;
+    _tensor_minimum: (tensor: number, inputPtr: number, inputSize: number) => number;
+    _tensor_mod: (tensor: number, inputPtr: number, inputSize: number) => number;
+    _tensor_pow: (tensor: number, inputPtr: number, inputSize: number) => number;
+    _tensor_squared_diff: (tensor: number, inputPtr: number, inputSize: number) => number;
+    _tensor_add_into: (out: number, tensor: number, inputPtr: number, size: number) => number;
+    _tensor_sub_into: (out: number, tensor: number, inputPtr: number, size: number) => number;
+    _tensor_mul_into: (out: number, tensor: number, inputPtr: number, size: number) => number;
+    _tensor_div_into: (out: number, tensor: number, noNan: boolean, inputPtr: number, size: number) => number;
+    _tensor_maximum_into: (out: number, tensor: number, inputPtr: number, inputSize: number) => number;
+    _tensor_minimum_into: (out: number, tensor: number, inputPtr: number, inputSize: number) => number;
+    _tensor_mod_into: (out: number, tensor: number, inputPtr: number, inputSize: number) => number;
+    _tensor_pow_into: (out: number, tensor: number, inputPtr: number, inputSize: number) => number;
+    _tensor_squared_diff_into: (out: number, tensor: number, inputPtr: number, inputSize: number) => number;
+    _tensor_abs: (tensor: number) => number;
+    _tensor_acos: (tensor: number) => number;
+    _tensor_acosh: (tensor: number) => number;
+    _tensor_asin: (tensor: number) => number;
+    _tensor_asinh: (tensor: number) => number;
+    _tensor_atan: (tensor: number, mode: number) => number;
+    _tensor_atan2: (tensor: number, inputPtr: number, inputSize: number, mode: number) => number;
+    _tensor_atanh: (tensor: number) => number;
+    _tensor_ceil: (tensor: number) => number;
+    _tensor_clip: (tensor: number, lower: number, upper: number) => number;
+    _tensor_cos: (tensor: number, mode: number) => number;
+    _tensor_cosh: (tensor: number) => number;
+    _tensor_exp: (tensor: number, mode: number) => number;
+    _tensor_floor: (tensor: number) => number;
+    _tensor_log: (tensor: number, mode: number) => number;
+    _tensor_sigmoid: (tensor: number, mode: number) => number;
+    _tensor_sin: (tensor: number, mode: number) => number;
+    _tensor_square: (tensor: number) => number;
+    _tensor_tanh: (tensor: number, mode: number) => number;
+    _tensor_abs_into: (out: number, tensor: number) => number;
+    _tensor_acos_into: (out: number, tensor: number) => number;
+    _tensor_acosh_into: (out: number, tensor: number) => number;
+    _tensor_asin_into: (out: number, tensor: number) => number;
+    _tensor_asinh_into: (out: number, tensor: number) => number;
+    _tensor_atan_into: (out: number, tensor: number, mode: number) => number;
+    _tensor_atan2_into: (out: number, tensor: number, inputPtr: number, inputSize: number, mode: number) => number;
+    _tensor_atanh_into: (out: number, tensor: number) => number;
+    _tensor_ceil_into: (out: number, tensor: number) => number;
+    _tensor_clip_into: (out: number, tensor: number, lower: number, upper: number) => number;
+    _tensor_cos_into: (out: number, tensor: number, mode: number) => number;
+    _tensor_cosh_into: (out: number, tensor: number) => number;
+    _tensor_exp_into: (out: number, tensor: number, mode: number) => number;
+    _tensor_floor_into: (out: number, tensor: number) => number;
+    _tensor_log_into: (out: number, tensor: number, mode: number) => number;
+    _tensor_sigmoid_into: (out: number, tensor: number, mode: number) => number;
+    _tensor_sin_into: (out: number, tensor: number, mode: number) => number;
+    _tensor_square_into: (out: number, tensor: number) => number;
+    _tensor_tanh_into: (out: number, tensor: number, mode: number) => number;
+    _tensor_set_math_mode: (mode: number) => void;
+    _tensor_get_math_mode: () => number;
     _tensor_create: (rows: number, cols: number, is1d: boolean) => number;
-    _tensor_delete: (tensorPtr: number) => void;
-    _tensor_batch_delete: (instancesPtr: number, size: number) => void;
-    _tensor_get_shape: (tensorPtr: number, shapePtr: number) => void;
-    _tensor_get_data_ptr: (tensorPtr: number) => number;
-    _tensor_get_rows: (tensorPtr: number) => number;
-    _tensor_get_cols: (tensorPtr: number) => number;
-    _tensor_get_bounds: (tensorPtr: number, boundsPtr: number) => void;
-    _tensor_clone: (tensorPtr: number) => number;
-    _tensor_eye: (tensorPtr: number) => number;
-    _tensor_diag: (tensorPtr: number, shapeWirePtr: number) => number;
+    _tensor_delete: (tensor: number) => void;
+    _tensor_get_shape: (tensor: number, shapePtr: number) => void;
+    _tensor_get_data_ptr: (tensor: number) => number;
+    _tensor_get_rows: (tensor: number) => number;
+    _tensor_get_cols: (tensor: number) => number;
+    _tensor_get_bounds: (tensor: number, boundsPtr: number) => void;
+    _tensor_clone: (tensor: number) => number;
+    _tensor_eye: (tensor: number) => number;
+    _tensor_diag: (tensor: number, shapeWirePtr: number) => number;
+    _tensor_fill: (rows: number, cols: number, is1d: boolean, value: number) => number;
+    _tensor_arange: (start: number, stop: number, step: number, shapeWirePtr: number) => number;
+    _tensor_linspace: (start: number, stop: number, num: number) => number;
+    _tensor_random_seed: (seedLo: number, seedHi: number) => void;
+    _tensor_random: (rows: number, cols: number, is1d: boolean, dist: number, a: number, b: number, seeded: boolean, seedLo: number, seedHi: number) => number;
+    _tensor_rfft: (tensor: number, axis: number, format: number, shapeWirePtr: number) => number;
+    _tensor_irfft: (tensor: number, n: number, axis: number, shapeWirePtr: number) => number;
+    _tensor_fft: (tensor: number, axis: number, inverse: boolean, format: number, shapeWirePtr: number) => number;
+    _tensor_fft_clear_plans: () => void;
+    _tensor_conv1d: (tensor: number, kernelPtr: number, kernelSize: number, axis: number, mode: number, shapeWirePtr: number) => number;
+    _tensor_moving_average_kernel: (window: number) => number;
+    _tensor_savgol_kernel: (window: number, order: number, deriv: number) => number;
+    _fir_create: (kernelPtr: number, size: number, channels: number) => number;
+    _fir_delete: (firPtr: number) => void;
+    _fir_reset: (firPtr: number) => void;
+    _fir_process: (firPtr: number, framePtr: number, samples: number) => void;
+    _tensor_scope_begin: () => void;
+    _tensor_scope_end: (keep: number) => number;
     _kalman_create: (q: number, r: number) => number;
     _kalman_delete: (kalmanPtr: number) => void;
     _kalman_reset: (kalmanPtr: number) => void;
     _kalman_update: (kalmanPtr: number, observationPtr: number, size: number, qTemp: number, rTemp: number) => void;
-    _tensor_qr: (tensorPtr: number, QPtr: number) => number;
-    _tensor_transpose: (tensorPtr: number) => number;
-    _tensor_norm: (tensorPtr: number, ord: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
-    _tensor_matmul: (tensorPtr: number, otherPtr: number, shapeWirePtr: number) => number;
-    _tensor_dot: (tensorPtr: number, otherPtr: number, shapeWirePtr: number) => number;
-    _tensor_all: (tensorPtr: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
-    _tensor_any: (tensorPtr: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
-    _tensor_arg_max: (tensorPtr: number, axis: number, shapeWirePtr: number) => number;
-    _tensor_arg_min: (tensorPtr: number, axis: number, shapeWirePtr: number) => number;
-    _tensor_max: (tensorPtr: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
-    _tensor_mean: (tensorPtr: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
-    _tensor_min: (tensorPtr: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
-    _tensor_prod: (tensorPtr: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
-    _tensor_sum: (tensorPtr: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
-    _tensor_reverse: (tensorPtr: number, axis: number) => number;
+    _one_euro_create: (minCutoff: number, beta: number, dCutoff: number) => number;
+    _one_euro_delete: (filterPtr: number) => void;
+    _one_euro_reset: (filterPtr: number, start: number, count: number) => void;
+    _one_euro_update: (filterPtr: number, observationPtr: number, size: number, dt: number) => void;
+    _exp_smoothing_create: (alpha: number, beta: number) => number;
+    _exp_smoothing_delete: (smoothingPtr: number) => void;
+    _exp_smoothing_reset: (smoothingPtr: number, start: number, count: number) => void;
+    _exp_smoothing_update: (smoothingPtr: number, observationPtr: number, size: number) => void;
+    _tensor_qr: (tensor: number, Q: number) => number;
+    _tensor_qr_update: (R: number, Q: number, uPtr: number, uSize: number, vPtr: number, vSize: number) => number;
+    _tensor_cholesky: (tensor: number) => number;
+    _tensor_cholesky_update: (tensor: number, xPtr: number, size: number, downdate: boolean) => number;
+    _rls_create: (features: number, forgetting: number, regularization: number) => number;
+    _rls_delete: (rlsPtr: number) => void;
+    _rls_reset: (rlsPtr: number) => void;
+    _rls_update: (rlsPtr: number, xPtr: number, yPtr: number, rows: number) => void;
+    _rls_downdate: (rlsPtr: number, xPtr: number, yPtr: number, rows: number) => boolean;
+    _rls_weights: (rlsPtr: number, outPtr: number) => void;
+    _rls_predict: (rlsPtr: number, xPtr: number) => number;
+    _tensor_compare: (tensor: number, op: number, inputPtr: number, inputSize: number) => number;
+    _tensor_where: (cond: number, aPtr: number, aSize: number, bPtr: number, bSize: number) => number;
+    _tensor_masked_fill: (tensor: number, maskPtr: number, maskSize: number, value: number) => number;
+    _tensor_boolean_mask: (tensor: number, maskPtr: number, maskSize: number, axis: number, shapeWirePtr: number) => number;
+    _tensor_compare_into: (out: number, tensor: number, op: number, inputPtr: number, inputSize: number) => number;
+    _tensor_where_into: (out: number, cond: number, aPtr: number, aSize: number, bPtr: number, bSize: number) => number;
+    _tensor_masked_fill_into: (out: number, tensor: number, maskPtr: number, maskSize: number, value: number) => number;
+    _tensor_transpose: (tensor: number) => number;
+    _tensor_transpose_into: (out: number, tensor: number) => number;
+    _tensor_norm: (tensor: number, ord: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
+    _tensor_matmul: (tensor: number, other: number, shapeWirePtr: number) => number;
+    _tensor_matmul_into: (out: number, tensor: number, other: number) => number;
+    _tensor_dot: (tensor: number, other: number, shapeWirePtr: number) => number;
+    _tensor_cdist: (tensor: number, other: number, metric: number, shapeWirePtr: number) => number;
+    _tensor_transform_points: (tensor: number, matrix: number, divide: boolean, boundsPtr: number) => number;
+    _tensor_memory_stats: (statsPtr: number) => void;
+    _tensor_memory_trim: () => void;
+    _tensor_memory_reset_peak: () => void;
+    _tensor_memory_report: (outPtr: number, size: number, limit: number) => number;
+    _pipeline_create: (rows: number, cols: number, is1d: boolean) => number;
+    _pipeline_delete: (pipelinePtr: number) => void;
+    _pipeline_add: (pipelinePtr: number, op: number, operand: number, param0: number, param1: number, shapeWirePtr: number) => void;
+    _pipeline_run: (pipelinePtr: number) => number;
+    _pipeline_input: (pipelinePtr: number, slot: number) => number;
+    _pipeline_output: (pipelinePtr: number, slot: number) => number;
+    _tensor_profile_enabled: () => boolean;
+    _tensor_profile_count: () => number;
+    _tensor_profile_snapshot: (statsPtr: number) => void;
+    _tensor_profile_names: (outPtr: number, size: number) => number;
+    _tensor_profile_reset: () => void;
+    _tensor_all: (tensor: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
+    _tensor_any: (tensor: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
+    _tensor_arg_max: (tensor: number, axis: number, shapeWirePtr: number) => number;
+    _tensor_arg_min: (tensor: number, axis: number, shapeWirePtr: number) => number;
+    _tensor_max: (tensor: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
+    _tensor_mean: (tensor: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
+    _tensor_min: (tensor: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
+    _tensor_prod: (tensor: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
+    _tensor_sum: (tensor: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
+    _tensor_scan: (tensor: number, op: number, axis: number, exclusive: boolean) => number;
+    _tensor_all_into: (out: number, tensor: number, axis: number) => number;
+    _tensor_any_into: (out: number, tensor: number, axis: number) => number;
+    _tensor_max_into: (out: number, tensor: number, axis: number) => number;
+    _tensor_mean_into: (out: number, tensor: number, axis: number) => number;
+    _tensor_min_into: (out: number, tensor: number, axis: number) => number;
+    _tensor_prod_into: (out: number, tensor: number, axis: number) => number;
+    _tensor_sum_into: (out: number, tensor: number, axis: number) => number;
+    _tensor_arg_max_into: (out: number, tensor: number, axis: number) => number;
+    _tensor_arg_min_into: (out: number, tensor: number, axis: number) => number;
+    _tensor_scan_into: (out: number, tensor: number, op: number, axis: number, exclusive: boolean) => number;
+    _tensor_serialized_size: (tensor: number) => number;
+    _tensor_serialize: (tensor: number, outPtr: number) => number;
+    _tensor_serialized_offset: (headerPtr: number, size: number) => number;
+    _tensor_deserialize_header: (headerPtr: number, size: number, shapeWirePtr: number) => number;
+    _tensor_deserialize: (bufferPtr: number, size: number, shapeWirePtr: number) => number;
+    _tensor_bundle_size: (instancesPtr: number, count: number) => number;
+    _tensor_bundle_serialize: (instancesPtr: number, count: number, outPtr: number) => number;
+    _tensor_bundle_table_size: (headerPtr: number, size: number) => number;
+    _tensor_bundle_count: (tablePtr: number, size: number) => number;
+    _tensor_bundle_entry: (tablePtr: number, size: number, index: number, entrySizePtr: number) => number;
+    _sketch_create: (k: number) => number;
+    _sketch_delete: (sketchPtr: number) => void;
+    _sketch_reset: (sketchPtr: number) => void;
+    _sketch_push: (sketchPtr: number, valuesPtr: number, size: number) => void;
+    _sketch_merge: (sketchPtr: number, otherPtr: number) => void;
+    _sketch_count: (sketchPtr: number) => number;
+    _sketch_retained: (sketchPtr: number) => number;
+    _sketch_quantiles: (sketchPtr: number, qsPtr: number, qCount: number, outPtr: number) => void;
+    _sketch_rank: (sketchPtr: number, value: number) => number;
+    _tensor_reverse: (tensor: number, axis: number) => number;
     _tensor_stack: (instancesPtr: number, size: number) => number;
-    _tensor_pad: (tensorPtr: number, shapeWirePtr: number, constant: number, rpadBefore: number, rpadAfter: number, cpadBefore: number, cpadAfter: number) => number;
-    _tensor_flatten: (tensorPtr: number) => number;
-    _tensor_reshape: (tensorPtr: number, newRows: number, newCols: number, shapeWirePtr: number) => number;
+    _tensor_stack_into: (out: number, instancesPtr: number, size: number) => number;
+    _tensor_sort: (tensor: number, axis: number, descending: boolean) => number;
+    _tensor_argsort: (tensor: number, axis: number, descending: boolean) => number;
+    _tensor_topk: (tensor: number, k: number, axis: number, largest: boolean, indices: number, shapeWirePtr: number) => number;
+    _sparse_from_dense: (dense: number, tolerance: number) => number;
+    _sparse_from_coo: (rows: number, cols: number, rowIndices: number, colIndices: number, values: number) => number;
+    _sparse_delete: (sparsePtr: number) => void;
+    _sparse_rows: (sparsePtr: number) => number;
+    _sparse_cols: (sparsePtr: number) => number;
+    _sparse_nnz: (sparsePtr: number) => number;
+    _sparse_to_dense: (sparsePtr: number, shapeWirePtr: number) => number;
+    _sparse_spmv: (sparsePtr: number, vec: number, shapeWirePtr: number) => number;
+    _sparse_spmm: (sparsePtr: number, dense: number, shapeWirePtr: number) => number;
+    _sparse_transpose: (sparsePtr: number) => number;
+    _sparse_scale: (sparsePtr: number, factor: number) => number;
+    _sparse_scale_rows: (sparsePtr: number, factors: number) => number;
+    _sparse_scale_cols: (sparsePtr: number, factors: number) => number;
+    _kdtree_create: (points: number, leafSize: number) => number;
+    _kdtree_delete: (treePtr: number) => void;
+    _kdtree_build: (treePtr: number, points: number) => void;
+    _kdtree_refit: (treePtr: number, points: number) => boolean;
+    _kdtree_size: (treePtr: number) => number;
+    _kdtree_knn: (treePtr: number, queries: number, k: number, distances: number, shapeWirePtr: number) => number;
+    _kdtree_radius: (treePtr: number, queries: number, radius: number, maxResults: number, distances: number, shapeWirePtr: number) => number;
+    _tensor_histogram: (tensor: number, bins: number, low: number, high: number, axis: number, shapeWirePtr: number) => number;
+    _tensor_bincount: (tensor: number, minLength: number, weightsPtr: number, weightsSize: number, shapeWirePtr: number) => number;
+    _tensor_quantile: (tensor: number, qsPtr: number, qCount: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
+    _stream_create: (cols: number, resident: number) => number;
+    _stream_delete: (streamPtr: number) => void;
+    _stream_reset: (streamPtr: number) => void;
+    _stream_push: (streamPtr: number, chunkPtr: number, rows: number, outPtr: number) => void;
+    _stream_rows: (streamPtr: number) => number;
+    _stream_output_cols: (streamPtr: number) => number;
+    _stream_reduce: (streamPtr: number, op: number, ord: number, axis: number, keepdims: boolean, shapeWirePtr: number) => number;
+    _tensor_pad: (tensor: number, shapeWirePtr: number, constant: number, rpadBefore: number, rpadAfter: number, cpadBefore: number, cpadAfter: number) => number;
+    _tensor_pad_into: (out: number, tensor: number, constant: number, rpadBefore: number, rpadAfter: number, cpadBefore: number, cpadAfter: number) => number;
+    _tensor_flatten: (tensor: number) => number;
+    _tensor_reshape: (tensor: number, newRows: number, newCols: number, shapeWirePtr: number) => number;
 }
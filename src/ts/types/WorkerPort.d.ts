@@ -0,0 +1,8 @@
+/** Message channel to a worker, or from inside a worker to its parent */
+export interface WorkerPort {
+  postMessage(message: unknown, transfer?: Transferable[]): void;
+  onMessage(listener: (message: unknown) => void): void;
+  onError(listener: (error: Error) => void): void;
+  /** no-op from inside the worker */
+  terminate(): void;
+}
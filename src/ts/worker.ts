@@ -0,0 +1,117 @@
+import Interface from './Interface.js';
+import { Tensor } from './Tensor.js';
+import { parentPort } from '@loader';
+import type { WireArg, WorkerRequest, WorkerResponse } from './WorkerPool.js';
+
+// Worker side of WorkerPool: owns a wasm instance and the tensors created
+// in it, requests run one at a time in the order they were posted
+const port = parentPort();
+const tensors = new Map<number, Tensor>();
+// handles whose op failed, ops using them fail with the same message
+const failed = new Map<number, string>();
+let queue: Promise<void> = Promise.resolve();
+let initError: string | undefined;
+
+function lookup(handle: number): Tensor {
+  const tensor = tensors.get(handle);
+  if (tensor) {
+    return tensor;
+  }
+  throw new Error(failed.get(handle) ?? 'Accessing deleted AsyncTensor');
+}
+
+function resolveArg(arg: WireArg): unknown {
+  if (arg !== null && typeof arg === 'object' && '$handle' in arg) {
+    return lookup(arg.$handle);
+  }
+  return arg;
+}
+
+function store(out: number[], result: unknown) {
+  const results = Array.isArray(result) && result[0] instanceof Tensor ? result as Tensor[] : [result];
+  out.forEach((handle, i) => {
+    if (!(results[i] instanceof Tensor)) {
+      throw new Error('Expected the op to return a tensor');
+    }
+    tensors.set(handle, results[i]);
+  });
+}
+
+function read(handle: number, format: string): [unknown, Transferable[]] {
+  const tensor = lookup(handle);
+  switch (format) {
+    case 'array':
+      return [tensor.array(), []];
+    case 'shape':
+      return [tensor.shape, []];
+    case 'copy': {
+      const data = tensor.data();
+      return [{ data, shape: tensor.shape }, [data.buffer]];
+    }
+    default: {
+      const data = tensor.data();
+      return [data, [data.buffer]];
+    }
+  }
+}
+
+function handle(request: WorkerRequest) {
+  if (request.type === 'init') {
+    return;
+  }
+  if (request.type === 'delete') {
+    for (const handle of request.handles) {
+      tensors.get(handle)?.delete();
+      tensors.delete(handle);
+      failed.delete(handle);
+    }
+    return;
+  }
+  const response: WorkerResponse = { id: request.id };
+  let transfer: Transferable[] = [];
+  try {
+    if (initError !== undefined) {
+      throw new Error(initError);
+    }
+    if (request.type === 'create') {
+      store([request.out], new Tensor(request.data, request.shape?.length ? request.shape : undefined));
+    } else if (request.type === 'op') {
+      const self = lookup(request.self);
+      const method = (self as unknown as Record<string, unknown>)[request.op];
+      if (typeof method !== 'function' || request.op.startsWith('_')) {
+        throw new Error(`Unknown tensor op "${request.op}"`);
+      }
+      store(request.out, (method as (...args: unknown[]) => unknown).apply(self, request.args.map(resolveArg)));
+    } else {
+      [response.value, transfer] = read(request.handle, request.format);
+    }
+  } catch (error) {
+    response.error = (error as Error).message;
+    if (request.type === 'create' || request.type === 'op') {
+      const outputs = request.type === 'create' ? [request.out] : request.out;
+      for (const handle of outputs) {
+        failed.set(handle, response.error);
+      }
+    }
+  }
+  port.postMessage(response, transfer);
+}
+
+port.onMessage(message => {
+  const request = message as WorkerRequest;
+  if (request.type === 'init') {
+    queue = queue.then(async () => {
+      if (request.module) {
+        await Interface.readyFrom(request.module);
+        return;
+      }
+      if (request.wasmPath) {
+        await Interface.setWasmPath(request.wasmPath);
+      }
+      await Interface.ready();
+    }).catch((error: Error) => {
+      initError = `WorkerPool failed to load wasm: ${error.message}`;
+    });
+  }
+  queue = queue.then(() => handle(request));
+});
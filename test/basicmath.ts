@@ -111,4 +111,60 @@ export default function() {
       [ 1, 2, 3, 4 ]
     );
   });
+
+  it('exp, log, sin, tanh and sigmoid', () => {
+    const values = [-2, -0.5, 0.25, 1, 3];
+    const mat = ft.tensor(values);
+    const check = (result: number[], expected: (x: number) => number) => {
+      result.forEach((value, i) => expect(value).to.be.closeTo(expected(values[i]), 1e-6 * Math.max(1, Math.abs(value))));
+    };
+    check(mat.exp().data(), Math.exp);
+    check(mat.abs().log().data(), x => Math.log(Math.abs(x)));
+    check(mat.sin().data(), Math.sin);
+    check(mat.tanh().data(), Math.tanh);
+    check(mat.sigmoid().data(), x => 1 / (1 + Math.exp(-x)));
+  });
+
+  describe('fast math', () => {
+    afterEach(() => ft.setMathMode('precise'));
+
+    it('should stay within a few ulp of libm', () => {
+      const mat = ft.tensor(Array.from({ length: 1000 }, (_, i) => (i - 500) / 50));
+      const positive = mat.abs().add(1e-3);
+      const pairs = [
+        [mat.exp('fast'), mat.exp()],
+        [positive.log('fast'), positive.log()],
+        [mat.sin('fast'), mat.sin()],
+        [mat.cos('fast'), mat.cos()],
+        [mat.atan('fast'), mat.atan()],
+        [mat.atan2(positive.mul(-1), 'fast'), mat.atan2(positive.mul(-1))],
+        [mat.tanh('fast'), mat.tanh()],
+        [mat.sigmoid('fast'), mat.sigmoid()],
+      ];
+      pairs.forEach(([fast, precise]) => {
+        const expected = precise.data();
+        fast.data().forEach((value, i) => {
+          expect(value).to.be.closeTo(expected[i], 4 * 2 ** -23 * Math.max(1, Math.abs(expected[i])));
+        });
+      });
+    });
+
+    it('should keep exp finite up to the edge of the float range', () => {
+      const inputs = [88.5, 88.72, 88.7228317, -87.3, -87.33654, 0];
+      const result = ft.tensor(inputs).exp('fast').data();
+      inputs.forEach((x, i) => {
+        const expected = Math.exp(Math.fround(x));
+        expect(result[i]).to.be.closeTo(expected, 2 * 2 ** -23 * expected);
+      });
+      expect(ft.tensor([88.73, -104]).exp('fast').array()).to.deep.equal([Infinity, 0]);
+    });
+
+    it('should switch the default mode globally', () => {
+      expect(ft.Tensor.getMathMode()).to.eql('precise');
+      ft.setMathMode('fast');
+      expect(ft.Tensor.getMathMode()).to.eql('fast');
+      const mat = ft.tensor([0.1, 0.7, 2.3]);
+      expect(mat.exp().array()).to.deep.equal(mat.exp('fast').array());
+    });
+  });
 }
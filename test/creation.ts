@@ -1,10 +1,81 @@
 export default function() {
   describe('ones', () => {
-    it('should create a matrix of ones');
+    it('should create a matrix of ones', () => {
+      expect(ft.ones([2, 2]).array()).to.deep.equal([ [ 1, 1 ], [ 1, 1 ] ]);
+      expect(new Tensor([1, 2, 3]).ones().array()).to.deep.equal([1, 1, 1]);
+    });
   });
 
   describe('zeros', () => {
-    it('should create a matrix of zeros');
+    it('should create a matrix of zeros', () => {
+      expect(ft.zeros([2, 2]).array()).to.deep.equal([ [ 0, 0 ], [ 0, 0 ] ]);
+    });
+  });
+
+  describe('fill', () => {
+    it('should create a tensor of one value', () => {
+      expect(ft.fill([2, 3], 7).array()).to.deep.equal([ [ 7, 7, 7 ], [ 7, 7, 7 ] ]);
+      expect(new Tensor([1, 2]).fill(-1.5).array()).to.deep.equal([-1.5, -1.5]);
+    });
+  });
+
+  describe('arange', () => {
+    it('should step from start up to, not including, stop', () => {
+      expect(ft.arange(4).array()).to.deep.equal([0, 1, 2, 3]);
+      expect(ft.arange(1, 2, 0.25).array()).to.deep.equal([1, 1.25, 1.5, 1.75]);
+      expect(ft.arange(3, 0, -1).array()).to.deep.equal([3, 2, 1]);
+    });
+    it('should exclude stop with fractional steps', () => {
+      const up = ft.arange(0, 0.3, 0.1).array() as number[];
+      expect(up.length).to.eql(3);
+      expect(up[2]).to.be.closeTo(0.2, 1e-7);
+      const down = ft.arange(1, 0.7, -0.1).array() as number[];
+      expect(down.length).to.eql(3);
+      expect(down[2]).to.be.closeTo(0.8, 1e-7);
+    });
+    it('should throw error for an empty range', () => {
+      expect(() => ft.arange(0, 5, -1)).to.throw('the range is empty');
+    });
+  });
+
+  describe('linspace', () => {
+    it('should include both ends', () => {
+      expect(ft.linspace(0, 1, 5).array()).to.deep.equal([0, 0.25, 0.5, 0.75, 1]);
+      expect(ft.linspace(2, 2, 1).array()).to.deep.equal([2]);
+    });
+  });
+
+  describe('random', () => {
+    it('should replay the same values for a seed', () => {
+      const a = ft.randomNormal([3, 4], 0, 1, 42).array();
+      expect(ft.randomNormal([3, 4], 0, 1, 42).array()).to.deep.equal(a);
+      expect(ft.randomNormal([3, 4], 0, 1, 43).array()).to.not.deep.equal(a);
+      ft.randomSeed(9);
+      const b = ft.randomUniform([5]).array();
+      ft.randomSeed(9);
+      expect(ft.randomUniform([5]).array()).to.deep.equal(b);
+    });
+    it('should not depend on the size for a seed', () => {
+      const head = ft.randomUniform([5], 0, 1, 3).array() as number[];
+      const long = ft.randomUniform([100], 0, 1, 3).array() as number[];
+      expect(long.slice(0, 5)).to.deep.equal(head);
+    });
+    it('should draw uniform values in [min, max)', () => {
+      const values = ft.randomUniform([1000], -2, 3, 1).array() as number[];
+      expect(Math.min(...values)).to.be.at.least(-2);
+      expect(Math.max(...values)).to.be.below(3);
+    });
+    it('should draw normal values with the given mean and stddev', () => {
+      const mat = ft.randomNormal([100, 100], 2, 0.5, 1);
+      const mean = mat.mean().array() as number;
+      expect(mean).to.be.closeTo(2, 0.02);
+      expect(Math.sqrt(mat.sub(mean).square().mean().array() as number)).to.be.closeTo(0.5, 0.02);
+    });
+    it('should keep truncated normal values within 2 stddev', () => {
+      const values = ft.truncatedNormal([1000], 1, 0.5, 1).array() as number[];
+      expect(Math.min(...values)).to.be.at.least(0);
+      expect(Math.max(...values)).to.be.at.most(2);
+    });
   });
 
   describe('diag', () => {
@@ -0,0 +1,60 @@
+// plain O(n^2) DFT of a real signal, interleaved (re, im) bins
+function dft(signal: number[]): number[] {
+  const n = signal.length;
+  const out: number[] = [];
+  for (let k = 0; k <= n / 2; k++) {
+    let re = 0;
+    let im = 0;
+    signal.forEach((value, j) => {
+      re += value * Math.cos(-2 * Math.PI * k * j / n);
+      im += value * Math.sin(-2 * Math.PI * k * j / n);
+    });
+    out.push(re, im);
+  }
+  return out;
+}
+
+export default function() {
+  describe('rfft', () => {
+    it('should return the non-negative frequency bins', () => {
+      expect(ft.tensor([1, 2, 3, 4]).rfft().array()).to.deep.equal([10, 0, -2, 2, -2, 0]);
+    });
+    it('should match the DFT for mixed radix and prime lengths', () => {
+      [12, 30, 37, 97].forEach(n => {
+        const signal = Array.from({ length: n }, (_, i) => Math.fround(Math.sin(i * 0.7) + (i % 3)));
+        const expected = dft(signal);
+        const result = ft.tensor(signal).rfft().data();
+        expect(result.length).to.eql(expected.length);
+        result.forEach((value, i) => expect(value).to.be.closeTo(expected[i], 1e-3));
+      });
+    });
+    it('should transform columns on axis 0 and return magnitudes', () => {
+      const mat = ft.tensor([[1, 0], [2, 1], [3, 0], [4, -1]]);
+      const result = mat.rfft(0, 'magnitude');
+      expect(result.shape).to.eql([3, 2]);
+      result.data().forEach((value, i) => expect(value).to.be.closeTo([10, 0, Math.SQRT2 * 2, 2, 2, 0][i], 1e-5));
+    });
+    it('should round trip through irfft', () => {
+      const mat = ft.tensor([[1, 2, 3, 4, 5, 6], [0, 1, 0, -1, 0, 1]]);
+      const back = mat.rfft().irfft();
+      expect(back.shape).to.eql([2, 6]);
+      back.data().forEach((value, i) => expect(value).to.be.closeTo(mat.data()[i], 1e-5));
+      const odd = ft.tensor([1, 2, 3, 4, 5]);
+      odd.rfft().irfft(5).data().forEach((value, i) => expect(value).to.be.closeTo(i + 1, 1e-5));
+    });
+  });
+
+  describe('fft', () => {
+    it('should transform interleaved complex values and invert', () => {
+      const signal = ft.tensor([1, 0, 0, 1]);
+      const spectrum = signal.fft();
+      expect(spectrum.array()).to.deep.equal([1, 1, 1, -1]);
+      expect(spectrum.ifft().array()).to.deep.equal([1, 0, 0, 1]);
+      const polar = signal.fft(null, 'polar').data();
+      [Math.SQRT2, Math.PI / 4, Math.SQRT2, -Math.PI / 4].forEach((value, i) => expect(polar[i]).to.be.closeTo(value, 1e-6));
+    });
+    it('should reject an odd number of interleaved values', () => {
+      expect(() => ft.tensor([1, 2, 3]).fft()).to.throw('even');
+    });
+  });
+}
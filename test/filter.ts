@@ -0,0 +1,74 @@
+// plain reference convolution
+function convolve(signal: number[], kernel: number[]): number[] {
+  const out = new Array(signal.length + kernel.length - 1).fill(0);
+  signal.forEach((value, i) => kernel.forEach((tap, j) => { out[i + j] += value * tap; }));
+  return out;
+}
+
+export default function() {
+  describe('conv1d', () => {
+    it('should return the full, same and valid windows', () => {
+      const signal = ft.tensor([1, 2, 3, 4]);
+      const kernel = [1, 0, -1];
+      expect(signal.conv1d(kernel).array()).to.deep.equal([1, 2, 2, 2, -3, -4]);
+      expect(signal.conv1d(kernel, 'same').array()).to.deep.equal([2, 2, 2, -3]);
+      expect(signal.conv1d(kernel, 'valid').array()).to.deep.equal([2, 2]);
+    });
+    it('should convolve columns on axis 0', () => {
+      const mat = ft.tensor([[1, 10], [2, 20], [3, 30]]);
+      const result = mat.conv1d([1, 1], 'full', 0);
+      expect(result.shape).to.eql([4, 2]);
+      expect(result.array()).to.deep.equal([[1, 10], [3, 30], [5, 50], [3, 30]]);
+    });
+    it('should match direct convolution with long kernels', () => {
+      const signal = Array.from({ length: 600 }, (_, i) => Math.sin(i / 7));
+      const kernel = Array.from({ length: 100 }, (_, i) => Math.fround(1 / (i + 1)));
+      const expected = convolve(signal.map(Math.fround), kernel);
+      const result = ft.tensor(signal).conv1d(kernel).data();
+      expect(result.length).to.eql(expected.length);
+      result.forEach((value, i) => expect(value).to.be.closeTo(expected[i], 1e-4));
+    });
+    it('should reject a kernel longer than the signal in valid mode', () => {
+      expect(() => ft.tensor([1, 2]).conv1d([1, 1, 1], 'valid')).to.throw('valid');
+    });
+  });
+
+  describe('kernels', () => {
+    it('should build a moving average kernel', () => {
+      expect(ft.Tensor.movingAverageKernel(4).array()).to.deep.equal([0.25, 0.25, 0.25, 0.25]);
+    });
+    it('should build Savitzky-Golay kernels', () => {
+      const smooth = ft.Tensor.savgolKernel(5, 2).data();
+      [-3, 12, 17, 12, -3].forEach((value, i) => expect(smooth[i]).to.be.closeTo(value / 35, 1e-6));
+      // derivative of a line is its slope
+      const slope = ft.tensor([0, 2, 4, 6, 8, 10]).conv1d(ft.Tensor.savgolKernel(5, 2, 1), 'valid');
+      slope.data().forEach(value => expect(value).to.be.closeTo(2, 1e-5));
+    });
+  });
+
+  describe('FIRFilter', () => {
+    it('should filter chunks like the whole signal', () => {
+      const kernel = [0.5, 0.3, 0.2];
+      const signal = [1, 4, 2, 8, 5, 7, 3, 6];
+      const expected = convolve(signal, kernel).slice(0, signal.length);
+      const fir = new ft.FIRFilter(kernel);
+      const first = new Float32Array(signal.slice(0, 3));
+      const second = new Float32Array(signal.slice(3));
+      fir.process(first);
+      fir.process(second);
+      [...first, ...second].forEach((value, i) => expect(value).to.be.closeTo(expected[i], 1e-6));
+      fir.delete();
+    });
+    it('should keep interleaved channels apart', () => {
+      const fir = new ft.FIRFilter(ft.Tensor.movingAverageKernel(2), 2);
+      const frame = new Float32Array([2, 10, 4, 20, 6, 30]);
+      fir.process(frame);
+      expect(Array.from(frame)).to.deep.equal([1, 5, 3, 15, 5, 25]);
+      fir.reset();
+      const next = new Float32Array([2, 10]);
+      fir.process(next);
+      expect(Array.from(next)).to.deep.equal([1, 5]);
+      fir.delete();
+    });
+  });
+}
@@ -22,4 +22,51 @@ export default function() {
     expect(mat1.ptr).to.not.eql(mat2.ptr);
     expect(mat1.dataPtr).to.eql(mat2.dataPtr);
   });
+
+  it('should write into an out tensor without allocating a new one', () => {
+    const mat = ft.tensor([ [ 1, 2 ], [ 3, 4 ] ]);
+    const out = ft.zeros([2, 2]);
+    const dataPtr = out.dataPtr;
+    expect(mat.add(1, out)).to.equal(out);
+    expect(out.dataPtr).to.eql(dataPtr);
+    expect(out.array()).to.deep.eql([ [ 2, 3 ], [ 4, 5 ] ]);
+    mat.transpose(out);
+    expect(out.array()).to.deep.eql([ [ 1, 3 ], [ 2, 4 ] ]);
+    mat.matMul(mat, out);
+    expect(out.array()).to.deep.eql([ [ 7, 10 ], [ 15, 22 ] ]);
+    const sums = ft.zeros([2]);
+    mat.sum(0, false, sums);
+    expect(sums.array()).to.deep.eql([ 4, 6 ]);
+  });
+
+  it('should update an out tensor in place when it is also the input', () => {
+    const mat = ft.tensor([ 1, 2, 3 ]);
+    const dataPtr = mat.dataPtr;
+    mat.mul(2, mat).sub(1, mat).abs(mat);
+    expect(mat.dataPtr).to.eql(dataPtr);
+    expect(mat.array()).to.deep.eql([ 1, 3, 5 ]);
+  });
+
+  it('should copy an out tensor before writing when a clone shares its data', () => {
+    const out = ft.tensor([ 0, 0 ]);
+    const clone = out.clone();
+    ft.tensor([ 1, 2 ]).add(1, out);
+    expect(out.dataPtr).to.not.eql(clone.dataPtr);
+    expect(out.array()).to.deep.eql([ 2, 3 ]);
+    expect(clone.array()).to.deep.eql([ 0, 0 ]);
+  });
+
+  it('should reject an out tensor of the wrong shape', () => {
+    const mat = ft.tensor([ [ 1, 2 ], [ 3, 4 ] ]);
+    expect(() => mat.add(1, ft.zeros([4]))).to.throw('expected shape [2,2], found [1,4]');
+    expect(() => mat.transpose(mat)).to.throw("can't write into its own input");
+  });
+
+  it('should leave a rejected out tensor sharing its data', () => {
+    const mat = ft.tensor([ [ 1, 2 ], [ 3, 4 ] ]);
+    const clone = mat.clone();
+    expect(() => mat.transpose(mat)).to.throw("can't write into its own input");
+    // read natively, the cached dataPtr only updates after a write
+    expect(mat.Module._tensor_get_data_ptr(mat.pointer)).to.eql(clone.dataPtr);
+  });
 }
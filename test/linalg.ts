@@ -28,6 +28,103 @@ export default function() {
     );
   });
 
+  it('qrUpdate matches the QR of A + u vᵀ', () => {
+    const a = ft.tensor([[2, -1, 0], [1, 3, 1], [0, 1, 4], [1, 0, 2]]);
+    const u = [1, -2, 0.5, 3];
+    const v = [0.5, 1, -1];
+    const [q, r] = a.qr();
+    const [q2, r2] = ft.Tensor.qrUpdate(q, r, u, v);
+    const product = q2.matMul(r2).array() as number[][];
+    const expected = a.array() as number[][];
+    for (let i = 0; i < 4; i++) {
+      for (let j = 0; j < 3; j++) {
+        expect(product[i][j]).to.be.closeTo(expected[i][j] + u[i] * v[j], 1e-4);
+      }
+    }
+    const triangle = r2.array() as number[][];
+    expect(triangle[1][0]).to.equal(0);
+    expect(triangle[3][2]).to.equal(0);
+  });
+
+  it('qrUpdate leaves its q and r untouched and returns a readable q', () => {
+    const a = ft.tensor([[2, -1, 0], [1, 3, 1], [0, 1, 4], [1, 0, 2]]);
+    const [q, r] = a.qr();
+    const qBefore = q.array();
+    const rBefore = r.array();
+    const u = [1, -2, 0.5, 3];
+    const v = [0.5, 1, -1];
+    const [q2, r2] = ft.Tensor.qrUpdate(q, r, u, v);
+    expect(q.array()).to.deep.equal(qBefore);
+    expect(r.array()).to.deep.equal(rBefore);
+    // q2 reads its own rotated buffer, which outlives q
+    q.delete();
+    const product = ft.tensor(q2.array() as number[][]).matMul(r2).array() as number[][];
+    const expected = a.array() as number[][];
+    for (let i = 0; i < 4; i++) {
+      for (let j = 0; j < 3; j++) {
+        expect(product[i][j]).to.be.closeTo(expected[i][j] + u[i] * v[j], 1e-4);
+      }
+    }
+    expect(() => ft.Tensor.qrUpdate(q2, r, [1, 2], [0.5, 1, -1])).to.throw(/qrUpdate/);
+  });
+
+  it('cholesky and its rank-1 update and downdate', () => {
+    const a = ft.tensor([[4, 2, 0.6], [2, 5, 1], [0.6, 1, 3]]);
+    const l = a.cholesky();
+    const reconstructed = l.matMul(l.transpose()).array() as number[][];
+    const expected = a.array() as number[][];
+    reconstructed.forEach((row, i) => row.forEach((value, j) => expect(value).to.be.closeTo(expected[i][j], 1e-5)));
+    expect((l.array() as number[][])[0][1]).to.equal(0);
+
+    const x = [0.5, -1, 2];
+    const updated = l.choleskyUpdate(x);
+    const product = updated.matMul(updated.transpose()).array() as number[][];
+    product.forEach((row, i) => row.forEach((value, j) => expect(value).to.be.closeTo(expected[i][j] + x[i] * x[j], 1e-5)));
+    const restored = updated.choleskyUpdate(x, true).array() as number[][];
+    const original = l.array() as number[][];
+    restored.forEach((row, i) => row.forEach((value, j) => expect(value).to.be.closeTo(original[i][j], 1e-5)));
+
+    expect(() => l.choleskyUpdate([10, 0, 0], true)).to.throw('not positive definite');
+    expect(() => ft.tensor([[1, 2], [2, 1]]).cholesky()).to.throw('not positive definite');
+  });
+
+  it('RecursiveLeastSquares fits a stream and slides a window', () => {
+    const rls = new ft.RecursiveLeastSquares(2, 1, 1e-6);
+    // y = 2x + 1
+    rls.update([[1, 1], [2, 1], [3, 1]], [3, 5, 7]);
+    rls.update([4, 1], 9);
+    let [slope, intercept] = rls.weights;
+    expect(slope).to.be.closeTo(2, 1e-3);
+    expect(intercept).to.be.closeTo(1, 1e-3);
+    expect(rls.predict([10, 1])).to.be.closeTo(21, 1e-2);
+
+    // the relation changes to y = -x + 4, dropping the old rows leaves only it
+    rls.update([[5, 1], [6, 1], [7, 1]], [-1, -2, -3]);
+    rls.downdate([[1, 1], [2, 1], [3, 1], [4, 1]], [3, 5, 7, 9]);
+    [slope, intercept] = rls.weights;
+    expect(slope).to.be.closeTo(-1, 1e-2);
+    expect(intercept).to.be.closeTo(4, 1e-1);
+
+    expect(() => rls.downdate([100, 100], 5)).to.throw('never added');
+    expect(rls.weights[0]).to.be.closeTo(-1, 1e-2);
+    rls.reset();
+    expect(rls.weights).to.deep.equal([0, 0]);
+    rls.delete();
+  });
+
+  it('RecursiveLeastSquares forgetting follows a drifting relation', () => {
+    const rls = new ft.RecursiveLeastSquares(1, 0.5, 1e-6);
+    for (let i = 1; i <= 20; i++) {
+      rls.update([i], 3 * i);
+    }
+    for (let i = 1; i <= 20; i++) {
+      rls.update([i], -2 * i);
+    }
+    expect(rls.weights[0]).to.be.closeTo(-2, 1e-3);
+    expect(() => rls.downdate([20], -40)).to.throw('forgetting of 1');
+    rls.delete();
+  });
+
   it.skip('should outperform tfjs-node', () => {
     const cycles = 1E4;
     const data = [
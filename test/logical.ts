@@ -0,0 +1,54 @@
+export default function() {
+  describe('comparisons', () => {
+    it('should return masks of 1 and 0', () => {
+      const mat = ft.tensor([ [ 1, 5 ], [ 3, 2 ] ]);
+      expect(mat.greater(2).array()).to.deep.equal([ [ 0, 1 ], [ 1, 0 ] ]);
+      expect(mat.lessEqual([1, 2]).array()).to.deep.equal([ [ 1, 0 ], [ 0, 1 ] ]);
+      expect(mat.equal(mat).array()).to.deep.equal([ [ 1, 1 ], [ 1, 1 ] ]);
+      expect(mat.notEqual(3).array()).to.deep.equal([ [ 1, 1 ], [ 0, 1 ] ]);
+    });
+  });
+
+  describe('where', () => {
+    it('should pick from a where the condition holds and b elsewhere', () => {
+      const x = ft.tensor([-1, 2, -3, 4]);
+      expect(ft.where(x.greater(0), x, 0).array()).to.deep.equal([0, 2, 0, 4]);
+      expect(ft.where(x.less(0), [9, 9, 9, 9], x).array()).to.deep.equal([9, 2, 9, 4]);
+    });
+    it('should throw error if a branch does not broadcast', () => {
+      const cond = ft.tensor([1, 0, 1]);
+      expect(() => ft.where(cond, [1, 2], 0)).to.throw('Cannot broadcast');
+    });
+  });
+
+  describe('maskedFill', () => {
+    it('should replace the masked values', () => {
+      const mat = ft.tensor([ [ 1, NaN ], [ 3, 4 ] ]);
+      expect(mat.maskedFill(mat.notEqual(mat), 0).array()).to.deep.equal([ [ 1, 0 ], [ 3, 4 ] ]);
+      expect(mat.maskedFill([1, 0], -1).array()).to.deep.equal([ [ -1, NaN ], [ -1, 4 ] ]);
+    });
+  });
+
+  describe('booleanMask', () => {
+    it('should keep the masked rows', () => {
+      const boxes = ft.tensor([ [ 0, 0, 4, 4 ], [ 1, 1, 2, 2 ], [ 5, 5, 1, 1 ] ]);
+      const scores = ft.tensor([0.9, 0.1, 0.7]);
+      const kept = boxes.booleanMask(scores.greater(0.5), 0);
+      expect(kept.shape).to.deep.equal([2, 4]);
+      expect(kept.array()).to.deep.equal([ [ 0, 0, 4, 4 ], [ 5, 5, 1, 1 ] ]);
+    });
+    it('should keep the masked columns', () => {
+      const mat = ft.tensor([ [ 1, 2, 3 ], [ 4, 5, 6 ] ]);
+      expect(mat.booleanMask([1, 0, 1], 1).array()).to.deep.equal([ [ 1, 3 ], [ 4, 6 ] ]);
+    });
+    it('should keep masked values flat without an axis', () => {
+      const mat = ft.tensor([ [ 1, 2 ], [ 3, 4 ] ]);
+      expect(mat.booleanMask(mat.greater(1)).array()).to.deep.equal([2, 3, 4]);
+      expect(ft.tensor([1, 2, 3]).booleanMask([0, 1, 1]).array()).to.deep.equal([2, 3]);
+    });
+    it('should throw error if the mask does not match the axis', () => {
+      const mat = ft.tensor([ [ 1, 2, 3 ], [ 4, 5, 6 ] ]);
+      expect(() => mat.booleanMask([1, 0], 1)).to.throw('expected a mask of 3 values');
+    });
+  });
+}
@@ -51,6 +51,23 @@ export default function() {
         [ [ 7, 10 ], [ 15, 22 ] ]
       );
     });
+    it('should multiply many rows by a small matrix', () => {
+      const points = new Tensor([[1, 0, 0], [0, 1, 0], [0, 0, 1], [1, 2, 3], [-1, 0, 2]]);
+      const mat = new Tensor([[1, 2, 3, 4], [5, 6, 7, 8], [9, 10, 11, 12]]);
+      expect(points.matMul(mat).array()).to.deep.equal([
+        [1, 2, 3, 4], [5, 6, 7, 8], [9, 10, 11, 12], [38, 44, 50, 56], [17, 18, 19, 20],
+      ]);
+    });
+    it('should match the general path past an inner dimension of 4', () => {
+      const mat1 = new Tensor([[1, 2, 3, 4, 5]]);
+      const mat2 = new Tensor([[1], [1], [1], [1], [1]]);
+      expect(mat1.matMul(mat2).array()).to.deep.equal([[15]]);
+    });
+    it('should match the general path past 4 columns', () => {
+      const mat1 = new Tensor([[1, 2, 3], [4, 5, 6]]);
+      const mat2 = new Tensor([[1, 0, 0, 1, 2], [0, 1, 0, 1, 2], [0, 0, 1, 1, 2]]);
+      expect(mat1.matMul(mat2).array()).to.deep.equal([[1, 2, 3, 6, 12], [4, 5, 6, 15, 30]]);
+    });
   });
 
   describe('transpose', () => {
@@ -65,4 +82,70 @@ export default function() {
     });
   });
 
+  describe('cdist', () => {
+    const points = () => ft.tensor([[0, 0], [3, 4]]);
+    const tracks = () => ft.tensor([[0, 0], [6, 8], [3, 0]]);
+    const expectClose = (result: Float32Array, expected: number[]) => {
+      result.forEach((value, i) => expect(value).to.be.closeTo(expected[i], 1e-5));
+    };
+    it('should compute euclidean distances between rows', () => {
+      expectClose(points().cdist(tracks()).data(), [0, 10, 3, 5, 5, 4]);
+    });
+    it('should compute squared euclidean and cityblock distances', () => {
+      expectClose(points().cdist(tracks(), 'sqeuclidean').data(), [0, 100, 9, 25, 25, 16]);
+      expect(points().cdist(tracks(), 'cityblock').array()).to.deep.equal(
+        [ [ 0, 14, 3 ], [ 7, 7, 4 ] ]
+      );
+    });
+    it('should compute cosine distances', () => {
+      const result = ft.tensor([[1, 0], [0, 2]]).cdist(ft.tensor([[2, 0], [1, 1]]), 'cosine').data();
+      const expected = [0, 1 - Math.SQRT1_2, 1, 1 - Math.SQRT1_2];
+      result.forEach((value, i) => expect(value).to.be.closeTo(expected[i], 1e-6));
+    });
+    it('should treat a 1d tensor as a single point', () => {
+      const result = ft.tensor([3, 4]).cdist(points());
+      expect(result.shape).to.eql([1, 2]);
+      expectClose(result.data(), [5, 0]);
+    });
+    it('should keep sub-pixel distances at pixel scale coordinates', () => {
+      const result = ft.tensor([1500.3, 900.7]).cdist(ft.tensor([[1501.1, 900.2], [1500.4, 900.7]])).data();
+      expect(result[0]).to.be.closeTo(0.9434, 1e-3);
+      expect(result[1]).to.be.closeTo(0.1, 1e-3);
+    });
+    it('should throw on mismatched point dimensions', () => {
+      expect(() => points().cdist(ft.tensor([[1, 2, 3]]))).to.throw('same number of columns');
+    });
+  });
+  describe('transformPoints', () => {
+    const points = () => ft.tensor([[0, 0], [1, 0], [0, 1]]);
+    it('should rotate and translate with a 2x3 matrix', () => {
+      const m = ft.tensor([[0, -1, 10], [1, 0, 20]]);
+      expect(points().transformPoints(m).array()).to.deep.equal(
+        [ [ 10, 20 ], [ 10, 21 ], [ 9, 20 ] ]
+      );
+    });
+    it('should divide by w for a 4x4 perspective matrix', () => {
+      const m = ft.tensor([[1, 0, 0, 0], [0, 1, 0, 0], [0, 0, 1, 0], [0, 0, 1, 0]]);
+      const pts = ft.tensor([[1, 2, 4], [2, 2, 2]]);
+      expect(pts.transformPoints(m).array()).to.deep.equal(
+        [ [ 0.25, 0.5, 1 ], [ 1, 1, 1 ] ]
+      );
+      expect(pts.transformPoints(m, false).array()).to.deep.equal(
+        [ [ 1, 2, 4 ], [ 2, 2, 2 ] ]
+      );
+    });
+    it('should return the bounds from the same pass', () => {
+      const m = ft.tensor([[0, -1, 10], [1, 0, 20]]);
+      const [moved, bounds] = points().transformPointsWithBounds(m);
+      expect(moved.shape).to.eql([3, 2]);
+      expect(bounds).to.deep.equal({ xmin: 9, ymin: 20, xmax: 10, ymax: 21 });
+      const [, bounds3] = ft.tensor([1, 2, 3]).transformPointsWithBounds(
+        ft.tensor([[1, 0, 0, 1], [0, 1, 0, 1], [0, 0, 1, 1]])
+      );
+      expect(bounds3).to.deep.equal({ xmin: 2, ymin: 3, zmin: 4, xmax: 2, ymax: 3, zmax: 4 });
+    });
+    it('should throw on an unsupported matrix shape', () => {
+      expect(() => points().transformPoints(ft.tensor([[1, 0], [0, 1]]))).to.throw('expects a 2x3 or 3x3');
+    });
+  });
 }
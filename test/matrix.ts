@@ -4,14 +4,27 @@
  */
 import creation from './creation.js';
 import arithmetic from './arithmetic.js';
+import logical from './logical.js';
 import benchmark from './benchmark.js';
 import basicmath from './basicmath.js';
 import reduction from './reduction.js';
+import statistics from './statistics.js';
 import matrices from './matrices.js';
 import transformations from './transformations.js';
 import immutability from './immutability.js';
 import slicejoin from './slicejoin.js';
 import linalg from './linalg.js';
+import profiler from './profiler.js';
+import serialization from './serialization.js';
+import stream from './stream.js';
+import spatial from './spatial.js';
+import sorting from './sorting.js';
+import filter from './filter.js';
+import smoothing from './smoothing.js';
+import fft from './fft.js';
+import sparse from './sparse.js';
+import pipeline from './pipeline.js';
+import worker from './worker.js';
 
 export default function() {
 
@@ -30,18 +43,100 @@ export default function() {
       expect(Tensor.memory().pointers).to.eql(1);
       retained.delete();
     });
+    it('should count shared data buffers once', () => {
+      const before = ft.memory();
+      const mat = ft.tensor([[1,2], [3,4]]);
+      const reshaped = mat.reshape([4]);
+      const after = ft.memory();
+      expect(after.tensors - before.tensors).to.eql(2);
+      expect(after.buffers - before.buffers).to.eql(1);
+      expect(after.bytes - before.bytes).to.eql(4 * Float32Array.BYTES_PER_ELEMENT);
+      expect(after.peakBytes).to.be.at.least(after.bytes);
+      reshaped.delete();
+      mat.delete();
+      expect(ft.memory().buffers).to.eql(before.buffers);
+    });
+    it('should reuse freed buffers of the same shape', () => {
+      ft.tensor([[1, 2, 3], [4, 5, 6]]).delete();
+      const before = ft.memory();
+      const mat = ft.tensor([[1, 2, 3], [4, 5, 6]]);
+      const after = ft.memory();
+      expect(after.poolMisses).to.eql(before.poolMisses);
+      expect(after.poolHits).to.be.above(before.poolHits);
+      mat.delete();
+      ft.trimMemory();
+      expect(ft.memory().poolBytes).to.eql(0);
+    });
+    it('should report the largest live buffers', () => {
+      ft.tensor([1, 2]);
+      ft.tensor([1, 2, 3, 4, 5, 6], [2, 3]).add(1);
+      const [largest] = ft.memoryReport(1);
+      expect(largest.bytes).to.eql(6 * Float32Array.BYTES_PER_ELEMENT);
+      expect(largest.shape).to.eql([2, 3]);
+    });
+    it('should reject a handle of a deleted tensor', () => {
+      const mat = ft.tensor([1, 2]);
+      const handle = mat.pointer;
+      mat.delete();
+      // the slot is reused under a new generation
+      const next = ft.tensor([3, 4]);
+      expect(next.pointer).to.not.eql(handle);
+      expect(() => Tensor.Module._tensor_get_rows(handle)).to.throw('stale handle');
+      next.delete();
+    });
+    it('should release everything created in a scope', () => {
+      const before = ft.memory().tensors;
+      ft.scope(() => {
+        const mat = ft.ones([2, 2]);
+        mat.add(1).mul(2).delete();
+      });
+      expect(ft.memory().tensors).to.eql(before);
+    });
+    it('should nest scopes', () => {
+      const before = ft.memory().tensors;
+      let inner: Tensor | undefined;
+      const outer = ft.scope(() => {
+        const kept = ft.ones([2]);
+        inner = ft.scope(() => ft.ones([2]).add(kept)) as Tensor;
+        // the inner scope only released its own tensors
+        expect(kept.array()).to.deep.equal([1, 1]);
+        expect(inner.array()).to.deep.equal([2, 2]);
+        return inner.mul(2);
+      }) as Tensor;
+      // the tensor returned by the inner scope went with the outer one
+      expect(() => inner!.array()).to.throw('deleted');
+      expect(outer.array()).to.deep.equal([4, 4]);
+      outer.delete();
+      expect(ft.memory().tensors).to.eql(before);
+    });
+    it('should reject an unmatched endScope', () => {
+      expect(() => ft.endScope()).to.throw('without a matching beginScope');
+    });
   });
 
 
   describe('Creation', creation);
   describe('Arithmetic', arithmetic);
+  describe('Logical', logical);
   describe('Basic math', basicmath);
   describe('Reduction', reduction);
+  describe('Statistics', statistics);
   describe('Matrices', matrices);
   describe('Transformations', transformations);
   describe('Immutability', immutability);
   describe('Slicing and joining', slicejoin);
   describe('Linear Alg', linalg);
+  describe('Profiler', profiler);
+  describe('Serialization', serialization);
+  describe('Streaming', stream);
+  describe('Spatial index', spatial);
+  describe('Sorting', sorting);
+  describe('Filtering', filter);
+  describe('Smoothing', smoothing);
+  describe('Spectral', fft);
+  describe('Sparse', sparse);
+  describe('Pipeline', pipeline);
+  describe('Worker pool', worker);
 
   describe.skip('Benchmark', benchmark);
 
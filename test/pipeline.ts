@@ -0,0 +1,59 @@
+export default function() {
+  const points = [[1, 2], [3, 4], [-5, 6]];
+  const matrix = () => ft.tensor([[2, 0, 1], [0, 2, 0], [0, 0, 1]]);
+
+  it('should match the same ops run eagerly', () => {
+    const center = ft.tensor([1, 1]);
+    const pipeline = new ft.Pipeline([3, 2])
+      .sub(center)
+      .transformPoints(matrix())
+      .clip(-4, 4)
+      .sum(0);
+    center.delete();
+    expect(pipeline.outputShape).to.eql([1, 2]);
+    const expected = ft.tensor(points).sub([1, 1]).transformPoints(matrix()).clip(-4, 4).sum(0);
+    expect(Array.from(pipeline.run(points.flat()))).to.deep.equal(Array.from(expected.data()));
+    pipeline.delete();
+  });
+
+  it('should double buffer the output views', () => {
+    const pipeline = new ft.Pipeline([4]).mul(2).add(1);
+    const first = pipeline.run([1, 2, 3, 4]);
+    const second = pipeline.run([5, 6, 7, 8]);
+    expect(Array.from(first)).to.deep.equal([3, 5, 7, 9]);
+    expect(Array.from(second)).to.deep.equal([11, 13, 15, 17]);
+    // the third frame reuses the first slot
+    expect(pipeline.run([0, 0, 0, 0])).to.equal(first);
+    pipeline.delete();
+  });
+
+  it('should run a frame written into the input slot', () => {
+    const pipeline = new ft.Pipeline([2, 2]).matMul(ft.tensor([[0, 1], [1, 0]])).transpose();
+    pipeline.input.set([1, 2, 3, 4]);
+    expect(Array.from(pipeline.run())).to.deep.equal([2, 4, 1, 3]);
+    expect(pipeline.outputShape).to.eql([2, 2]);
+    pipeline.delete();
+  });
+
+  it('should not allocate tensors per frame', () => {
+    const pipeline = new ft.Pipeline([64, 3]).mul([1, 2, 3]).tanh().mean(1);
+    const frame = new Float32Array(64 * 3).fill(0.5);
+    pipeline.run(frame);
+    const before = ft.memory();
+    for (let i = 0; i < 10; i++) {
+      pipeline.run(frame);
+    }
+    const after = ft.memory();
+    expect(after.tensors).to.eql(before.tensors);
+    expect(after.poolHits + after.poolMisses).to.eql(before.poolHits + before.poolMisses);
+    pipeline.delete();
+  });
+
+  it('should reject invalid steps when built', () => {
+    const pipeline = new ft.Pipeline([3, 2]);
+    expect(() => pipeline.add([1, 2, 3])).to.throw('Cannot broadcast');
+    expect(() => pipeline.matMul(ft.tensor([[1, 2]]))).to.throw('incompatible');
+    expect(() => pipeline.run([1, 2])).to.throw('must match');
+    pipeline.delete();
+  });
+}
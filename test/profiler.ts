@@ -0,0 +1,22 @@
+export default function() {
+  it('should count calls, elements and bytes per op', () => {
+    ft.resetProfile();
+    const mat = ft.tensor([[1, 2], [3, 4]]);
+    mat.add(1).add(2);
+    mat.matMul(mat);
+    const { add, matmul } = ft.profile();
+    expect(add.calls).to.eql(2);
+    expect(add.elements).to.eql(8);
+    expect(add.bytes).to.be.greaterThan(0);
+    expect(add.totalMs).to.be.at.least(add.maxMs);
+    expect(matmul.calls).to.eql(1);
+  });
+
+  it('should zero the counters on reset', () => {
+    ft.tensor([1, 2, 3]).sum();
+    ft.resetProfile();
+    const { sum } = ft.profile();
+    expect(sum.calls).to.eql(0);
+    expect(sum.bytes).to.eql(0);
+  });
+}
@@ -111,6 +111,11 @@ export default function() {
         [ 0, 1 ]
       );
     });
+    it('should compare against the running minimum', () => {
+      const mat = ft.tensor([[5, 1, 3, 2], [4, 6, 0, 7]]);
+      expect(mat.argMin(1).array()).to.deep.equal([ 1, 2 ]);
+      expect(mat.transpose().argMin(0).array()).to.deep.equal([ 1, 2 ]);
+    });
   });
   describe('argMax', () => {
     it('should return argmax on flat data', () => {
@@ -132,6 +137,11 @@ export default function() {
         [ 1, 0 ]
       );
     });
+    it('should compare against the running maximum', () => {
+      const mat = ft.tensor([[1, 5, 3, 4], [2, 0, 7, 6]]);
+      expect(mat.argMax(1).array()).to.deep.equal([ 1, 2 ]);
+      expect(mat.transpose().argMax(0).array()).to.deep.equal([ 1, 2 ]);
+    });
   });
   describe('max', () => {
     it('should perform max on flat data (axis -1) and keep dims', () => {
@@ -346,4 +356,39 @@ export default function() {
       );
     });
   });
+
+  describe('cumsum', () => {
+    it('should sum the values in order without an axis', () => {
+      expect(ft.tensor([1, 2, 3]).cumsum().array()).to.deep.equal([1, 3, 6]);
+      expect(ft.tensor([[1,2],[3,4]]).cumsum().array()).to.deep.equal([ [ 1, 3 ], [ 6, 10 ] ]);
+    });
+    it('should sum down the rows on axis 0 and along them on axis 1', () => {
+      const mat = ft.tensor([[1,2],[3,4],[5,6]]);
+      expect(mat.cumsum(0).array()).to.deep.equal([ [ 1, 2 ], [ 4, 6 ], [ 9, 12 ] ]);
+      expect(mat.cumsum(1).array()).to.deep.equal([ [ 1, 3 ], [ 3, 7 ], [ 5, 11 ] ]);
+    });
+    it('should leave out the current value when exclusive', () => {
+      const mat = ft.tensor([[1,2],[3,4],[5,6]]);
+      expect(mat.cumsum(0, true).array()).to.deep.equal([ [ 0, 0 ], [ 1, 2 ], [ 4, 6 ] ]);
+      expect(ft.tensor([1, 2, 3]).cumsum(null, true).array()).to.deep.equal([0, 1, 3]);
+    });
+  });
+
+  describe('cumprod, cummax and cummin', () => {
+    it('should scan along an axis', () => {
+      const mat = ft.tensor([[1,5],[3,2],[9,0]]);
+      expect(mat.cumprod(0).array()).to.deep.equal([ [ 1, 5 ], [ 3, 10 ], [ 27, 0 ] ]);
+      expect(mat.cummax(0).array()).to.deep.equal([ [ 1, 5 ], [ 3, 5 ], [ 9, 5 ] ]);
+      expect(mat.cummin(1).array()).to.deep.equal([ [ 1, 1 ], [ 3, 2 ], [ 9, 0 ] ]);
+      expect(ft.tensor([2, 1, 3]).cummax(null, true).array()).to.deep.equal([-Infinity, 2, 2]);
+    });
+    it('should carry NaN forward wherever it appears', () => {
+      expect(ft.tensor([1, NaN, 3]).cummax().array()).to.deep.equal([1, NaN, NaN]);
+      expect(ft.tensor([NaN, 1, 3]).cummin().array()).to.deep.equal([NaN, NaN, NaN]);
+      expect(ft.tensor([[1, 2], [NaN, 0], [5, 1]]).cummax(0).array()).to.deep.equal([ [ 1, 2 ], [ NaN, 2 ], [ NaN, 2 ] ]);
+    });
+    it('should reject an axis outside -1..1', () => {
+      expect(() => ft.tensor([[1, 2], [3, 4]]).cummax(2)).to.throw('Axis must be');
+    });
+  });
 }
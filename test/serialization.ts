@@ -0,0 +1,50 @@
+export default function() {
+  it('should round trip a 2d tensor', () => {
+    const mat = ft.tensor([[1, 2, 3], [4, 5, 6]]);
+    const bytes = mat.serialize();
+    const loaded = Tensor.deserialize(bytes);
+    expect(loaded.shape).to.eql([2, 3]);
+    expect(loaded.array()).to.deep.equal([[1, 2, 3], [4, 5, 6]]);
+  });
+
+  it('should round trip a 1d tensor', () => {
+    const loaded = Tensor.deserialize(ft.tensor([1, 2, 3]).serialize());
+    expect(loaded.shape).to.eql([3]);
+    expect(loaded.array()).to.deep.equal([1, 2, 3]);
+  });
+
+  it('should keep the payload aligned after the header', () => {
+    const bytes = ft.tensor([1, 2]).serialize();
+    const view = new DataView(bytes.buffer);
+    expect(view.getUint32(20, true) % 64).to.eql(0);
+    expect(bytes.length).to.eql(64 + 2 * Float32Array.BYTES_PER_ELEMENT);
+  });
+
+  it('should round trip a bundle of tensors', () => {
+    const a = ft.tensor([[1, 2], [3, 4]]);
+    const b = ft.tensor([5, 6, 7]);
+    const [loadedA, loadedB] = Tensor.deserializeBundle(Tensor.serializeBundle([a, b]));
+    expect(loadedA.array()).to.deep.equal([[1, 2], [3, 4]]);
+    expect(loadedB.array()).to.deep.equal([5, 6, 7]);
+  });
+
+  it('should reject buffers that are not tensors', () => {
+    expect(() => Tensor.deserialize(new Uint8Array(64))).to.throw('not a serialized tensor');
+    const bytes = ft.tensor([1, 2]).serialize();
+    expect(() => Tensor.deserialize(bytes.subarray(0, 40))).to.throw('does not match');
+  });
+
+  it('should reject corrupt headers', () => {
+    const bytes = ft.tensor([1, 2]).serialize();
+    const view = new DataView(bytes.buffer);
+    // data offset inside the header
+    view.setUint32(20, 4, true);
+    expect(() => Tensor.deserialize(bytes)).to.throw('invalid data offset');
+    view.setUint32(20, 64, true);
+    // rows * cols * 4 wraps around to the stored byte count
+    view.setUint32(8, 0x80000000, true);
+    view.setUint32(12, 0x80000000, true);
+    view.setBigUint64(24, 0n, true);
+    expect(() => Tensor.deserialize(bytes)).to.throw('does not match');
+  });
+}
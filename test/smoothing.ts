@@ -0,0 +1,101 @@
+export default function() {
+  describe('OneEuroFilter', () => {
+    it('should start from the first frame and smooth in place', () => {
+      const filter = new ft.OneEuroFilter(1, 0);
+      const frame = new Float32Array([0, 5]);
+      filter.update(frame, 1 / 30);
+      expect(Array.from(frame)).to.deep.equal([0, 5]);
+      frame.set([10, 5]);
+      filter.update(frame, 1 / 30);
+      expect(frame[0]).to.be.within(0.1, 5);
+      expect(frame[1]).to.eql(5);
+      filter.delete();
+    });
+    it('should lag less on fast motion with a higher beta', () => {
+      const slow = new ft.OneEuroFilter(1, 0);
+      const fast = new ft.OneEuroFilter(1, 1);
+      const a = new Float32Array([0]);
+      const b = new Float32Array([0]);
+      slow.update(a, 1 / 30);
+      fast.update(b, 1 / 30);
+      a[0] = b[0] = 100;
+      slow.update(a, 1 / 30);
+      fast.update(b, 1 / 30);
+      expect(b[0]).to.be.above(a[0]);
+      slow.delete();
+      fast.delete();
+    });
+    it('should restart only the reset streams', () => {
+      const filter = new ft.OneEuroFilter(1, 0);
+      const frame = new Float32Array([0, 0, 0]);
+      filter.update(frame, 1 / 30);
+      filter.reset(1, 1);
+      frame.set([9, 9, 9]);
+      filter.update(frame, 1 / 30);
+      expect(frame[0]).to.be.below(9);
+      expect(frame[1]).to.eql(9);
+      expect(frame[2]).to.be.below(9);
+      filter.delete();
+    });
+    it('should recover a stream from NaN after a reset', () => {
+      const filter = new ft.OneEuroFilter(1, 0.1);
+      const frame = new Float32Array([1, 2]);
+      filter.update(frame, 1 / 30);
+      frame.set([NaN, 3]);
+      filter.update(frame, 1 / 30);
+      expect(frame[0]).to.be.NaN;
+      filter.reset(0, 1);
+      frame.set([5, 3]);
+      filter.update(frame, 1 / 30);
+      expect(frame[0]).to.eql(5);
+      frame.set([5, 3]);
+      filter.update(frame, 1 / 30);
+      expect(frame[0]).to.eql(5);
+      filter.delete();
+    });
+  });
+
+  describe('ExponentialSmoothing', () => {
+    it('should blend each frame into the last one', () => {
+      const smoothing = new ft.ExponentialSmoothing(0.5);
+      const frame = new Float32Array([0, 4]);
+      smoothing.update(frame);
+      frame.set([4, 4]);
+      smoothing.update(frame);
+      expect(Array.from(frame)).to.deep.equal([2, 4]);
+      smoothing.reset();
+      frame.set([8, 8]);
+      smoothing.update(frame);
+      expect(Array.from(frame)).to.deep.equal([8, 8]);
+      smoothing.delete();
+    });
+    it('should follow a trend with double smoothing', () => {
+      const single = new ft.ExponentialSmoothing(0.5);
+      const double = new ft.ExponentialSmoothing(0.5, 0.5);
+      const a = new Float32Array(1);
+      const b = new Float32Array(1);
+      for (let t = 0; t < 10; t++) {
+        a[0] = b[0] = t;
+        single.update(a);
+        double.update(b);
+      }
+      expect(9 - b[0]).to.be.below(9 - a[0]);
+      single.delete();
+      double.delete();
+    });
+    it('should recover a stream from NaN after a reset', () => {
+      [undefined, 0.5].forEach(beta => {
+        const smoothing = new ft.ExponentialSmoothing(0.5, beta);
+        const frame = new Float32Array([NaN]);
+        smoothing.update(frame);
+        smoothing.reset();
+        frame[0] = 7;
+        smoothing.update(frame);
+        frame[0] = 8;
+        smoothing.update(frame);
+        expect(frame[0]).to.eql(7.5);
+        smoothing.delete();
+      });
+    });
+  });
+}
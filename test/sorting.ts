@@ -0,0 +1,49 @@
+export default function() {
+  describe('sort', () => {
+    it('should sort rows by default', () => {
+      const mat = ft.tensor([[3, 1, 2], [0, 5, 4]]);
+      expect(mat.sort().array()).to.deep.equal([[1, 2, 3], [0, 4, 5]]);
+    });
+    it('should sort columns descending on axis 0', () => {
+      const mat = ft.tensor([[3, 1], [0, 5], [4, 2]]);
+      expect(mat.sort(0, true).array()).to.deep.equal([[4, 5], [3, 2], [0, 1]]);
+    });
+    it('should sort rows longer than the sorting network', () => {
+      const data = [9, 3, 7, 1, 8, 2, 6, 4, 5, 0, 11, 10];
+      expect(ft.tensor(data).sort().array()).to.deep.equal([...data].sort((a, b) => a - b));
+    });
+  });
+
+  describe('argsort', () => {
+    it('should return the sorting indices', () => {
+      expect(ft.tensor([3, 1, 2]).argsort().array()).to.deep.equal([1, 2, 0]);
+    });
+    it('should keep equal values in their original order', () => {
+      expect(ft.tensor([2, 1, 2, 1]).argsort().array()).to.deep.equal([1, 3, 0, 2]);
+      expect(ft.tensor([2, 1, 2, 1]).argsort(null, true).array()).to.deep.equal([0, 2, 1, 3]);
+    });
+  });
+
+  describe('topk', () => {
+    it('should return the largest values and their indices', () => {
+      const [values, indices] = ft.tensor([1, 9, 3, 7]).topk(2);
+      expect(values.array()).to.deep.equal([9, 7]);
+      expect(indices.array()).to.deep.equal([1, 3]);
+    });
+    it('should select the smallest values along axis 0', () => {
+      const mat = ft.tensor([[4, 1], [2, 8], [3, 0]]);
+      const [values, indices] = mat.topk(2, 0, false);
+      expect(values.shape).to.eql([2, 2]);
+      expect(values.array()).to.deep.equal([[2, 0], [3, 1]]);
+      expect(indices.array()).to.deep.equal([[1, 2], [2, 0]]);
+    });
+    it('should select from long rows', () => {
+      const data = Array.from({ length: 1000 }, (_, i) => (i * 7919) % 1000);
+      const [values] = ft.tensor([data]).topk(3);
+      expect(values.array()).to.deep.equal([[999, 998, 997]]);
+    });
+    it('should throw when k is larger than the axis', () => {
+      expect(() => ft.tensor([1, 2]).topk(3)).to.throw('larger than the axis');
+    });
+  });
+}
@@ -0,0 +1,46 @@
+export default function() {
+  const dense = () => ft.tensor([[0, 1, 0, 2], [0, 0, 0, 0], [3, 0, 4, 0]]);
+
+  it('should round trip through dense storing only the nonzeros', () => {
+    const sparse = new ft.SparseTensor(dense());
+    expect(sparse.shape).to.eql([3, 4]);
+    expect(sparse.nnz).to.eql(4);
+    expect(sparse.toDense().array()).to.deep.equal(dense().array());
+    sparse.delete();
+  });
+
+  it('should build from COO triplets and sum duplicates', () => {
+    const sparse = ft.SparseTensor.fromCOO([3, 4], [2, 0, 2, 0, 2], [1, 3, 0, 3, 1], [1, 2, 3, 4, 5]);
+    expect(sparse.nnz).to.eql(3);
+    expect(sparse.toDense().array()).to.deep.equal([[0, 0, 0, 6], [0, 0, 0, 0], [3, 6, 0, 0]]);
+    sparse.delete();
+  });
+
+  it('should reject out of range coordinates', () => {
+    expect(() => ft.SparseTensor.fromCOO([2, 2], [2], [0], [1])).to.throw('out of range');
+  });
+
+  it('should multiply by a vector and a dense matrix', () => {
+    const sparse = new ft.SparseTensor(dense());
+    expect(sparse.spmv(ft.tensor([1, 2, 3, 4])).array()).to.deep.equal([10, 0, 15]);
+    const other = ft.tensor([[1, 0], [0, 1], [1, 1], [2, 2]]);
+    expect(sparse.spmm(other).array()).to.deep.equal(dense().matMul(other).array());
+    expect(() => sparse.spmm(ft.tensor([[1, 2]]))).to.throw('must match');
+    sparse.delete();
+  });
+
+  it('should transpose and scale', () => {
+    const sparse = new ft.SparseTensor(dense());
+    const transposed = sparse.transpose();
+    expect(transposed.toDense().array()).to.deep.equal(dense().transpose().array());
+    expect(sparse.scale(2).toDense().array()).to.deep.equal(dense().mul(2).array());
+    expect(sparse.scaleRows(ft.tensor([1, 1, 10])).toDense().array()).to.deep.equal(
+      [[0, 1, 0, 2], [0, 0, 0, 0], [30, 0, 40, 0]]
+    );
+    expect(sparse.scaleCols(ft.tensor([1, 10, 1, 100])).toDense().array()).to.deep.equal(
+      [[0, 10, 0, 200], [0, 0, 0, 0], [3, 0, 4, 0]]
+    );
+    transposed.delete();
+    sparse.delete();
+  });
+}
@@ -0,0 +1,40 @@
+export default function() {
+  const points = () => ft.tensor([[0, 0], [1, 0], [5, 5], [6, 5], [10, 0]]);
+
+  it('should find the nearest neighbors of each query', () => {
+    const tree = new ft.KDTree(points(), 2);
+    expect(tree.size).to.eql(5);
+    const [indices, distances] = tree.knn(ft.tensor([[0.9, 0], [6, 6]]), 2);
+    expect(indices.array()).to.deep.equal([[1, 0], [3, 2]]);
+    expect(distances.array()[1][0]).to.be.closeTo(1, 1e-6);
+    tree.delete();
+  });
+
+  it('should pad knn results when k exceeds the points', () => {
+    const tree = new ft.KDTree(ft.tensor([[0, 0], [3, 4]]));
+    const [indices, distances] = tree.knn(ft.tensor([0, 0]), 3);
+    expect(indices.array()).to.deep.equal([[0, 1, -1]]);
+    expect(distances.array()).to.deep.equal([[0, 5, -1]]);
+    tree.delete();
+  });
+
+  it('should return the points within a radius, nearest first', () => {
+    const tree = new ft.KDTree(points(), 2);
+    const [indices] = tree.radius(ft.tensor([[5.4, 5], [20, 20]]), 1.5, 3);
+    expect(indices.array()).to.deep.equal([[2, 3, -1], [-1, -1, -1]]);
+    tree.delete();
+  });
+
+  it('should refit moved points without a rebuild', () => {
+    const tree = new ft.KDTree(points(), 2);
+    const moved = points().add(0.1);
+    expect(tree.refit(moved)).to.eql(false);
+    const [indices] = tree.knn(ft.tensor([[10, 0]]), 1);
+    expect(indices.array()).to.deep.equal([[4]]);
+    tree.delete();
+  });
+
+  it('should reject points that are not 2d or 3d', () => {
+    expect(() => new ft.KDTree(ft.tensor([[1, 2, 3, 4]]))).to.throw('Nx2 or Nx3');
+  });
+}
@@ -0,0 +1,94 @@
+export default function() {
+  describe('histogram', () => {
+    it('should count values into equal bins', () => {
+      const mat = ft.tensor([1, 2, 2, 3, 9]);
+      expect(mat.histogram(4, [0, 8]).array()).to.deep.equal([1, 3, 0, 0]);
+      expect(mat.histogram(2).array()).to.deep.equal([4, 1]);
+    });
+    it('should range over finite values only and reject an empty range', () => {
+      const mat = ft.tensor([-Infinity, 1, 2, 3, Infinity, NaN]);
+      expect(mat.histogram(2).array()).to.deep.equal([1, 2]);
+      expect(() => mat.histogram(2, [3, 3])).to.throw('low < high');
+      expect(() => mat.histogram(2, [3, 1])).to.throw('low < high');
+    });
+    it('should bin values spanning more than the float range', () => {
+      const mat = ft.tensor([-3e38, -1e38, 1e38, 3e38]);
+      expect(mat.histogram(4).array()).to.deep.equal([1, 1, 1, 1]);
+    });
+    it('should reject an axis outside -1..1', () => {
+      expect(() => ft.tensor([[1, 2], [3, 4]]).histogram(2, [0, 4], 2)).to.throw('Axis must be');
+    });
+    it('should replace the reduced axis with the bins', () => {
+      const mat = ft.tensor([ [ 1, 5 ], [ 3, 2 ], [ 9, 0 ] ]);
+      const columns = mat.histogram(2, [0, 9], 0);
+      expect(columns.shape).to.eql([2, 2]);
+      expect(columns.array()).to.deep.equal([ [ 2, 2 ], [ 1, 1 ] ]);
+      expect(mat.histogram(2, [0, 9], 1).array()).to.deep.equal([ [ 1, 1 ], [ 2, 0 ], [ 1, 1 ] ]);
+    });
+  });
+
+  describe('bincount', () => {
+    it('should count each integer value', () => {
+      const mat = ft.tensor([0, 1, 1, 3]);
+      expect(mat.bincount().array()).to.deep.equal([1, 2, 0, 1]);
+      expect(mat.bincount([1, 0.5, 0.5, 2], 6).array()).to.deep.equal([1, 1, 0, 2, 0, 0]);
+    });
+    it('should throw error for negative or fractional values', () => {
+      expect(() => ft.tensor([1, -1]).bincount()).to.throw('non-negative integer');
+      expect(() => ft.tensor([1.5]).bincount()).to.throw('non-negative integer');
+    });
+  });
+
+  describe('quantile', () => {
+    it('should interpolate between the closest values', () => {
+      const mat = ft.tensor([12, 15, 11, 40, 13]);
+      expect(mat.quantile(0.5).array()).to.eql(13);
+      expect(mat.median().array()).to.eql(13);
+      expect(mat.quantile([0, 0.875, 1]).array()).to.deep.equal([11, 27.5, 40]);
+    });
+    it('should compute quantiles along an axis', () => {
+      const mat = ft.tensor([ [ 1, 5 ], [ 3, 2 ], [ 9, 0 ] ]);
+      expect(mat.median(0).array()).to.deep.equal([3, 2]);
+      expect(mat.quantile([0, 1], 1).array()).to.deep.equal([ [ 1, 5 ], [ 2, 3 ], [ 0, 9 ] ]);
+    });
+    it('should skip NaN values', () => {
+      expect(ft.tensor([NaN, 4, 1, 2]).median().array()).to.eql(2);
+    });
+    it('should reject an axis outside -1..1', () => {
+      expect(() => ft.tensor([[1, 2], [3, 4]]).quantile(0.5, 2)).to.throw('Axis must be');
+    });
+  });
+
+  describe('QuantileSketch', () => {
+    it('should approximate quantiles of many frames in bounded memory', () => {
+      const sketch = new ft.QuantileSketch();
+      for (let frame = 0; frame < 100; frame++) {
+        const values = new Float32Array(1000);
+        for (let i = 0; i < values.length; i++) {
+          values[i] = frame * 1000 + i;
+        }
+        sketch.push(values);
+      }
+      expect(sketch.count).to.eql(100000);
+      expect(sketch.retained).to.be.below(1000);
+      const [p50, p90] = sketch.quantile([0.5, 0.9]);
+      expect(p50).to.be.closeTo(50000, 2000);
+      expect(p90).to.be.closeTo(90000, 2000);
+      expect(sketch.quantile(1)).to.eql(99999);
+      expect(sketch.rank(25000)).to.be.closeTo(0.25, 0.02);
+      sketch.delete();
+    });
+    it('should merge sketches', () => {
+      const low = new ft.QuantileSketch();
+      const high = new ft.QuantileSketch();
+      low.push(ft.arange(0, 500));
+      high.push(ft.arange(500, 1000));
+      low.merge(high);
+      expect(low.count).to.eql(1000);
+      expect(low.quantile(0)).to.eql(0);
+      expect(low.quantile(0.5)).to.be.closeTo(500, 20);
+      low.delete();
+      high.delete();
+    });
+  });
+}
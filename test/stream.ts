@@ -0,0 +1,38 @@
+export default function() {
+  it('should reduce chunks like the full tensor', () => {
+    const stream = new ft.TensorStream(2);
+    stream.push(new Float32Array([1, -2, 3, 4]));
+    stream.push(ft.tensor([[5, 6]]));
+    expect(stream.rowsSeen).to.eql(3);
+    expect(stream.sum().data()).to.deep.equal([17]);
+    expect(stream.mean(0).array()).to.deep.equal([[3, 8 / 3]].map(row => row.map(Math.fround)));
+    expect(stream.min(0).array()).to.deep.equal([[1, -2]]);
+    expect(stream.max().data()).to.deep.equal([6]);
+    expect(stream.norm('L1', 0).array()).to.deep.equal([[9, 12]]);
+    stream.delete();
+  });
+
+  it('should project chunks through a resident matrix', () => {
+    const resident = ft.tensor([[1, 0, 1], [0, 1, 1]]);
+    const stream = new ft.TensorStream(2, resident);
+    const projected = stream.push(new Float32Array([1, 2, 3, 4]));
+    expect(Array.from(projected!)).to.deep.equal([1, 2, 3, 3, 4, 7]);
+    expect(stream.sum(0).array()).to.deep.equal([[4, 6, 10]]);
+    stream.reset();
+    expect(stream.rowsSeen).to.eql(0);
+    stream.delete();
+  });
+
+  it('should reject unsupported axes', () => {
+    const stream = new ft.TensorStream(2);
+    expect(() => stream.sum(1)).to.throw('axis 0');
+    stream.delete();
+  });
+
+  it('should reject zero-width streams', () => {
+    expect(() => new ft.TensorStream(0)).to.throw('at least one column');
+  });
+  it('should reject a resident matrix that does not match the columns', () => {
+    expect(() => new ft.TensorStream(3, ft.tensor([[1, 0], [0, 1]]))).to.throw('resident matrix rows');
+  });
+}
@@ -0,0 +1,46 @@
+export default function() {
+  this.timeout(20000);
+  let pool;
+
+  before(() => {
+    pool = new ft.WorkerPool({ size: 2 });
+  });
+
+  after(() => {
+    pool.terminate();
+  });
+
+  it('should pipeline chained ops in a worker', async () => {
+    const a = pool.tensor([[1, 2], [3, 4]]);
+    const result = a.matMul(a).add(1).transpose();
+    expect(await result.array()).to.deep.equal([[8, 16], [11, 23]]);
+    expect(await result.shape()).to.eql([2, 2]);
+  });
+
+  it('should copy operands living on another worker', async () => {
+    const a = pool.tensor([1, 2, 3]);
+    const b = pool.tensor(new Float32Array([10, 20, 30]));
+    expect(a.worker).to.not.equal(b.worker);
+    expect(Array.from(await a.add(b).data())).to.deep.equal([11, 22, 33]);
+  });
+
+  it('should return multiple outputs and run any tensor op', async () => {
+    const local = ft.tensor([[2, 0], [0, 3]]);
+    const a = pool.from(local);
+    local.delete();
+    const [q, r] = a.qr();
+    const rebuilt = await q.matMul(r).array();
+    expect(rebuilt[0][0]).to.be.closeTo(2, 1e-5);
+    expect(rebuilt[1][1]).to.be.closeTo(3, 1e-5);
+    expect(await a.run('reshape', [4]).array()).to.deep.equal([2, 0, 0, 3]);
+  });
+
+  it('should reject failed ops and anything depending on them', async () => {
+    const a = pool.tensor([[1, 2], [3, 4]]);
+    const bad = a.matMul(pool.tensor([[1, 2, 3]]));
+    const dependent = bad.add(1);
+    const errors = await Promise.all([bad.ready(), dependent.data()].map(p => p.then(() => null, e => e)));
+    errors.forEach(error => expect(error).to.be.an('error'));
+    expect(errors[1].message).to.eql(errors[0].message);
+  });
+}